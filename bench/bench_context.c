@@ -0,0 +1,113 @@
+/*
+  Throughput of cJSON_ParseCtx with 1 to 8 threads, each parsing the same document with its own
+  context and arena. With per-call contexts the threads share no state, so throughput should grow
+  with the number of threads up to the number of CPUs.
+
+  usage: bench_context [iterations per thread]
+*/
+
+/* clock_gettime and CLOCK_MONOTONIC */
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "cJSON.h"
+
+#define MAX_THREADS 8
+
+static char *document = NULL;
+static size_t document_length = 0;
+static int iterations = 400;
+
+static void *parse_repeatedly(void *argument)
+{
+    cJSON_Context context;
+    cJSON_Arena *arena = NULL;
+    int i = 0;
+
+    (void)argument;
+    cJSON_InitContext(&context);
+    for (i = 0; i < iterations; i++)
+    {
+        /* everything is freed at once with the arena */
+        arena = cJSON_ArenaNew(0);
+        context.arena = arena;
+        if (cJSON_ParseCtx(document, document_length, &context) == NULL)
+        {
+            fprintf(stderr, "parsing failed\n");
+            exit(EXIT_FAILURE);
+        }
+        cJSON_ArenaFree(arena);
+    }
+
+    return NULL;
+}
+
+static double elapsed_seconds(const struct timespec *start, const struct timespec *end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    pthread_t threads[MAX_THREADS];
+    struct timespec start;
+    struct timespec end;
+    double single = 0;
+    size_t capacity = 1 << 20;
+    int count = 0;
+    int i = 0;
+
+    if (argc > 1)
+    {
+        iterations = atoi(argv[1]);
+    }
+
+    /* about 170 KB of small records */
+    document = (char*)malloc(capacity);
+    if (document == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+    document_length = (size_t)sprintf(document, "[");
+    for (i = 0; i < 3000; i++)
+    {
+        document_length += (size_t)sprintf(document + document_length, "%s{\"id\":%d,\"name\":\"item %d\",\"tags\":[\"a\",\"b\"],\"v\":%d.5}", (i > 0) ? "," : "", i, i, i);
+    }
+    document_length += (size_t)sprintf(document + document_length, "]");
+
+    printf("%ld CPUs, %lu byte document, %d parses per thread\n", sysconf(_SC_NPROCESSORS_ONLN), (unsigned long)document_length, iterations);
+    for (count = 1; count <= MAX_THREADS; count *= 2)
+    {
+        double seconds = 0;
+        double throughput = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (i = 0; i < count; i++)
+        {
+            pthread_create(&threads[i], NULL, parse_repeatedly, NULL);
+        }
+        for (i = 0; i < count; i++)
+        {
+            pthread_join(threads[i], NULL);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        seconds = elapsed_seconds(&start, &end);
+        throughput = (double)document_length * iterations * count / 1e6 / seconds;
+        if (count == 1)
+        {
+            single = throughput;
+        }
+        printf("%d threads: %.1f MB/s (%.2fx)\n", count, throughput, throughput / single);
+    }
+
+    free(document);
+
+    return EXIT_SUCCESS;
+}
@@ -28,6 +28,15 @@
 #define _CRT_SECURE_NO_DEPRECATE
 #endif
 
+/* cJSON_ParseFile maps files where POSIX is available, elsewhere they are read into memory */
+#if !defined(CJSON_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define CJSON_POSIX
+#if !defined(_POSIX_C_SOURCE) || (_POSIX_C_SOURCE < 200112L)
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+#endif
+
 #ifdef __GNUC__
 #pragma GCC visibility push(default)
 #endif
@@ -44,11 +53,32 @@
 #include <limits.h>
 #include <ctype.h>
 #include <float.h>
+#include <errno.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef CJSON_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #ifdef ENABLE_LOCALES
 #include <locale.h>
 #endif
 
+/* SSE2 string scanning, and AVX2 if the CPU has it at runtime */
+#if !defined(CJSON_NO_SIMD) && defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define CJSON_SSE2
+#if defined(__clang__) || (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9))
+#include <immintrin.h>
+#define CJSON_AVX2
+#endif
+#endif
+
 #if defined(_MSC_VER)
 #pragma warning (pop)
 #endif
@@ -85,6 +115,49 @@
 #endif
 #endif
 
+#if defined(_MSC_VER)
+typedef unsigned __int64 cjson_uint64;
+#else
+#if defined(__GNUC__)
+__extension__
+#endif
+typedef unsigned long long cjson_uint64;
+#endif
+#define CJSON_INT64_MAX ((cJSON_int64)(((cjson_uint64)~(cjson_uint64)0) >> 1))
+#define CJSON_INT64_MIN (-CJSON_INT64_MAX - 1)
+#define CJSON_INT64_LIMIT 9223372036854775808.0 /* 2^63 */
+
+/* Integral numbers have cJSON_IsInt64. valuedouble holds their exact value unless it had to round,
+ * beyond 2^53: then valuestring points to the exact cJSON_int64, which need not be aligned. */
+
+/* whether value has to be stored next to number, its double */
+static cJSON_bool integer_rounded(const cJSON_int64 value, const double number)
+{
+    return (number < -CJSON_INT64_LIMIT) || (number >= CJSON_INT64_LIMIT) || ((cJSON_int64)number != value);
+}
+
+/* the exact value of an integral number, false if item isn't one */
+static cJSON_bool exact_integer(const cJSON * const item, cJSON_int64 * const value)
+{
+    if (!(item->type & cJSON_IsInt64) || ((item->type & 0xFF) != cJSON_Number))
+    {
+        return false;
+    }
+    if (item->valuestring != NULL)
+    {
+        memcpy(value, item->valuestring, sizeof(cJSON_int64));
+        /* valuedouble may have been written directly, only trust the exact value if it still agrees */
+        return (double)*value == item->valuedouble;
+    }
+    if ((item->valuedouble < -CJSON_INT64_LIMIT) || (item->valuedouble >= CJSON_INT64_LIMIT) || (floor(item->valuedouble) != item->valuedouble))
+    {
+        return false;
+    }
+    *value = (cJSON_int64)item->valuedouble;
+
+    return true;
+}
+
 typedef struct {
     const unsigned char *json;
     size_t position;
@@ -116,6 +189,38 @@ CJSON_PUBLIC(double) cJSON_GetNumberValue(const cJSON * const item)
     return item->valuedouble;
 }
 
+CJSON_PUBLIC(cJSON_int64) cJSON_GetInt64Value(const cJSON * const item)
+{
+    cJSON_int64 number_int64 = 0;
+    double number = 0;
+
+    if (!cJSON_IsNumber(item))
+    {
+        return 0;
+    }
+
+    if (exact_integer(item, &number_int64))
+    {
+        return number_int64;
+    }
+
+    number = item->valuedouble;
+    if (isnan(number))
+    {
+        return 0;
+    }
+    if (number >= CJSON_INT64_LIMIT)
+    {
+        return CJSON_INT64_MAX;
+    }
+    if (number <= -CJSON_INT64_LIMIT)
+    {
+        return CJSON_INT64_MIN;
+    }
+
+    return (cJSON_int64)number;
+}
+
 /* This is a safeguard to prevent copy-pasters from using incompatible C and header files */
 #if (CJSON_VERSION_MAJOR != 1) || (CJSON_VERSION_MINOR != 7) || (CJSON_VERSION_PATCH != 18)
     #error cJSON.h and cJSON.c have different versions. Make sure that both have the same.
@@ -206,37 +311,42 @@ static unsigned char* cJSON_strdup(const unsigned char* string, const internal_h
     return copy;
 }
 
-CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
+static void set_hooks(internal_hooks * const target, const cJSON_Hooks * const hooks)
 {
     if (hooks == NULL)
     {
         /* Reset hooks */
-        global_hooks.allocate = malloc;
-        global_hooks.deallocate = free;
-        global_hooks.reallocate = realloc;
+        target->allocate = malloc;
+        target->deallocate = free;
+        target->reallocate = realloc;
         return;
     }
 
-    global_hooks.allocate = malloc;
+    target->allocate = malloc;
     if (hooks->malloc_fn != NULL)
     {
-        global_hooks.allocate = hooks->malloc_fn;
+        target->allocate = hooks->malloc_fn;
     }
 
-    global_hooks.deallocate = free;
+    target->deallocate = free;
     if (hooks->free_fn != NULL)
     {
-        global_hooks.deallocate = hooks->free_fn;
+        target->deallocate = hooks->free_fn;
     }
 
     /* use realloc only if both free and malloc are used */
-    global_hooks.reallocate = NULL;
-    if ((global_hooks.allocate == malloc) && (global_hooks.deallocate == free))
+    target->reallocate = NULL;
+    if ((target->allocate == malloc) && (target->deallocate == free))
     {
-        global_hooks.reallocate = realloc;
+        target->reallocate = realloc;
     }
 }
 
+CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
+{
+    set_hooks(&global_hooks, hooks);
+}
+
 /* Internal constructor. */
 static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
 {
@@ -249,1525 +359,5852 @@ static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
     return node;
 }
 
-/* Delete a cJSON structure. */
-CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
+/* Arena allocator: memory is handed out from large chunks and only released all at once. */
+#ifndef CJSON_ARENA_CHUNK_SIZE
+#define CJSON_ARENA_CHUNK_SIZE (64 * 1024)
+#endif
+
+/* every allocation is aligned to this type */
+typedef union
 {
-    cJSON *next = NULL;
-    while (item != NULL)
-    {
-        next = item->next;
-        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
-        {
-            cJSON_Delete(item->child);
-        }
-        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
-        {
-            global_hooks.deallocate(item->valuestring);
-            item->valuestring = NULL;
-        }
-        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
-        {
-            global_hooks.deallocate(item->string);
-            item->string = NULL;
-        }
-        global_hooks.deallocate(item);
-        item = next;
-    }
-}
+    double number;
+    void *pointer;
+    size_t size;
+} arena_alignment;
 
-/* get the decimal point character of the current locale */
-static unsigned char get_decimal_point(void)
+#define arena_align(size) (((size) + sizeof(arena_alignment) - 1) & ~(sizeof(arena_alignment) - 1))
+
+typedef struct arena_chunk
 {
-#ifdef ENABLE_LOCALES
-    struct lconv *lconv = localeconv();
-    return (unsigned char) lconv->decimal_point[0];
-#else
-    return '.';
-#endif
-}
+    struct arena_chunk *next;
+    size_t size; /* usable bytes after the header */
+    size_t used;
+} arena_chunk;
 
-typedef struct
+#define arena_chunk_data(chunk) ((unsigned char*)(chunk) + arena_align(sizeof(arena_chunk)))
+
+/* memory allocated elsewhere that the arena releases with its chunks */
+typedef struct arena_adopted
 {
-    const unsigned char *content;
-    size_t length;
-    size_t offset;
-    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
-    internal_hooks hooks;
-} parse_buffer;
+    struct arena_adopted *next;
+    void *memory;
+    size_t mapped; /* length of a file mapping that is unmapped instead, 0 for allocated memory */
+} arena_adopted;
 
-/* check if the given size is left to read in a given parse buffer (starting with 1) */
-#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
-/* check if the buffer can be accessed at the given index (starting with 0) */
-#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
-#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
-/* get a pointer to the buffer at the position */
-#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+struct cJSON_Arena
+{
+    arena_chunk *chunks; /* the chunk that is currently filled comes first */
+    size_t chunk_size;
+    internal_hooks hooks;
+    arena_adopted *adopted;
+};
 
-/* Parse the input text to generate a number, and populate the result into item. */
-static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+/* arena items remember their arena, so mutations can allocate from it too */
+typedef struct
 {
-    double number = 0;
-    unsigned char *after_end = NULL;
-    unsigned char number_c_string[64];
-    unsigned char decimal_point = get_decimal_point();
-    size_t i = 0;
+    cJSON_Arena *arena;
+    cJSON item;
+} arena_item;
 
-    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+#define arena_of_item(node) (((arena_item*)(void*)((unsigned char*)(node) - offsetof(arena_item, item)))->arena)
+
+CJSON_PUBLIC(cJSON_Arena *) cJSON_ArenaNew(size_t chunk_size)
+{
+    cJSON_Arena *arena = (cJSON_Arena*)global_hooks.allocate(sizeof(cJSON_Arena));
+    if (arena == NULL)
     {
-        return false;
+        return NULL;
     }
 
-    /* copy the number into a temporary buffer and replace '.' with the decimal point
-     * of the current locale (for strtod)
-     * This also takes care of '\0' not necessarily being available for marking the end of the input */
-    for (i = 0; (i < (sizeof(number_c_string) - 1)) && can_access_at_index(input_buffer, i); i++)
-    {
-        switch (buffer_at_offset(input_buffer)[i])
-        {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '+':
-            case '-':
-            case 'e':
-            case 'E':
-                number_c_string[i] = buffer_at_offset(input_buffer)[i];
-                break;
+    arena->chunks = NULL;
+    arena->adopted = NULL;
+    arena->chunk_size = (chunk_size == 0) ? CJSON_ARENA_CHUNK_SIZE : chunk_size;
+    arena->hooks = global_hooks;
 
-            case '.':
-                number_c_string[i] = decimal_point;
-                break;
+    return arena;
+}
 
-            default:
-                goto loop_end;
-        }
-    }
-loop_end:
-    number_c_string[i] = '\0';
+CJSON_PUBLIC(void) cJSON_ArenaFree(cJSON_Arena *arena)
+{
+    arena_chunk *chunk = NULL;
+    arena_chunk *next = NULL;
+    arena_adopted *adopted = NULL;
 
-    number = strtod((const char*)number_c_string, (char**)&after_end);
-    if (number_c_string == after_end)
+    if (arena == NULL)
     {
-        return false; /* parse_error */
+        return;
     }
 
-    item->valuedouble = number;
-
-    /* use saturation in case of overflow */
-    if (number >= INT_MAX)
+    /* the list of adopted memory is itself in the chunks */
+    for (adopted = arena->adopted; adopted != NULL; adopted = adopted->next)
     {
-        item->valueint = INT_MAX;
+#ifdef CJSON_POSIX
+        if (adopted->mapped != 0)
+        {
+            munmap(adopted->memory, adopted->mapped);
+            continue;
+        }
+#endif
+        arena->hooks.deallocate(adopted->memory);
     }
-    else if (number <= (double)INT_MIN)
+    for (chunk = arena->chunks; chunk != NULL; chunk = next)
     {
-        item->valueint = INT_MIN;
+        next = chunk->next;
+        arena->hooks.deallocate(chunk);
     }
-    else
+    arena->hooks.deallocate(arena);
+}
+
+static void *arena_allocate(cJSON_Arena * const arena, size_t size)
+{
+    arena_chunk *chunk = arena->chunks;
+    void *memory = NULL;
+
+    size = arena_align(size);
+    if ((chunk == NULL) || ((chunk->size - chunk->used) < size))
     {
-        item->valueint = (int)number;
+        size_t chunk_size = (size > arena->chunk_size) ? size : arena->chunk_size;
+        chunk = (arena_chunk*)arena->hooks.allocate(arena_align(sizeof(arena_chunk)) + chunk_size);
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+        chunk->size = chunk_size;
+        chunk->used = 0;
+
+        if ((arena->chunks != NULL) && (size > (arena->chunk_size / 4)))
+        {
+            /* big allocations get a chunk of their own, keep filling the current one */
+            chunk->next = arena->chunks->next;
+            arena->chunks->next = chunk;
+        }
+        else
+        {
+            chunk->next = arena->chunks;
+            arena->chunks = chunk;
+        }
     }
 
-    item->type = cJSON_Number;
+    memory = arena_chunk_data(chunk) + chunk->used;
+    chunk->used += size;
 
-    input_buffer->offset += (size_t)(after_end - number_c_string);
-    return true;
+    return memory;
 }
 
-/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
-CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
+/* make memory from the allocator part of the arena */
+static cJSON_bool arena_adopt(cJSON_Arena * const arena, void * const memory)
 {
-    if (number >= INT_MAX)
+    arena_adopted *adopted = (arena_adopted*)arena_allocate(arena, sizeof(arena_adopted));
+    if (adopted == NULL)
     {
-        object->valueint = INT_MAX;
+        return false;
     }
-    else if (number <= (double)INT_MIN)
+
+    adopted->memory = memory;
+    adopted->mapped = 0;
+    adopted->next = arena->adopted;
+    arena->adopted = adopted;
+
+    return true;
+}
+
+static cJSON *arena_new_item(cJSON_Arena * const arena)
+{
+    arena_item *node = (arena_item*)arena_allocate(arena, sizeof(arena_item));
+    if (node == NULL)
     {
-        object->valueint = INT_MIN;
+        return NULL;
     }
-    else
+
+    memset(node, '\0', sizeof(arena_item));
+    node->arena = arena;
+    node->item.type = cJSON_IsArenaItem;
+
+    return &node->item;
+}
+
+/* Lookup indexes of large objects and arrays, built by the first lookup that has to walk
+ * CJSON_INDEX_THRESHOLD children, or by cJSON_BuildIndex.
+ * Objects get a hash table: open addressing with linear probing over the children.
+ * The hash folds case, so the same index serves case sensitive and insensitive lookups.
+ * Arrays get a vector of their children, for random access and the size.
+ * The index hangs off the valuestring of its array or object, which has cJSON_IsIndexed then.
+ * Shared and packed arrays and objects have their valuestring in use and are never indexed. */
+typedef struct
+{
+    unsigned long hash;
+    cJSON *item; /* NULL marks an empty slot, index_tombstone a removed item */
+} index_slot;
+
+struct cJSON_Index
+{
+    /* first and last child when the index was last updated, to detect lists relinked by hand */
+    cJSON *first;
+    cJSON *last;
+    size_t count; /* indexed children, which is all of them */
+    /* objects */
+    size_t used; /* indexed children + tombstones */
+    size_t mask; /* number of slots - 1 */
+    index_slot *slots;
+    /* arrays */
+    size_t capacity;
+    cJSON **items; /* the children in list order */
+};
+
+static cJSON index_tombstone_item;
+#define index_tombstone (&index_tombstone_item)
+
+static unsigned long index_hash(const unsigned char *string)
+{
+    /* FNV-1a */
+    unsigned long hash = 2166136261UL;
+    for (; *string != '\0'; string++)
     {
-        object->valueint = (int)number;
+        hash ^= (unsigned long)tolower(*string);
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
     }
 
-    return object->valuedouble = number;
+    return hash;
 }
 
-/* Note: when passing a NULL valuestring, cJSON_SetValuestring treats this as an error and return NULL */
-CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+/* the index of item, NULL if it has none */
+static struct cJSON_Index *index_of(const cJSON * const item)
 {
-    char *copy = NULL;
-    size_t v1_len;
-    size_t v2_len;
-    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
-    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    if (!(item->type & cJSON_IsIndexed))
     {
         return NULL;
     }
-    /* return NULL if the object is corrupted or valuestring is NULL */
-    if (object->valuestring == NULL || valuestring == NULL)
+
+    return (struct cJSON_Index*)(void*)item->valuestring;
+}
+
+/* drop the index of an object */
+static void index_free(cJSON * const object)
+{
+    struct cJSON_Index * const index = index_of(object);
+
+    if (index == NULL)
     {
-        return NULL;
+        return;
     }
+    object->type &= ~cJSON_IsIndexed;
+    object->valuestring = NULL;
 
-    v1_len = strlen(valuestring);
-    v2_len = strlen(object->valuestring);
-
-    if (v1_len <= v2_len)
+    /* the index of an arena item is arena memory */
+    if (!(object->type & cJSON_IsArenaItem))
     {
-        /* strcpy does not handle overlapping string: [X1, X2] [Y1, Y2] => X2 < Y1 or Y2 < X1 */
-        if (!( valuestring + v1_len < object->valuestring || object->valuestring + v2_len < valuestring ))
+        if (index->items != NULL)
         {
-            return NULL;
+            global_hooks.deallocate(index->items);
         }
-        strcpy(object->valuestring, valuestring);
-        return object->valuestring;
+        global_hooks.deallocate(index);
     }
-    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
-    if (copy == NULL)
+}
+
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *object)
+{
+    if (object != NULL)
     {
-        return NULL;
+        index_free(object);
     }
-    if (object->valuestring != NULL)
+}
+
+static void *index_allocate(const cJSON * const object, size_t size)
+{
+    if (object->type & cJSON_IsArenaItem)
     {
-        cJSON_free(object->valuestring);
+        return arena_allocate(arena_of_item(object), size);
     }
-    object->valuestring = copy;
 
-    return copy;
+    return global_hooks.allocate(size);
 }
 
-typedef struct
+static void index_attach(cJSON * const object, struct cJSON_Index * const index)
 {
-    unsigned char *buffer;
-    size_t length;
-    size_t offset;
-    size_t depth; /* current nesting depth (for formatted printing) */
-    cJSON_bool noalloc;
-    cJSON_bool format; /* is this print a formatted print */
-    internal_hooks hooks;
-} printbuffer;
+    object->valuestring = (char*)(void*)index;
+    object->type |= cJSON_IsIndexed;
+}
 
-/* realloc printbuffer if necessary to have at least "needed" bytes more */
-static unsigned char* ensure(printbuffer * const p, size_t needed)
+static void index_put(struct cJSON_Index * const index, cJSON * const item, const unsigned long hash)
 {
-    unsigned char *newbuffer = NULL;
-    size_t newsize = 0;
-
-    if ((p == NULL) || (p->buffer == NULL))
+    size_t position = (size_t)hash & index->mask;
+    while ((index->slots[position].item != NULL) && (index->slots[position].item != index_tombstone))
     {
-        return NULL;
+        position = (position + 1) & index->mask;
     }
-
-    if ((p->length > 0) && (p->offset >= p->length))
+    if (index->slots[position].item == NULL)
     {
-        /* make sure that offset is valid */
-        return NULL;
+        index->used++;
     }
+    index->slots[position].hash = hash;
+    index->slots[position].item = item;
+    index->count++;
+}
 
-    if (needed > INT_MAX)
-    {
-        /* sizes bigger than INT_MAX are currently not supported */
-        return NULL;
-    }
+/* (re)build the index from the child list, returns false if the object can't be indexed */
+static cJSON_bool index_build(cJSON * const object)
+{
+    struct cJSON_Index *index = NULL;
+    cJSON *child = NULL;
+    size_t count = 0;
+    size_t slots = 16;
+    size_t size = 0;
 
-    needed += p->offset + 1;
-    if (needed <= p->length)
+    index_free(object);
+    if ((object->type & cJSON_IsReference) || (object->child == NULL) || (object->valuestring != NULL))
     {
-        return p->buffer + p->offset;
-    }
-
-    if (p->noalloc) {
-        return NULL;
+        /* references share their children with the original, which wouldn't maintain our index,
+         * and the valuestring of shared objects is in use */
+        return false;
     }
 
-    /* calculate new buffer size */
-    if (needed > (INT_MAX / 2))
+    for (child = object->child; child != NULL; child = child->next)
     {
-        /* overflow of int, use INT_MAX if possible */
-        if (needed <= INT_MAX)
-        {
-            newsize = INT_MAX;
-        }
-        else
+        if (child->string == NULL)
         {
-            return NULL;
+            /* the lookups stop at children without a name, only the linear scan gets that right */
+            return false;
         }
-    }
-    else
-    {
-        newsize = needed * 2;
+        count++;
     }
 
-    if (p->hooks.reallocate != NULL)
+    /* keep the load factor below 1/2, leaving room to grow */
+    while (slots < (count * 4))
     {
-        /* reallocate with realloc if available */
-        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
-        if (newbuffer == NULL)
+        slots *= 2;
+        if (slots == 0)
         {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
-
-            return NULL;
+            return false;
         }
     }
-    else
-    {
-        /* otherwise reallocate manually */
-        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
-        if (!newbuffer)
-        {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
-
-            return NULL;
-        }
 
-        memcpy(newbuffer, p->buffer, p->offset + 1);
-        p->hooks.deallocate(p->buffer);
+    size = arena_align(sizeof(struct cJSON_Index)) + (slots * sizeof(index_slot));
+    index = (struct cJSON_Index*)index_allocate(object, size);
+    if (index == NULL)
+    {
+        return false;
     }
-    p->length = newsize;
-    p->buffer = newbuffer;
 
-    return newbuffer + p->offset;
-}
+    memset(index, '\0', sizeof(struct cJSON_Index));
+    index->slots = (index_slot*)(void*)((unsigned char*)index + arena_align(sizeof(struct cJSON_Index)));
+    memset(index->slots, '\0', slots * sizeof(index_slot));
+    index->mask = slots - 1;
+    index->first = object->child;
+    index->last = object->child->prev;
 
-/* calculate the new length of the string in a printbuffer and update the offset */
-static void update_offset(printbuffer * const buffer)
-{
-    const unsigned char *buffer_pointer = NULL;
-    if ((buffer == NULL) || (buffer->buffer == NULL))
+    for (child = object->child; child != NULL; child = child->next)
     {
-        return;
+        index_put(index, child, index_hash((const unsigned char*)child->string));
     }
-    buffer_pointer = buffer->buffer + buffer->offset;
 
-    buffer->offset += strlen((const char*)buffer_pointer);
-}
+    index_attach(object, index);
 
-/* securely comparison of floating-point variables */
-static cJSON_bool compare_double(double a, double b)
-{
-    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
-    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+    return true;
 }
 
-/* Render the number nicely from the given item into a string. */
-static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+/* build the child vector of an array, returns false if that isn't possible */
+static cJSON_bool index_build_array(cJSON * const array)
 {
-    unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
-    int length = 0;
-    size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
-    unsigned char decimal_point = get_decimal_point();
-    double test = 0.0;
+    struct cJSON_Index *index = NULL;
+    cJSON *child = NULL;
+    size_t count = 0;
 
-    if (output_buffer == NULL)
+    index_free(array);
+    if ((array->type & cJSON_IsReference) || (array->child == NULL) || (array->valuestring != NULL))
     {
         return false;
     }
 
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
+    for (child = array->child; child != NULL; child = child->next)
     {
-        length = sprintf((char*)number_buffer, "null");
+        count++;
     }
-    else if(d == (double)item->valueint)
+
+    index = (struct cJSON_Index*)index_allocate(array, sizeof(struct cJSON_Index));
+    if (index == NULL)
     {
-        length = sprintf((char*)number_buffer, "%d", item->valueint);
+        return false;
     }
-    else
+    memset(index, '\0', sizeof(struct cJSON_Index));
+    index->capacity = count + (count / 2);
+    index->items = (cJSON**)index_allocate(array, index->capacity * sizeof(cJSON*));
+    if (index->items == NULL)
     {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
-
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
+        if (!(array->type & cJSON_IsArenaItem))
         {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
+            global_hooks.deallocate(index);
         }
+        return false;
     }
 
-    /* sprintf failed or buffer overrun occurred */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    for (child = array->child; child != NULL; child = child->next)
     {
-        return false;
+        index->items[index->count++] = child;
     }
+    index->first = array->child;
+    index->last = array->child->prev;
+
+    index_attach(array, index);
+
+    return true;
+}
 
-    /* reserve appropriate space in the output */
-    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
-    if (output_pointer == NULL)
+CJSON_PUBLIC(cJSON_bool) cJSON_BuildIndex(cJSON *item)
+{
+    if ((item == NULL) || (item->type & cJSON_IsReference))
     {
         return false;
     }
-
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
+    if (cJSON_IsObject(item) && cJSON_Unshare(item))
     {
-        if (number_buffer[i] == decimal_point)
-        {
-            output_pointer[i] = '.';
-            continue;
-        }
-
-        output_pointer[i] = number_buffer[i];
+        return index_build(item);
+    }
+    if (cJSON_IsArray(item) && cJSON_Unshare(item))
+    {
+        /* a packed array is expanded first */
+        return index_build_array(item);
     }
-    output_pointer[i] = '\0';
-
-    output_buffer->offset += (size_t)length;
 
-    return true;
+    return false;
 }
 
-/* parse 4 digit hexadecimal number */
-static unsigned parse_hex4(const unsigned char * const input)
+/* make room for one more child in the vector */
+static cJSON_bool index_reserve(cJSON * const array, struct cJSON_Index * const index)
 {
-    unsigned int h = 0;
-    size_t i = 0;
+    cJSON **items = NULL;
+    size_t capacity = 0;
 
-    for (i = 0; i < 4; i++)
+    if (index->count < index->capacity)
     {
-        /* parse digit */
-        if ((input[i] >= '0') && (input[i] <= '9'))
-        {
-            h += (unsigned int) input[i] - '0';
-        }
-        else if ((input[i] >= 'A') && (input[i] <= 'F'))
-        {
-            h += (unsigned int) 10 + input[i] - 'A';
-        }
-        else if ((input[i] >= 'a') && (input[i] <= 'f'))
-        {
-            h += (unsigned int) 10 + input[i] - 'a';
-        }
-        else /* invalid */
+        return true;
+    }
+
+    capacity = index->capacity * 2;
+    if (capacity <= index->capacity)
+    {
+        return false;
+    }
+    if (array->type & cJSON_IsArenaItem)
+    {
+        /* arena memory can't be reallocated, the old vector stays in the arena */
+        items = (cJSON**)arena_allocate(arena_of_item(array), capacity * sizeof(cJSON*));
+        if (items != NULL)
         {
-            return 0;
+            memcpy(items, index->items, index->count * sizeof(cJSON*));
         }
+    }
+    else
+    {
+        items = (cJSON**)global_hooks.reallocate(index->items, capacity * sizeof(cJSON*));
+    }
+    if (items == NULL)
+    {
+        return false;
+    }
+    index->items = items;
+    index->capacity = capacity;
 
-        if (i < 3)
+    return true;
+}
+
+/* position of a child in the vector, searching from the end where most changes happen */
+static cJSON_bool index_find_position(const struct cJSON_Index * const index, const cJSON * const item, size_t * const position)
+{
+    size_t i = index->count;
+    while (i > 0)
+    {
+        i--;
+        if (index->items[i] == item)
         {
-            /* shift left to make place for the next nibble */
-            h = h << 4;
+            *position = i;
+            return true;
         }
     }
 
-    return h;
+    return false;
 }
 
-/* converts a UTF-16 literal to UTF-8
- * A literal can be one or two sequences of the form \uXXXX */
-static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+/* whether the index still describes the child list at both ends */
+static cJSON_bool index_current(const cJSON * const object, const struct cJSON_Index * const index)
 {
-    long unsigned int codepoint = 0;
-    unsigned int first_code = 0;
-    const unsigned char *first_sequence = input_pointer;
-    unsigned char utf8_length = 0;
-    unsigned char utf8_position = 0;
-    unsigned char sequence_length = 0;
-    unsigned char first_byte_mark = 0;
+    return (object->child != NULL) && (index->first == object->child) && (index->last == object->child->prev);
+}
 
-    if ((input_end - first_sequence) < 6)
+/* whether child is still linked into the child list of object */
+static cJSON_bool index_linked(const cJSON * const object, const cJSON * const child)
+{
+    if ((child == object->child) ? (child->prev == NULL) : ((child->prev == NULL) || (child->prev->next != child)))
     {
-        /* input ends unexpectedly */
-        goto fail;
+        return false;
     }
 
-    /* get the first utf16 sequence */
-    first_code = parse_hex4(first_sequence + 2);
+    return (child->next == NULL) ? (object->child->prev == child) : (child->next->prev == child);
+}
 
-    /* check that the code is valid */
-    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+/* drop the index if the child list was changed behind its back, call before changing the list */
+static void index_check(cJSON * const object)
+{
+    const struct cJSON_Index * const index = index_of(object);
+
+    if ((index != NULL) && !index_current(object, index))
     {
-        goto fail;
+        index_free(object);
     }
+}
 
-    /* UTF16 surrogate pair */
-    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+static void index_track_ends(cJSON * const object, struct cJSON_Index * const index)
+{
+    if (object->child == NULL)
     {
-        const unsigned char *second_sequence = first_sequence + 6;
-        unsigned int second_code = 0;
-        sequence_length = 12; /* \uXXXX\uXXXX */
+        index_free(object);
+        return;
+    }
+    index->first = object->child;
+    index->last = object->child->prev;
+}
 
-        if ((input_end - second_sequence) < 6)
+/* call after item has been linked into object */
+static void index_insert(cJSON * const object, cJSON * const item)
+{
+    struct cJSON_Index * const index = index_of(object);
+    size_t position = 0;
+
+    if (index == NULL)
+    {
+        return;
+    }
+    if (index->items != NULL)
+    {
+        if (item->next == NULL)
         {
-            /* input ends unexpectedly */
-            goto fail;
+            /* appended */
+            position = index->count;
         }
-
-        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
+        else if (!index_find_position(index, item->next, &position))
         {
-            /* missing second half of the surrogate pair */
-            goto fail;
+            index_free(object);
+            return;
         }
-
-        /* get the second utf16 sequence */
-        second_code = parse_hex4(second_sequence + 2);
-        /* check that the code is valid */
-        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+        if (!index_reserve(object, index))
         {
-            /* invalid second half of the surrogate pair */
-            goto fail;
+            index_free(object);
+            return;
         }
-
-
-        /* calculate the unicode codepoint from the surrogate pair */
-        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+        memmove(index->items + position + 1, index->items + position, (index->count - position) * sizeof(cJSON*));
+        index->items[position] = item;
+        index->count++;
+        index_track_ends(object, index);
+        return;
     }
-    else
+    if (item->string == NULL)
     {
-        sequence_length = 6; /* \uXXXX */
-        codepoint = first_code;
+        index_free(object);
+        return;
     }
-
-    /* encode as UTF-8
-     * takes at maximum 4 bytes to encode:
-     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
-    if (codepoint < 0x80)
+    if (((index->used + 1) * 2) > (index->mask + 1))
     {
-        /* normal ascii, encoding 0xxxxxxx */
-        utf8_length = 1;
+        /* also gets rid of the tombstones */
+        index_build(object);
+        return;
     }
-    else if (codepoint < 0x800)
+
+    index_put(index, item, index_hash((const unsigned char*)item->string));
+    index_track_ends(object, index);
+}
+
+/* call after item has been unlinked from object */
+static void index_remove(cJSON * const object, const cJSON * const item)
+{
+    struct cJSON_Index * const index = index_of(object);
+    size_t position = 0;
+
+    if (index == NULL)
     {
-        /* two bytes, encoding 110xxxxx 10xxxxxx */
-        utf8_length = 2;
-        first_byte_mark = 0xC0; /* 11000000 */
+        return;
     }
-    else if (codepoint < 0x10000)
+    if (index->items != NULL)
     {
-        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 3;
-        first_byte_mark = 0xE0; /* 11100000 */
+        if (index_find_position(index, item, &position))
+        {
+            index->count--;
+            memmove(index->items + position, index->items + position + 1, (index->count - position) * sizeof(cJSON*));
+            index_track_ends(object, index);
+            return;
+        }
     }
-    else if (codepoint <= 0x10FFFF)
+    else if (item->string != NULL)
     {
-        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 4;
-        first_byte_mark = 0xF0; /* 11110000 */
+        position = (size_t)index_hash((const unsigned char*)item->string) & index->mask;
+        while (index->slots[position].item != NULL)
+        {
+            if (index->slots[position].item == item)
+            {
+                index->slots[position].item = index_tombstone;
+                index->count--;
+                index_track_ends(object, index);
+                return;
+            }
+            position = (position + 1) & index->mask;
+        }
     }
-    else
-    {
-        /* invalid unicode codepoint */
-        goto fail;
-    }
-
-    /* encode as utf8 */
-    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
-    {
-        /* 10xxxxxx */
-        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
-        codepoint >>= 6;
-    }
-    /* encode first byte */
-    if (utf8_length > 1)
-    {
-        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
-    }
-    else
-    {
-        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
-    }
-
-    *output_pointer += utf8_length;
 
-    return sequence_length;
-
-fail:
-    return 0;
+    /* not indexed, so the index is out of date */
+    index_free(object);
 }
 
-/* Parse the input text into an unescaped cinput, and populate item. */
-static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+/* Look a name up in the index. Returns false if the index can't answer, e.g. because the name occurs more than once,
+ * in which case the order of the children decides and the caller has to walk the list, or because the index
+ * turns out to be out of date. */
+static cJSON_bool index_lookup(const cJSON * const object, const struct cJSON_Index * const index, const char * const name, const cJSON_bool case_sensitive, cJSON **found)
 {
-    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
-    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
-    unsigned char *output_pointer = NULL;
-    unsigned char *output = NULL;
+    unsigned long hash = index_hash((const unsigned char*)name);
+    size_t position = (size_t)hash & index->mask;
+    cJSON *candidate = NULL;
 
-    /* not a string */
-    if (buffer_at_offset(input_buffer)[0] != '\"')
+    *found = NULL;
+    if ((index->slots == NULL) || !index_current(object, index))
     {
-        goto fail;
+        return false;
     }
-
+    while ((candidate = index->slots[position].item) != NULL)
     {
-        /* calculate approximate size of the output (overestimate) */
-        size_t allocation_length = 0;
-        size_t skipped_bytes = 0;
-        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
+        if ((candidate != index_tombstone) && (index->slots[position].hash == hash))
         {
-            /* is escape sequence */
-            if (input_end[0] == '\\')
+            if (candidate->string == NULL)
+            {
+                /* renamed behind the index's back */
+                return false;
+            }
+            if (case_sensitive ? (strcmp(name, candidate->string) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)candidate->string) == 0))
             {
-                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
+                if (*found != NULL)
                 {
-                    /* prevent buffer overflow when last input character is a backslash */
-                    goto fail;
+                    return false;
                 }
-                skipped_bytes++;
-                input_end++;
+                *found = candidate;
             }
-            input_end++;
-        }
-        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
-        {
-            goto fail; /* string ended unexpectedly */
-        }
-
-        /* This is at most how much we need for the output */
-        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
-        if (output == NULL)
-        {
-            goto fail; /* allocation failure */
         }
+        position = (position + 1) & index->mask;
     }
 
-    output_pointer = output;
-    /* loop through the string literal */
-    while (input_pointer < input_end)
-    {
-        if (*input_pointer != '\\')
-        {
-            *output_pointer++ = *input_pointer++;
-        }
-        /* escape sequence */
-        else
-        {
-            unsigned char sequence_length = 2;
-            if ((input_end - input_pointer) < 1)
-            {
-                goto fail;
-            }
+    /* a child that was unlinked by hand */
+    return (*found == NULL) || index_linked(object, *found);
+}
 
-            switch (input_pointer[1])
-            {
-                case 'b':
-                    *output_pointer++ = '\b';
-                    break;
-                case 'f':
-                    *output_pointer++ = '\f';
-                    break;
-                case 'n':
-                    *output_pointer++ = '\n';
-                    break;
-                case 'r':
-                    *output_pointer++ = '\r';
-                    break;
-                case 't':
-                    *output_pointer++ = '\t';
-                    break;
-                case '\"':
-                case '\\':
-                case '/':
-                    *output_pointer++ = input_pointer[1];
-                    break;
+/* Key interning: equal object keys of parsed documents share a single reference counted copy from a
+ * cJSON_KeyPool. Items with such a key have cJSON_StringIsInterned (and cJSON_StringIsConst, so code that
+ * doesn't know about interning leaves the key alone). Keys outlive the pool as long as items use them. */
+typedef struct interned_key
+{
+    struct interned_key *next; /* in the same bucket */
+    cJSON_KeyPool *pool; /* NULL once the pool was freed */
+    size_t references;
+    unsigned long hash;
+    char string[1];
+} interned_key;
+
+struct cJSON_KeyPool
+{
+    interned_key **buckets;
+    size_t count;
+    size_t mask; /* number of buckets - 1 */
+};
 
-                /* UTF-16 literal */
-                case 'u':
-                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
-                    if (sequence_length == 0)
-                    {
-                        /* failed to convert UTF16-literal to UTF-8 */
-                        goto fail;
-                    }
-                    break;
+#define interned_key_of(key) ((interned_key*)(void*)((key) - offsetof(interned_key, string)))
 
-                default:
-                    goto fail;
-            }
-            input_pointer += sequence_length;
-        }
+CJSON_PUBLIC(cJSON_KeyPool *) cJSON_KeyPoolNew(void)
+{
+    cJSON_KeyPool *pool = (cJSON_KeyPool*)global_hooks.allocate(sizeof(cJSON_KeyPool));
+    if (pool == NULL)
+    {
+        return NULL;
     }
 
-    /* zero terminate the output */
-    *output_pointer = '\0';
-
-    item->type = cJSON_String;
-    item->valuestring = (char*)output;
+    pool->count = 0;
+    pool->mask = 63;
+    pool->buckets = (interned_key**)global_hooks.allocate((pool->mask + 1) * sizeof(interned_key*));
+    if (pool->buckets == NULL)
+    {
+        global_hooks.deallocate(pool);
+        return NULL;
+    }
+    memset(pool->buckets, '\0', (pool->mask + 1) * sizeof(interned_key*));
 
-    input_buffer->offset = (size_t) (input_end - input_buffer->content);
-    input_buffer->offset++;
+    return pool;
+}
 
-    return true;
+CJSON_PUBLIC(void) cJSON_KeyPoolFree(cJSON_KeyPool *pool)
+{
+    size_t i = 0;
 
-fail:
-    if (output != NULL)
+    if (pool == NULL)
     {
-        input_buffer->hooks.deallocate(output);
-        output = NULL;
+        return;
     }
 
-    if (input_pointer != NULL)
+    /* keys that are still used become standalone, they are freed with their last item */
+    for (i = 0; i <= pool->mask; i++)
     {
-        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+        interned_key *key = pool->buckets[i];
+        while (key != NULL)
+        {
+            interned_key *next = key->next;
+            key->pool = NULL;
+            key->next = NULL;
+            key = next;
+        }
     }
-
-    return false;
+    global_hooks.deallocate(pool->buckets);
+    global_hooks.deallocate(pool);
 }
 
-/* Render the cstring provided to an escaped version that can be printed. */
-static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+static void key_pool_grow(cJSON_KeyPool * const pool)
 {
-    const unsigned char *input_pointer = NULL;
-    unsigned char *output = NULL;
-    unsigned char *output_pointer = NULL;
-    size_t output_length = 0;
-    /* numbers of additional characters needed for escaping */
-    size_t escape_characters = 0;
+    size_t new_mask = (pool->mask * 2) + 1;
+    interned_key **new_buckets = (interned_key**)global_hooks.allocate((new_mask + 1) * sizeof(interned_key*));
+    size_t i = 0;
 
-    if (output_buffer == NULL)
+    if (new_buckets == NULL)
     {
-        return false;
+        return; /* longer chains, but still correct */
     }
+    memset(new_buckets, '\0', (new_mask + 1) * sizeof(interned_key*));
 
-    /* empty string */
-    if (input == NULL)
+    for (i = 0; i <= pool->mask; i++)
     {
-        output = ensure(output_buffer, sizeof("\"\""));
-        if (output == NULL)
+        interned_key *key = pool->buckets[i];
+        while (key != NULL)
         {
-            return false;
+            interned_key *next = key->next;
+            key->next = new_buckets[key->hash & new_mask];
+            new_buckets[key->hash & new_mask] = key;
+            key = next;
         }
-        strcpy((char*)output, "\"\"");
-
-        return true;
     }
 
-    /* set "flag" to 1 if something needs to be escaped */
-    for (input_pointer = input; *input_pointer; input_pointer++)
+    global_hooks.deallocate(pool->buckets);
+    pool->buckets = new_buckets;
+    pool->mask = new_mask;
+}
+
+/* get a reference to the pooled copy of string */
+static char *key_pool_intern(cJSON_KeyPool * const pool, const unsigned char * const string)
+{
+    unsigned long hash = index_hash(string);
+    size_t length = 0;
+    interned_key *key = NULL;
+
+    for (key = pool->buckets[hash & pool->mask]; key != NULL; key = key->next)
     {
-        switch (*input_pointer)
+        if ((key->hash == hash) && (strcmp(key->string, (const char*)string) == 0))
         {
-            case '\"':
-            case '\\':
-            case '\b':
-            case '\f':
-            case '\n':
-            case '\r':
-            case '\t':
-                /* one character escape sequence */
-                escape_characters++;
-                break;
-            default:
-                if (*input_pointer < 32)
-                {
-                    /* UTF-16 escape sequence uXXXX */
-                    escape_characters += 5;
-                }
-                break;
+            key->references++;
+            return key->string;
         }
     }
-    output_length = (size_t)(input_pointer - input) + escape_characters;
 
-    output = ensure(output_buffer, output_length + sizeof("\"\""));
-    if (output == NULL)
+    length = strlen((const char*)string);
+    key = (interned_key*)global_hooks.allocate(offsetof(interned_key, string) + length + sizeof(""));
+    if (key == NULL)
     {
-        return false;
+        return NULL;
     }
+    key->pool = pool;
+    key->references = 1;
+    key->hash = hash;
+    memcpy(key->string, string, length + sizeof(""));
 
-    /* no characters have to be escaped */
-    if (escape_characters == 0)
+    if (pool->count > pool->mask)
     {
-        output[0] = '\"';
-        memcpy(output + 1, input, output_length);
-        output[output_length + 1] = '\"';
-        output[output_length + 2] = '\0';
+        key_pool_grow(pool);
+    }
+    key->next = pool->buckets[hash & pool->mask];
+    pool->buckets[hash & pool->mask] = key;
+    pool->count++;
 
-        return true;
+    return key->string;
+}
+
+static void key_pool_release(char * const string)
+{
+    interned_key *key = interned_key_of(string);
+
+    key->references--;
+    if (key->references > 0)
+    {
+        return;
     }
 
-    output[0] = '\"';
-    output_pointer = output + 1;
-    /* copy the string */
-    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
+    if (key->pool != NULL)
     {
-        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+        interned_key **link = &key->pool->buckets[key->hash & key->pool->mask];
+        while (*link != key)
         {
-            /* normal character, copy */
-            *output_pointer = *input_pointer;
-        }
-        else
-        {
-            /* character needs to be escaped */
-            *output_pointer++ = '\\';
-            switch (*input_pointer)
-            {
-                case '\\':
-                    *output_pointer = '\\';
-                    break;
-                case '\"':
-                    *output_pointer = '\"';
-                    break;
-                case '\b':
-                    *output_pointer = 'b';
-                    break;
-                case '\f':
-                    *output_pointer = 'f';
-                    break;
-                case '\n':
-                    *output_pointer = 'n';
-                    break;
-                case '\r':
-                    *output_pointer = 'r';
-                    break;
-                case '\t':
-                    *output_pointer = 't';
-                    break;
-                default:
-                    /* escape and print as unicode codepoint */
-                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
-                    output_pointer += 4;
-                    break;
-            }
+            link = &(*link)->next;
         }
+        *link = key->next;
+        key->pool->count--;
     }
-    output[output_length + 1] = '\"';
-    output[output_length + 2] = '\0';
-
-    return true;
-}
-
-/* Invoke print_string_ptr (which is useful) on an item. */
-static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
-{
-    return print_string_ptr((unsigned char*)item->valuestring, p);
+    global_hooks.deallocate(key);
 }
 
-/* Predeclare these prototypes. */
-static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
-
-/* Utility to jump whitespace and cr/lf */
-static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
+/* free or release the key of item, depending on who owns it */
+static void delete_key(cJSON * const item, const internal_hooks * const hooks)
 {
-    if ((buffer == NULL) || (buffer->content == NULL))
+    if (item->string == NULL)
     {
-        return NULL;
+        return;
     }
 
-    if (cannot_access_at_index(buffer, 0))
+    if (item->type & cJSON_StringIsInterned)
     {
-        return buffer;
+        key_pool_release(item->string);
     }
-
-    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    else if (!(item->type & cJSON_StringIsConst))
     {
-       buffer->offset++;
+        hooks->deallocate(item->string);
     }
+    item->string = NULL;
+    item->type &= ~(cJSON_StringIsConst | cJSON_StringIsInterned);
+}
 
-    if (buffer->offset == buffer->length)
+CJSON_PUBLIC(void) cJSON_ReleaseKey(cJSON * const item)
+{
+    if (item != NULL)
     {
-        buffer->offset--;
+        delete_key(item, &global_hooks);
     }
-
-    return buffer;
 }
 
-/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
-static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+/* children shared by cJSON_DuplicateShared, arrays and objects with cJSON_IsShared keep it in valuestring */
+typedef struct
 {
-    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
-    {
-        return NULL;
-    }
+    size_t references; /* number of arrays and objects using the children */
+} shared_children;
 
-    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
-    {
-        buffer->offset += 3;
-    }
-
-    return buffer;
-}
+#define shared_children_of(item) ((shared_children*)(void*)(item)->valuestring)
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+/* the numbers of an array with cJSON_PackedNumberArray, in valuestring instead of children (never empty) */
+typedef union
 {
-    size_t buffer_length;
-
-    if (NULL == value)
-    {
-        return NULL;
-    }
-
-    /* Adding null character size due to require_null_terminated. */
-    buffer_length = strlen(value) + sizeof("");
+    double number;
+    cJSON_int64 integer;
+} packed_value;
 
-    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
-}
-
-/* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+typedef struct
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
-    cJSON *item = NULL;
-
-    /* reset error position */
-    global_error.json = NULL;
-    global_error.position = 0;
-
-    if (value == NULL || 0 == buffer_length)
-    {
-        goto fail;
-    }
-
-    buffer.content = (const unsigned char*)value;
-    buffer.length = buffer_length;
-    buffer.offset = 0;
-    buffer.hooks = global_hooks;
-
-    item = cJSON_New_Item(&global_hooks);
-    if (item == NULL) /* memory fail */
-    {
-        goto fail;
-    }
+    size_t count;
+    cJSON_bool integers; /* the values are integer, not number */
+    packed_value values[1];
+} packed_numbers;
 
-    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
-    {
-        /* parse failure. ep is set. */
-        goto fail;
-    }
+#define packed_numbers_of(item) ((packed_numbers*)(void*)(item)->valuestring)
+#define packed_numbers_size(count) (sizeof(packed_numbers) + ((count) - 1) * sizeof(packed_value))
 
-    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-    if (require_null_terminated)
+/* Delete a cJSON structure whose items and strings were allocated with hooks. */
+static void delete_item(cJSON *item, const internal_hooks * const hooks)
+{
+    cJSON *next = NULL;
+    cJSON *last = NULL;
+    while (item != NULL)
     {
-        buffer_skip_whitespace(&buffer);
-        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        next = item->next;
+        if ((item->type & (cJSON_IsShared | cJSON_IsReference)) == cJSON_IsShared)
         {
-            goto fail;
+            /* shared children are deleted with the last copy, the counts always come from the global hooks */
+            shared_children *shared = shared_children_of(item);
+            item->valuestring = NULL;
+            if (shared->references > 1)
+            {
+                shared->references--;
+                item->child = NULL;
+            }
+            else
+            {
+                global_hooks.deallocate(shared);
+            }
         }
-    }
-    if (return_parse_end)
-    {
-        *return_parse_end = (const char*)buffer_at_offset(&buffer);
-    }
-
-    return item;
-
-fail:
-    if (item != NULL)
-    {
-        cJSON_Delete(item);
-    }
-
-    if (value != NULL)
-    {
-        error local_error;
-        local_error.json = (const unsigned char*)value;
-        local_error.position = 0;
-
-        if (buffer.offset < buffer.length)
+        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
         {
-            local_error.position = buffer.offset;
+            /* the children are deleted next instead of recursing into them, so nesting doesn't use up the stack */
+            last = item->child->prev;
+            if ((last == NULL) || (last->next != NULL))
+            {
+                /* lists of failed parses aren't closed yet */
+                for (last = item->child; last->next != NULL; last = last->next)
+                {
+                }
+            }
+            last->next = next;
+            next = item->child;
+            item->child = NULL;
         }
-        else if (buffer.length > 0)
+        /* lookup indexes always come from the global hooks */
+        index_free(item);
+        if (!(item->type & (cJSON_IsReference | cJSON_IsArenaItem)) && (item->valuestring != NULL))
         {
-            local_error.position = buffer.length - 1;
+            hooks->deallocate(item->valuestring);
+            item->valuestring = NULL;
         }
-
-        if (return_parse_end != NULL)
+        delete_key(item, hooks);
+        /* arena memory is only released by cJSON_ArenaFree */
+        if (!(item->type & cJSON_IsArenaItem))
         {
-            *return_parse_end = (const char*)local_error.json + local_error.position;
+            hooks->deallocate(item);
         }
-
-        global_error = local_error;
+        item = next;
     }
-
-    return NULL;
 }
 
-/* Default options for cJSON_Parse */
-CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+/* Delete a cJSON structure. */
+CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
 {
-    return cJSON_ParseWithOpts(value, 0, 0);
+    delete_item(item, &global_hooks);
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+CJSON_PUBLIC(void) cJSON_DeleteCtx(cJSON *item, const cJSON_Context *context)
 {
-    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+    internal_hooks hooks;
+
+    if (context == NULL)
+    {
+        return;
+    }
+    set_hooks(&hooks, &context->hooks);
+
+    delete_item(item, &hooks);
 }
 
-#define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
+/* get the decimal point character of the current locale */
+static unsigned char get_decimal_point(void)
+{
+#ifdef ENABLE_LOCALES
+    struct lconv *lconv = localeconv();
+    return (unsigned char) lconv->decimal_point[0];
+#else
+    return '.';
+#endif
+}
 
-static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
+typedef struct
 {
-    static const size_t default_buffer_size = 256;
-    printbuffer buffer[1];
-    unsigned char *printed = NULL;
+    const unsigned char *content;
+    size_t length;
+    size_t offset;
+    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
+    internal_hooks hooks;
+    cJSON_Arena *arena; /* items and strings are allocated from here if not NULL */
+    /* event parsing: no tree is built, every value is parsed into scratch_item and reported to events */
+    const cJSON_EventHandler *events;
+    void *events_context;
+    cJSON scratch_item;
+    unsigned char *scratch; /* strings of the current value */
+    size_t scratch_size;
+    size_t scratch_used;
+    cJSON_KeyPool *keys; /* object keys are interned here if not NULL */
+    cJSON_bool scratch_string; /* decode the next string into scratch memory */
+    cJSON_bool in_situ; /* strings are decoded in place, content is writable (requires arena) */
+    cJSON_Context *context; /* hooks, limits and error position of this parse instead of the global ones if not NULL */
+    cJSON_int64 integer; /* exact value of the last number parse_number read, if it has cJSON_IsInt64 */
+} parse_buffer;
 
-    memset(buffer, 0, sizeof(buffer));
+/* check if the given size is left to read in a given parse buffer (starting with 1) */
+#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
+/* check if the buffer can be accessed at the given index (starting with 0) */
+#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
+#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
+/* get a pointer to the buffer at the position */
+#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+/* how deeply arrays and objects may be nested in this parse */
+#define nesting_limit(buffer) ((((buffer)->context != NULL) && ((buffer)->context->nesting_limit != 0)) ? (buffer)->context->nesting_limit : CJSON_NESTING_LIMIT)
 
-    /* create buffer */
-    buffer->buffer = (unsigned char*) hooks->allocate(default_buffer_size);
-    buffer->length = default_buffer_size;
-    buffer->format = format;
-    buffer->hooks = *hooks;
-    if (buffer->buffer == NULL)
+/* allocate a new item for the parser, from the arena if there is one */
+static cJSON *parse_new_item(parse_buffer * const input_buffer)
+{
+    if (input_buffer->events != NULL)
     {
-        goto fail;
+        /* the previous value has been reported, its memory can be reused */
+        memset(&input_buffer->scratch_item, '\0', sizeof(cJSON));
+        input_buffer->scratch_used = 0;
+        return &input_buffer->scratch_item;
     }
-
-    /* print the value */
-    if (!print_value(item, buffer))
+    if (input_buffer->arena != NULL)
     {
-        goto fail;
+        return arena_new_item(input_buffer->arena);
     }
-    update_offset(buffer);
 
-    /* check if reallocate is available */
-    if (hooks->reallocate != NULL)
+    return cJSON_New_Item(&input_buffer->hooks);
+}
+
+/* restore the ownership flags of an arena item, parsing its value overwrites the type */
+/* memory for the strings of the current value in event parsing */
+static unsigned char *parse_scratch_allocate(parse_buffer * const input_buffer, const size_t size)
+{
+    if ((input_buffer->scratch_size - input_buffer->scratch_used) < size)
     {
-        printed = (unsigned char*) hooks->reallocate(buffer->buffer, buffer->offset + 1);
-        if (printed == NULL) {
-            goto fail;
+        /* strings parsed before into the old buffer have already been reported */
+        size_t new_size = (size > (input_buffer->scratch_size * 2)) ? size : (input_buffer->scratch_size * 2);
+        if (input_buffer->scratch != NULL)
+        {
+            input_buffer->hooks.deallocate(input_buffer->scratch);
         }
-        buffer->buffer = NULL;
-    }
-    else /* otherwise copy the JSON over to a new buffer */
-    {
-        printed = (unsigned char*) hooks->allocate(buffer->offset + 1);
-        if (printed == NULL)
+        input_buffer->scratch_size = 0;
+        input_buffer->scratch_used = 0;
+        input_buffer->scratch = (unsigned char*)input_buffer->hooks.allocate(new_size);
+        if (input_buffer->scratch == NULL)
         {
-            goto fail;
+            return NULL;
         }
-        memcpy(printed, buffer->buffer, cjson_min(buffer->length, buffer->offset + 1));
-        printed[buffer->offset] = '\0'; /* just to be sure */
-
-        /* free the buffer */
-        hooks->deallocate(buffer->buffer);
-        buffer->buffer = NULL;
+        input_buffer->scratch_size = new_size;
     }
 
-    return printed;
+    input_buffer->scratch_used += size;
+    return input_buffer->scratch + input_buffer->scratch_used - size;
+}
 
-fail:
-    if (buffer->buffer != NULL)
+/* called for every value after parse_value, returns false to abort parsing */
+static cJSON_bool parse_finish_item(cJSON * const item, const parse_buffer * const input_buffer)
+{
+    if (input_buffer->events != NULL)
     {
-        hooks->deallocate(buffer->buffer);
-        buffer->buffer = NULL;
+        /* arrays and objects have reported themselves already */
+        if (((item->type & 0xFF) == cJSON_Array) || ((item->type & 0xFF) == cJSON_Object) || (input_buffer->events->value == NULL))
+        {
+            return true;
+        }
+        return input_buffer->events->value(input_buffer->events_context, item);
     }
 
-    if (printed != NULL)
+    if ((input_buffer->keys != NULL) && (item->string != NULL))
     {
-        hooks->deallocate(printed);
-        printed = NULL;
+        /* parse_value set the type, the key flags have to be restored */
+        item->type |= cJSON_StringIsConst | cJSON_StringIsInterned;
     }
 
-    return NULL;
-}
+    if (input_buffer->arena == NULL)
+    {
+        return true;
+    }
 
-/* Render a cJSON item/entity/structure to text. */
-CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item)
-{
-    return (char*)print(item, true, &global_hooks);
-}
+    item->type |= cJSON_IsArenaItem;
+    if (item->string != NULL)
+    {
+        /* the key is arena memory as well */
+        item->type |= cJSON_StringIsConst;
+    }
 
-CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item)
-{
-    return (char*)print(item, false, &global_hooks);
+    return true;
 }
 
-CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt)
+/* Store a number in item: valuedouble, the saturated valueint, and cJSON_IsInt64 if the number is integral.
+ * Only integral doubles up to integral_limit are taken as exact integers. An exact value that was stored
+ * before has to be released by the caller. */
+static void set_number(cJSON * const item, const double number, const double integral_limit)
 {
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    item->valuedouble = number;
 
-    if (prebuffer < 0)
+    /* use saturation in case of overflow */
+    if (number >= INT_MAX)
     {
-        return NULL;
+        item->valueint = INT_MAX;
     }
-
-    p.buffer = (unsigned char*)global_hooks.allocate((size_t)prebuffer);
-    if (!p.buffer)
+    else if (number <= (double)INT_MIN)
     {
-        return NULL;
+        item->valueint = INT_MIN;
     }
-
-    p.length = (size_t)prebuffer;
-    p.offset = 0;
-    p.noalloc = false;
-    p.format = fmt;
-    p.hooks = global_hooks;
-
-    if (!print_value(item, &p))
+    else
     {
-        global_hooks.deallocate(p.buffer);
-        p.buffer = NULL;
-        return NULL;
+        item->valueint = (int)number;
     }
 
-    return (char*)p.buffer;
+    item->type &= ~cJSON_IsInt64;
+    if ((number >= -integral_limit) && (number < integral_limit) && ((double)(cJSON_int64)number == number))
+    {
+        item->type |= cJSON_IsInt64;
+    }
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format)
-{
-    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+/* doubles represent every integer up to 2^53 */
+#define CJSON_DOUBLE_EXACT_LIMIT 9007199254740992.0
 
-    if ((length < 0) || (buffer == NULL))
-    {
-        return false;
-    }
+/* Clinger's fast path needs double arithmetic without excess precision */
+#if !defined(CJSON_NO_FAST_FLOAT) && ((defined(FLT_EVAL_METHOD) && ((FLT_EVAL_METHOD == 0) || (FLT_EVAL_METHOD == 1))) \
+    || (defined(__FLT_EVAL_METHOD__) && ((__FLT_EVAL_METHOD__ == 0) || (__FLT_EVAL_METHOD__ == 1))) \
+    || defined(_M_X64) || defined(_M_ARM64))
+#define CJSON_FAST_FLOAT
+#endif
 
-    p.buffer = (unsigned char*)buffer;
-    p.length = (size_t)length;
-    p.offset = 0;
-    p.noalloc = true;
-    p.format = format;
-    p.hooks = global_hooks;
+#ifdef CJSON_FAST_FLOAT
+/* the powers of ten that are exact doubles */
+static const double exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#endif
 
-    return print_value(item, &p);
-}
+#define is_digit(character) (((character) >= '0') && ((character) <= '9'))
 
-/* Parser core - when encountering text, process appropriately. */
-static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
+/* Parse numbers directly from the input without strtod or the locale.
+ * Handles JSON integers of up to 19 digits exactly, and decimals whose value can be computed with a single
+ * correctly rounded multiplication or division (Clinger's fast path: up to 2^53 and an exponent of at most 22).
+ * Returns false for anything else, which is then left to strtod. */
+static cJSON_bool parse_number_fast(cJSON * const item, parse_buffer * const input_buffer)
 {
-    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    const unsigned char * const start = buffer_at_offset(input_buffer);
+    const unsigned char * const end = input_buffer->content + input_buffer->length;
+    const unsigned char *pointer = start;
+    cJSON_bool negative = false;
+    cJSON_bool integer = true;
+    cjson_uint64 mantissa = 0;
+    int digits = 0; /* significant digits in mantissa */
+    long exponent = 0;
+    long explicit_exponent = 0;
+    cJSON_bool exponent_negative = false;
+    double number = 0;
+
+    if ((pointer < end) && (*pointer == '-'))
     {
-        return false; /* no input */
+        negative = true;
+        pointer++;
+    }
+    if ((pointer >= end) || !is_digit(*pointer))
+    {
+        return false;
     }
 
-    /* parse the different types of values */
-    /* null */
-    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
+    /* integer part, without leading zeros */
+    if (*pointer == '0')
     {
-        item->type = cJSON_NULL;
-        input_buffer->offset += 4;
-        return true;
+        pointer++;
     }
-    /* false */
+    else
+    {
+        for (; (pointer < end) && is_digit(*pointer); pointer++)
+        {
+            if (digits == 19)
+            {
+                return false;
+            }
+            mantissa = (mantissa * 10) + (cjson_uint64)(*pointer - '0');
+            digits++;
+        }
+    }
+
+    /* fraction */
+    if ((pointer < end) && (*pointer == '.'))
+    {
+        integer = false;
+        pointer++;
+        if ((pointer >= end) || !is_digit(*pointer))
+        {
+            return false;
+        }
+        for (; (pointer < end) && is_digit(*pointer); pointer++)
+        {
+            if ((mantissa == 0) && (*pointer == '0'))
+            {
+                /* leading zeros only move the decimal point */
+                exponent--;
+                continue;
+            }
+            if (digits == 19)
+            {
+                return false;
+            }
+            mantissa = (mantissa * 10) + (cjson_uint64)(*pointer - '0');
+            digits++;
+            exponent--;
+        }
+    }
+
+    /* exponent */
+    if ((pointer < end) && ((*pointer == 'e') || (*pointer == 'E')))
+    {
+        integer = false;
+        pointer++;
+        if ((pointer < end) && ((*pointer == '+') || (*pointer == '-')))
+        {
+            exponent_negative = (*pointer == '-');
+            pointer++;
+        }
+        if ((pointer >= end) || !is_digit(*pointer))
+        {
+            return false;
+        }
+        for (; (pointer < end) && is_digit(*pointer); pointer++)
+        {
+            if (explicit_exponent < 100000)
+            {
+                explicit_exponent = (explicit_exponent * 10) + (*pointer - '0');
+            }
+        }
+        exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+    }
+
+    /* strtod could read further than the JSON grammar (e.g. "01" or "1."), let it decide those.
+     * The same goes for numbers longer than the 63 characters parse_number ever looked at. */
+    if (((pointer < end) && (is_digit(*pointer) || (*pointer == '.') || (*pointer == 'e') || (*pointer == 'E') || (*pointer == '+') || (*pointer == '-')))
+        || ((pointer - start) > 63))
+    {
+        return false;
+    }
+
+    if (integer)
+    {
+        number = (double)mantissa;
+        set_number(item, negative ? -number : number, CJSON_DOUBLE_EXACT_LIMIT);
+        if (mantissa <= ((cjson_uint64)CJSON_INT64_MAX + (negative ? 1 : 0)))
+        {
+            /* exact, also where the double has to round */
+            input_buffer->integer = negative ? (-(cJSON_int64)(mantissa - 1) - 1) : (cJSON_int64)mantissa;
+            item->type |= cJSON_IsInt64;
+        }
+    }
+    else
+    {
+#ifdef CJSON_FAST_FLOAT
+        if ((mantissa > ((cjson_uint64)1 << 53)) || (exponent < -22) || (exponent > 22))
+        {
+            return false;
+        }
+        number = (double)mantissa;
+        if (exponent < 0)
+        {
+            number /= exact_powers_of_ten[-exponent];
+        }
+        else
+        {
+            number *= exact_powers_of_ten[exponent];
+        }
+        set_number(item, negative ? -number : number, CJSON_DOUBLE_EXACT_LIMIT);
+        if (item->type & cJSON_IsInt64)
+        {
+            /* e.g. 1.5e1 */
+            input_buffer->integer = (cJSON_int64)item->valuedouble;
+        }
+#else
+        return false;
+#endif
+    }
+
+    item->type = (item->type & cJSON_IsInt64) | cJSON_Number;
+    input_buffer->offset += (size_t)(pointer - start);
+
+    return true;
+}
+
+/* Parse the input text to generate a number, and populate the result into item. */
+static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+{
+    double number = 0;
+    unsigned char *after_end = NULL;
+    unsigned char number_c_string[64];
+    unsigned char decimal_point = 0;
+    size_t i = 0;
+
+    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    {
+        return false;
+    }
+
+    if (parse_number_fast(item, input_buffer))
+    {
+        return true;
+    }
+
+    decimal_point = get_decimal_point();
+
+    /* copy the number into a temporary buffer and replace '.' with the decimal point
+     * of the current locale (for strtod)
+     * This also takes care of '\0' not necessarily being available for marking the end of the input */
+    for (i = 0; (i < (sizeof(number_c_string) - 1)) && can_access_at_index(input_buffer, i); i++)
+    {
+        switch (buffer_at_offset(input_buffer)[i])
+        {
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+            case '+':
+            case '-':
+            case 'e':
+            case 'E':
+                number_c_string[i] = buffer_at_offset(input_buffer)[i];
+                break;
+
+            case '.':
+                number_c_string[i] = decimal_point;
+                break;
+
+            default:
+                goto loop_end;
+        }
+    }
+loop_end:
+    number_c_string[i] = '\0';
+
+    number = strtod((const char*)number_c_string, (char**)&after_end);
+    if (number_c_string == after_end)
+    {
+        return false; /* parse_error */
+    }
+
+    item->type = cJSON_Number;
+    set_number(item, number, CJSON_DOUBLE_EXACT_LIMIT);
+    if (item->type & cJSON_IsInt64)
+    {
+        input_buffer->integer = (cJSON_int64)number;
+    }
+
+    input_buffer->offset += (size_t)(after_end - number_c_string);
+    return true;
+}
+
+/* keep the exact value of the integer parse_number just read into item, if its double had to round */
+static cJSON_bool parse_exact_integer(cJSON * const item, parse_buffer * const input_buffer)
+{
+    unsigned char *exact = NULL;
+
+    if (!(item->type & cJSON_IsInt64) || !integer_rounded(input_buffer->integer, item->valuedouble))
+    {
+        return true;
+    }
+
+    if (input_buffer->events != NULL)
+    {
+        /* only valid while the value is reported, like its strings */
+        exact = parse_scratch_allocate(input_buffer, sizeof(cJSON_int64));
+    }
+    else if (input_buffer->arena != NULL)
+    {
+        exact = (unsigned char*)arena_allocate(input_buffer->arena, sizeof(cJSON_int64));
+    }
+    else
+    {
+        exact = (unsigned char*)input_buffer->hooks.allocate(sizeof(cJSON_int64));
+    }
+    if (exact == NULL)
+    {
+        return false;
+    }
+    memcpy(exact, &input_buffer->integer, sizeof(cJSON_int64));
+    item->valuestring = (char*)exact;
+
+    return true;
+}
+
+/* the block of a packed array of count numbers, from the global hooks */
+static packed_numbers *packed_numbers_new(const size_t count, const cJSON_bool integers)
+{
+    packed_numbers *packed = NULL;
+
+    if ((count == 0) || (count > ((((size_t)-1) - sizeof(packed_numbers)) / sizeof(packed_value))))
+    {
+        return NULL;
+    }
+
+    packed = (packed_numbers*)global_hooks.allocate(packed_numbers_size(count));
+    if (packed == NULL)
+    {
+        return NULL;
+    }
+    packed->count = count;
+    packed->integers = integers;
+
+    return packed;
+}
+
+/* write element i of a packed array into number, the item it expands to.
+ * An exact value that number needs stays in the packed array. */
+static void packed_number(packed_numbers * const packed, const size_t i, cJSON * const number)
+{
+    memset(number, '\0', sizeof(cJSON));
+    number->type = cJSON_Number;
+    if (!packed->integers)
+    {
+        set_number(number, packed->values[i].number, CJSON_DOUBLE_EXACT_LIMIT);
+        return;
+    }
+
+    set_number(number, (double)packed->values[i].integer, CJSON_DOUBLE_EXACT_LIMIT);
+    number->type |= cJSON_IsInt64;
+    if (integer_rounded(packed->values[i].integer, number->valuedouble))
+    {
+        number->valuestring = (char*)&packed->values[i].integer;
+    }
+}
+
+/* replace the numbers of a packed array with items, for everything that needs its children */
+static cJSON_bool unpack_array(cJSON * const array)
+{
+    packed_numbers *packed = packed_numbers_of(array);
+    cJSON *head = NULL;
+    cJSON *last = NULL;
+    cJSON *item = NULL;
+    size_t i = 0;
+
+    for (i = 0; i < packed->count; i++)
+    {
+        item = cJSON_New_Item(&global_hooks);
+        if (item == NULL)
+        {
+            /* the array stays packed */
+            delete_item(head, &global_hooks);
+            return false;
+        }
+        packed_number(packed, i, item);
+        if (item->valuestring != NULL)
+        {
+            /* the exact value has to move out of the packed array, which is freed below */
+            item->valuestring = (char*)global_hooks.allocate(sizeof(cJSON_int64));
+            if (item->valuestring == NULL)
+            {
+                global_hooks.deallocate(item);
+                delete_item(head, &global_hooks);
+                return false;
+            }
+            memcpy(item->valuestring, &packed->values[i].integer, sizeof(cJSON_int64));
+        }
+
+        if (last == NULL)
+        {
+            head = item;
+        }
+        else
+        {
+            last->next = item;
+            item->prev = last;
+        }
+        last = item;
+    }
+    head->prev = last;
+
+    array->child = head;
+    array->valuestring = NULL;
+    array->type &= ~cJSON_PackedNumberArray;
+    global_hooks.deallocate(packed);
+
+    return true;
+}
+
+/* element i of an array without expanding it: a packed one is written into number, for the others *child
+ * walks the list and has to start at array->child. NULL after the last element. */
+static const cJSON *array_element(const cJSON * const array, const size_t i, const cJSON ** const child, cJSON * const number)
+{
+    const cJSON *element = NULL;
+
+    if (array->type & cJSON_PackedNumberArray)
+    {
+        if (i >= packed_numbers_of(array)->count)
+        {
+            return NULL;
+        }
+        packed_number(packed_numbers_of(array), i, number);
+        return number;
+    }
+
+    element = *child;
+    if (element != NULL)
+    {
+        *child = element->next;
+    }
+
+    return element;
+}
+
+/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
+CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
+{
+    if (((object->type & 0xFF) == cJSON_Number) && (object->valuestring != NULL))
+    {
+        /* the exact value of the old number */
+        if (!(object->type & (cJSON_IsReference | cJSON_IsArenaItem)))
+        {
+            global_hooks.deallocate(object->valuestring);
+        }
+        object->valuestring = NULL;
+    }
+    set_number(object, number, CJSON_INT64_LIMIT);
+
+    return object->valuedouble;
+}
+
+/* Note: when passing a NULL valuestring, cJSON_SetValuestring treats this as an error and return NULL */
+CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+{
+    char *copy = NULL;
+    size_t v1_len;
+    size_t v2_len;
+    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
+    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    {
+        return NULL;
+    }
+    /* return NULL if the object is corrupted or valuestring is NULL */
+    if (object->valuestring == NULL || valuestring == NULL)
+    {
+        return NULL;
+    }
+
+    v1_len = strlen(valuestring);
+    v2_len = strlen(object->valuestring);
+
+    if (v1_len <= v2_len)
+    {
+        /* strcpy does not handle overlapping string: [X1, X2] [Y1, Y2] => X2 < Y1 or Y2 < X1 */
+        if (!( valuestring + v1_len < object->valuestring || object->valuestring + v2_len < valuestring ))
+        {
+            return NULL;
+        }
+        strcpy(object->valuestring, valuestring);
+        return object->valuestring;
+    }
+    if (object->type & cJSON_IsArenaItem)
+    {
+        /* arena strings are not freed one by one, take the new one from the arena as well */
+        copy = (char*)arena_allocate(arena_of_item(object), v1_len + sizeof(""));
+        if (copy == NULL)
+        {
+            return NULL;
+        }
+        memcpy(copy, valuestring, v1_len + sizeof(""));
+        object->valuestring = copy;
+
+        return copy;
+    }
+
+    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    if (object->valuestring != NULL)
+    {
+        cJSON_free(object->valuestring);
+    }
+    object->valuestring = copy;
+
+    return copy;
+}
+
+/* size of the reusable buffer of cJSON_PrintToWriter */
+#ifndef CJSON_PRINT_CHUNK_SIZE
+#define CJSON_PRINT_CHUNK_SIZE (64 * 1024)
+#endif
+
+typedef struct
+{
+    unsigned char *buffer;
+    size_t length;
+    size_t offset;
+    size_t depth; /* current nesting depth (for formatted printing) */
+    cJSON_bool noalloc;
+    cJSON_bool format; /* is this print a formatted print */
+    internal_hooks hooks;
+    /* streaming: when the buffer is full, its contents are passed to writer and it is reused */
+    cJSON_Writer writer;
+    void *writer_context;
+} printbuffer;
+
+/* realloc printbuffer if necessary to have at least "needed" bytes more */
+static unsigned char* ensure(printbuffer * const p, size_t needed)
+{
+    unsigned char *newbuffer = NULL;
+    size_t newsize = 0;
+
+    if ((p == NULL) || (p->buffer == NULL))
+    {
+        return NULL;
+    }
+
+    if ((p->length > 0) && (p->offset >= p->length))
+    {
+        /* make sure that offset is valid */
+        return NULL;
+    }
+
+    if (needed > INT_MAX)
+    {
+        /* sizes bigger than INT_MAX are currently not supported */
+        return NULL;
+    }
+
+    needed += p->offset + 1;
+    if (needed <= p->length)
+    {
+        return p->buffer + p->offset;
+    }
+
+    if ((p->writer != NULL) && (p->offset > 0))
+    {
+        /* flush and start over, the buffer only grows for values that don't fit on their own */
+        if (!p->writer(p->writer_context, (const char*)p->buffer, p->offset))
+        {
+            return NULL;
+        }
+        needed -= p->offset;
+        p->offset = 0;
+        if (needed <= p->length)
+        {
+            return p->buffer;
+        }
+    }
+
+    if (p->noalloc) {
+        return NULL;
+    }
+
+    /* calculate new buffer size */
+    if (needed > (INT_MAX / 2))
+    {
+        /* overflow of int, use INT_MAX if possible */
+        if (needed <= INT_MAX)
+        {
+            newsize = INT_MAX;
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        newsize = needed * 2;
+    }
+
+    if (p->hooks.reallocate != NULL)
+    {
+        /* reallocate with realloc if available */
+        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
+        if (newbuffer == NULL)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+    }
+    else
+    {
+        /* otherwise reallocate manually */
+        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
+        if (!newbuffer)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+
+        memcpy(newbuffer, p->buffer, p->offset + 1);
+        p->hooks.deallocate(p->buffer);
+    }
+    p->length = newsize;
+    p->buffer = newbuffer;
+
+    return newbuffer + p->offset;
+}
+
+/* calculate the new length of the string in a printbuffer and update the offset */
+static void update_offset(printbuffer * const buffer)
+{
+    const unsigned char *buffer_pointer = NULL;
+    if ((buffer == NULL) || (buffer->buffer == NULL))
+    {
+        return;
+    }
+    buffer_pointer = buffer->buffer + buffer->offset;
+
+    buffer->offset += strlen((const char*)buffer_pointer);
+}
+
+/* securely comparison of floating-point variables */
+static cJSON_bool compare_double(double a, double b)
+{
+    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+}
+
+/* Render the number nicely from the given item into a string. */
+/* print an int64 in decimal, returns the length */
+static int print_int64(const cJSON_int64 number, unsigned char * const output)
+{
+    unsigned char digits[20];
+    int count = 0;
+    int length = 0;
+    /* negate in unsigned arithmetic, -CJSON_INT64_MIN doesn't fit */
+    cjson_uint64 magnitude = (number < 0) ? ((cjson_uint64)0 - (cjson_uint64)number) : (cjson_uint64)number;
+
+    do
+    {
+        digits[count++] = (unsigned char)('0' + (int)(magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (number < 0)
+    {
+        output[length++] = '-';
+    }
+    while (count > 0)
+    {
+        output[length++] = digits[--count];
+    }
+    output[length] = '\0';
+
+    return length;
+}
+
+/* Shortest round trip printing of doubles with Grisu3 (Florian Loitsch, "Printing Floating-Point Numbers
+ * Quickly and Accurately with Integers"). It either proves its digits are the shortest that read back as
+ * the same double, or gives up on the number (about 0.5% of doubles), which then goes through printf. */
+typedef struct
+{
+    cjson_uint64 f;
+    int e;
+} diy_fp;
+
+#define DIY_FP_HIDDEN_BIT ((cjson_uint64)1 << 52)
+#define DIY_FP_SIGNIFICAND_MASK (DIY_FP_HIDDEN_BIT - 1)
+#define DIY_FP_SIGN_BIT ((cjson_uint64)1 << 63)
+
+typedef struct
+{
+    unsigned long high; /* the 64 bit significand, split for C89 */
+    unsigned long low;
+    short binary_exponent;
+    short decimal_exponent;
+} cached_power;
+
+/* normalized 10^e for e = -348, -340, ..., 340 */
+static const cached_power cached_powers[] = {
+    { 0xfa8fd5a0, 0x081c0288, -1220, -348 },
+    { 0xbaaee17f, 0xa23ebf76, -1193, -340 },
+    { 0x8b16fb20, 0x3055ac76, -1166, -332 },
+    { 0xcf42894a, 0x5dce35ea, -1140, -324 },
+    { 0x9a6bb0aa, 0x55653b2d, -1113, -316 },
+    { 0xe61acf03, 0x3d1a45df, -1087, -308 },
+    { 0xab70fe17, 0xc79ac6ca, -1060, -300 },
+    { 0xff77b1fc, 0xbebcdc4f, -1034, -292 },
+    { 0xbe5691ef, 0x416bd60c, -1007, -284 },
+    { 0x8dd01fad, 0x907ffc3c, -980, -276 },
+    { 0xd3515c28, 0x31559a83, -954, -268 },
+    { 0x9d71ac8f, 0xada6c9b5, -927, -260 },
+    { 0xea9c2277, 0x23ee8bcb, -901, -252 },
+    { 0xaecc4991, 0x4078536d, -874, -244 },
+    { 0x823c1279, 0x5db6ce57, -847, -236 },
+    { 0xc2109436, 0x4dfb5637, -821, -228 },
+    { 0x9096ea6f, 0x3848984f, -794, -220 },
+    { 0xd77485cb, 0x25823ac7, -768, -212 },
+    { 0xa086cfcd, 0x97bf97f4, -741, -204 },
+    { 0xef340a98, 0x172aace5, -715, -196 },
+    { 0xb23867fb, 0x2a35b28e, -688, -188 },
+    { 0x84c8d4df, 0xd2c63f3b, -661, -180 },
+    { 0xc5dd4427, 0x1ad3cdba, -635, -172 },
+    { 0x936b9fce, 0xbb25c996, -608, -164 },
+    { 0xdbac6c24, 0x7d62a584, -582, -156 },
+    { 0xa3ab6658, 0x0d5fdaf6, -555, -148 },
+    { 0xf3e2f893, 0xdec3f126, -529, -140 },
+    { 0xb5b5ada8, 0xaaff80b8, -502, -132 },
+    { 0x87625f05, 0x6c7c4a8b, -475, -124 },
+    { 0xc9bcff60, 0x34c13053, -449, -116 },
+    { 0x964e858c, 0x91ba2655, -422, -108 },
+    { 0xdff97724, 0x70297ebd, -396, -100 },
+    { 0xa6dfbd9f, 0xb8e5b88f, -369, -92 },
+    { 0xf8a95fcf, 0x88747d94, -343, -84 },
+    { 0xb9447093, 0x8fa89bcf, -316, -76 },
+    { 0x8a08f0f8, 0xbf0f156b, -289, -68 },
+    { 0xcdb02555, 0x653131b6, -263, -60 },
+    { 0x993fe2c6, 0xd07b7fac, -236, -52 },
+    { 0xe45c10c4, 0x2a2b3b06, -210, -44 },
+    { 0xaa242499, 0x697392d3, -183, -36 },
+    { 0xfd87b5f2, 0x8300ca0e, -157, -28 },
+    { 0xbce50864, 0x92111aeb, -130, -20 },
+    { 0x8cbccc09, 0x6f5088cc, -103, -12 },
+    { 0xd1b71758, 0xe219652c, -77, -4 },
+    { 0x9c400000, 0x00000000, -50, 4 },
+    { 0xe8d4a510, 0x00000000, -24, 12 },
+    { 0xad78ebc5, 0xac620000, 3, 20 },
+    { 0x813f3978, 0xf8940984, 30, 28 },
+    { 0xc097ce7b, 0xc90715b3, 56, 36 },
+    { 0x8f7e32ce, 0x7bea5c70, 83, 44 },
+    { 0xd5d238a4, 0xabe98068, 109, 52 },
+    { 0x9f4f2726, 0x179a2245, 136, 60 },
+    { 0xed63a231, 0xd4c4fb27, 162, 68 },
+    { 0xb0de6538, 0x8cc8ada8, 189, 76 },
+    { 0x83c7088e, 0x1aab65db, 216, 84 },
+    { 0xc45d1df9, 0x42711d9a, 242, 92 },
+    { 0x924d692c, 0xa61be758, 269, 100 },
+    { 0xda01ee64, 0x1a708dea, 295, 108 },
+    { 0xa26da399, 0x9aef774a, 322, 116 },
+    { 0xf209787b, 0xb47d6b85, 348, 124 },
+    { 0xb454e4a1, 0x79dd1877, 375, 132 },
+    { 0x865b8692, 0x5b9bc5c2, 402, 140 },
+    { 0xc83553c5, 0xc8965d3d, 428, 148 },
+    { 0x952ab45c, 0xfa97a0b3, 455, 156 },
+    { 0xde469fbd, 0x99a05fe3, 481, 164 },
+    { 0xa59bc234, 0xdb398c25, 508, 172 },
+    { 0xf6c69a72, 0xa3989f5c, 534, 180 },
+    { 0xb7dcbf53, 0x54e9bece, 561, 188 },
+    { 0x88fcf317, 0xf22241e2, 588, 196 },
+    { 0xcc20ce9b, 0xd35c78a5, 614, 204 },
+    { 0x98165af3, 0x7b2153df, 641, 212 },
+    { 0xe2a0b5dc, 0x971f303a, 667, 220 },
+    { 0xa8d9d153, 0x5ce3b396, 694, 228 },
+    { 0xfb9b7cd9, 0xa4a7443c, 720, 236 },
+    { 0xbb764c4c, 0xa7a44410, 747, 244 },
+    { 0x8bab8eef, 0xb6409c1a, 774, 252 },
+    { 0xd01fef10, 0xa657842c, 800, 260 },
+    { 0x9b10a4e5, 0xe9913129, 827, 268 },
+    { 0xe7109bfb, 0xa19c0c9d, 853, 276 },
+    { 0xac2820d9, 0x623bf429, 880, 284 },
+    { 0x80444b5e, 0x7aa7cf85, 907, 292 },
+    { 0xbf21e440, 0x03acdd2d, 933, 300 },
+    { 0x8e679c2f, 0x5e44ff8f, 960, 308 },
+    { 0xd433179d, 0x9c8cb841, 986, 316 },
+    { 0x9e19db92, 0xb4e31ba9, 1013, 324 },
+    { 0xeb96bf6e, 0xbadf77d9, 1039, 332 },
+    { 0xaf87023b, 0x9bf0ee6b, 1066, 340 }
+};
+
+static diy_fp diy_fp_from_double(const double value)
+{
+    diy_fp result;
+    cjson_uint64 bits = 0;
+    int biased_exponent = 0;
+
+    memcpy(&bits, &value, sizeof(bits));
+    biased_exponent = (int)((bits >> 52) & 0x7FF);
+    result.f = bits & DIY_FP_SIGNIFICAND_MASK;
+    if (biased_exponent != 0)
+    {
+        result.f += DIY_FP_HIDDEN_BIT;
+        result.e = biased_exponent - 1075;
+    }
+    else
+    {
+        /* subnormal */
+        result.e = -1074;
+    }
+
+    return result;
+}
+
+static diy_fp diy_fp_normalize(diy_fp value)
+{
+    while (!(value.f & DIY_FP_SIGN_BIT))
+    {
+        value.f <<= 1;
+        value.e--;
+    }
+
+    return value;
+}
+
+/* the upper 64 bits of the 128 bit product, rounded */
+static diy_fp diy_fp_multiply(const diy_fp x, const diy_fp y)
+{
+    diy_fp result;
+    const cjson_uint64 mask32 = 0xFFFFFFFFUL;
+    const cjson_uint64 a = x.f >> 32;
+    const cjson_uint64 b = x.f & mask32;
+    const cjson_uint64 c = y.f >> 32;
+    const cjson_uint64 d = y.f & mask32;
+    const cjson_uint64 ac = a * c;
+    const cjson_uint64 bc = b * c;
+    const cjson_uint64 ad = a * d;
+    const cjson_uint64 bd = b * d;
+    cjson_uint64 middle = (bd >> 32) + (ad & mask32) + (bc & mask32);
+
+    middle += (cjson_uint64)1 << 31;
+    result.f = ac + (ad >> 32) + (bc >> 32) + (middle >> 32);
+    result.e = x.e + y.e + 64;
+
+    return result;
+}
+
+/* the boundaries m- and m+ of the interval of numbers that round to value, with the exponent of m+ */
+static void diy_fp_boundaries(const diy_fp value, diy_fp * const minus, diy_fp * const plus)
+{
+    diy_fp upper;
+    diy_fp lower;
+
+    upper.f = (value.f << 1) + 1;
+    upper.e = value.e - 1;
+    while (!(upper.f & (DIY_FP_HIDDEN_BIT << 1)))
+    {
+        upper.f <<= 1;
+        upper.e--;
+    }
+    upper.f <<= 64 - 52 - 2;
+    upper.e -= 64 - 52 - 2;
+
+    if (value.f == DIY_FP_HIDDEN_BIT)
+    {
+        /* the distance to the next smaller double is only half as large */
+        lower.f = (value.f << 2) - 1;
+        lower.e = value.e - 2;
+    }
+    else
+    {
+        lower.f = (value.f << 1) - 1;
+        lower.e = value.e - 1;
+    }
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    *minus = lower;
+    *plus = upper;
+}
+
+/* a cached power c, such that the exponent of e * c lands in [-60, -32], and its negated decimal exponent */
+static diy_fp cached_power_for(const int binary_exponent, int * const decimal_exponent)
+{
+    diy_fp result;
+    const cached_power *power = NULL;
+    double k_estimate = ((-61 - binary_exponent) * 0.30102999566398114) + 347;
+    int k = (int)k_estimate;
+
+    if ((k_estimate - k) > 0.0)
+    {
+        k++;
+    }
+    power = &cached_powers[(k >> 3) + 1];
+
+    result.f = ((cjson_uint64)power->high << 32) | (cjson_uint64)power->low;
+    result.e = power->binary_exponent;
+    *decimal_exponent = -power->decimal_exponent;
+
+    return result;
+}
+
+/* Grisu3's round_weed: move the last digit closer to w while it stays inside the unsafe interval, then tell
+ * whether the digits are certainly the closest shortest ones. unit is how far off the products can be. */
+static cJSON_bool grisu_round(unsigned char * const digits, const int length, const cjson_uint64 distance_too_high_w, const cjson_uint64 unsafe_interval, cjson_uint64 rest, const cjson_uint64 ten_kappa, const cjson_uint64 unit)
+{
+    const cjson_uint64 small_distance = distance_too_high_w - unit;
+    const cjson_uint64 big_distance = distance_too_high_w + unit;
+
+    while ((rest < small_distance) && ((unsafe_interval - rest) >= ten_kappa)
+        && (((rest + ten_kappa) < small_distance) || ((small_distance - rest) >= ((rest + ten_kappa) - small_distance))))
+    {
+        digits[length - 1]--;
+        rest += ten_kappa;
+    }
+
+    /* with the error, the next lower digit could be closer as well */
+    if ((rest < big_distance) && ((unsafe_interval - rest) >= ten_kappa)
+        && (((rest + ten_kappa) < big_distance) || ((big_distance - rest) > ((rest + ten_kappa) - big_distance))))
+    {
+        return false;
+    }
+
+    /* and the digits have to be inside the real interval, not just the unsafe one */
+    return ((2 * unit) <= rest) && (rest <= (unsafe_interval - (4 * unit)));
+}
+
+/* generate the digits of w, as few as the unsafe interval (low, high) allows. Returns 0 if the digits might not
+ * be the shortest or might not read back as the same double. */
+static int grisu_digits(const diy_fp low, const diy_fp w, const diy_fp high, unsigned char * const digits, int * const decimal_exponent)
+{
+    const int shift = -w.e;
+    const cjson_uint64 one = (cjson_uint64)1 << shift;
+    const cjson_uint64 too_high = high.f + 1;
+    cjson_uint64 unsafe_interval = too_high - (low.f - 1);
+    cjson_uint64 unit = 1;
+    unsigned long integral = (unsigned long)(too_high >> shift); /* < 2^32 */
+    cjson_uint64 fractional = too_high & (one - 1);
+    unsigned long divisor = 1000000000UL;
+    int kappa = 10;
+    int length = 0;
+
+    while ((kappa > 1) && (divisor > integral))
+    {
+        divisor /= 10;
+        kappa--;
+    }
+
+    while (kappa > 0)
+    {
+        const unsigned long digit = integral / divisor;
+        cjson_uint64 rest = 0;
+
+        integral %= divisor;
+        if ((digit != 0) || (length != 0))
+        {
+            digits[length++] = (unsigned char)('0' + digit);
+        }
+        kappa--;
+        rest = ((cjson_uint64)integral << shift) + fractional;
+        if (rest < unsafe_interval)
+        {
+            *decimal_exponent += kappa;
+            return grisu_round(digits, length, too_high - w.f, unsafe_interval, rest, (cjson_uint64)divisor << shift, unit) ? length : 0;
+        }
+        divisor /= 10;
+    }
+
+    for (;;)
+    {
+        unsigned char digit = 0;
+
+        fractional *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        digit = (unsigned char)(fractional >> shift);
+        if ((digit != 0) || (length != 0))
+        {
+            digits[length++] = (unsigned char)('0' + digit);
+        }
+        fractional &= one - 1;
+        kappa--;
+        if (fractional < unsafe_interval)
+        {
+            *decimal_exponent += kappa;
+            return grisu_round(digits, length, (too_high - w.f) * unit, unsafe_interval, fractional, one, unit) ? length : 0;
+        }
+    }
+}
+
+/* shortest digits of a positive, finite double: value = digits * 10^decimal_exponent, returns the number of
+ * digits or 0 for the doubles Grisu3 can't decide */
+static int grisu3(const double value, unsigned char * const digits, int * const decimal_exponent)
+{
+    const diy_fp v = diy_fp_from_double(value);
+    diy_fp minus;
+    diy_fp plus;
+    diy_fp cached;
+    diy_fp w;
+    int length = 0;
+
+    diy_fp_boundaries(v, &minus, &plus);
+    cached = cached_power_for(plus.e, decimal_exponent);
+    w = diy_fp_multiply(diy_fp_normalize(v), cached);
+    plus = diy_fp_multiply(plus, cached);
+    minus = diy_fp_multiply(minus, cached);
+
+    length = grisu_digits(minus, w, plus, digits, decimal_exponent);
+    while ((length > 1) && (digits[length - 1] == '0'))
+    {
+        length--;
+        (*decimal_exponent)++;
+    }
+
+    return length;
+}
+
+/* the slow way for the rest: the fewest digits that printf rounds to and strtod reads back as the same double.
+ * More digits never read back worse, so the count is bisected. */
+static int exact_digits(const double value, unsigned char * const digits, int * const decimal_exponent)
+{
+    char buffer[32];
+    const char *character = NULL;
+    int low = 1;
+    int high = 17;
+    int precision = 0;
+    int length = 0;
+
+    while (low < high)
+    {
+        precision = (low + high) / 2;
+        sprintf(buffer, "%.*e", precision - 1, value);
+        if (strtod(buffer, NULL) == value)
+        {
+            high = precision;
+        }
+        else
+        {
+            low = precision + 1;
+        }
+    }
+
+    /* d.ddde+XX, the decimal point is the one of the locale */
+    sprintf(buffer, "%.*e", low - 1, value);
+    for (character = buffer; *character != 'e'; character++)
+    {
+        if ((*character >= '0') && (*character <= '9'))
+        {
+            digits[length++] = (unsigned char)*character;
+        }
+    }
+    *decimal_exponent = atoi(character + 1) - (length - 1);
+
+    return length;
+}
+
+/* print a finite double like printf's %g would with just enough digits, returns the length */
+static int print_double(double number, unsigned char * const output)
+{
+    unsigned char digits[18];
+    int decimal_exponent = 0;
+    int length = 0;
+    int exponent = 0; /* of the first digit */
+    int precision = 0;
+    int position = 0;
+    int i = 0;
+
+    if (number < 0)
+    {
+        output[position++] = '-';
+        number = -number;
+    }
+    if (number == 0)
+    {
+        output[position++] = '0';
+        output[position] = '\0';
+        return position;
+    }
+
+    length = grisu3(number, digits, &decimal_exponent);
+    if (length == 0)
+    {
+        length = exact_digits(number, digits, &decimal_exponent);
+    }
+    exponent = length + decimal_exponent - 1;
+    /* like the %1.15g and %1.17g this replaces */
+    precision = (length <= 15) ? 15 : 17;
+
+    if ((exponent < -4) || (exponent >= precision))
+    {
+        /* d.ddde+XX */
+        output[position++] = digits[0];
+        if (length > 1)
+        {
+            output[position++] = '.';
+            for (i = 1; i < length; i++)
+            {
+                output[position++] = digits[i];
+            }
+        }
+        output[position++] = 'e';
+        output[position++] = (exponent < 0) ? '-' : '+';
+        if (exponent < 0)
+        {
+            exponent = -exponent;
+        }
+        if (exponent >= 100)
+        {
+            output[position++] = (unsigned char)('0' + (exponent / 100));
+        }
+        output[position++] = (unsigned char)('0' + ((exponent / 10) % 10));
+        output[position++] = (unsigned char)('0' + (exponent % 10));
+    }
+    else if (decimal_exponent >= 0)
+    {
+        /* integral */
+        for (i = 0; i < length; i++)
+        {
+            output[position++] = digits[i];
+        }
+        for (i = 0; i < decimal_exponent; i++)
+        {
+            output[position++] = '0';
+        }
+    }
+    else if (exponent >= 0)
+    {
+        /* ddd.ddd */
+        for (i = 0; i < length; i++)
+        {
+            if (i == (exponent + 1))
+            {
+                output[position++] = '.';
+            }
+            output[position++] = digits[i];
+        }
+    }
+    else
+    {
+        /* 0.000ddd */
+        output[position++] = '0';
+        output[position++] = '.';
+        for (i = -1; i > exponent; i--)
+        {
+            output[position++] = '0';
+        }
+        for (i = 0; i < length; i++)
+        {
+            output[position++] = digits[i];
+        }
+    }
+    output[position] = '\0';
+
+    return position;
+}
+
+/* write the number of item to target (at least 26 bytes), returns its length */
+static int format_number(const cJSON * const item, unsigned char * const target)
+{
+    double d = item->valuedouble;
+    cJSON_int64 integer = 0;
+
+    /* This checks for NaN and Infinity */
+    if (isnan(d) || isinf(d))
+    {
+        memcpy(target, "null", sizeof("null"));
+        return (int)static_strlen("null");
+    }
+    if (exact_integer(item, &integer))
+    {
+        /* exact, also beyond 2^53 */
+        return print_int64(integer, target);
+    }
+    if (d == (double)item->valueint)
+    {
+        return print_int64((cJSON_int64)item->valueint, target);
+    }
+
+    /* no locale involved, the decimal point is always '.' */
+    return print_double(d, target);
+}
+
+static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    int length = 0;
+    unsigned char number_buffer[26] = {0}; /* longest: sign, 17 digits, '.', "e-308" and the terminator */
+    unsigned char *target = number_buffer;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    if (!output_buffer->noalloc)
+    {
+        /* print straight into the output, a preallocated buffer may not have the room to spare */
+        target = ensure(output_buffer, sizeof(number_buffer));
+        if (target == NULL)
+        {
+            return false;
+        }
+    }
+
+    length = format_number(item, target);
+
+    if (target == number_buffer)
+    {
+        output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
+        if (output_pointer == NULL)
+        {
+            return false;
+        }
+        memcpy(output_pointer, number_buffer, (size_t)length + sizeof(""));
+    }
+
+    output_buffer->offset += (size_t)length;
+
+    return true;
+}
+
+/* Scanning strings for the characters that need attention: quotes, backslashes and, when printing,
+ * control characters. Everything in between is copied in bulk. */
+#define SWAR_ONES (((cjson_uint64)0x01010101UL << 32) | (cjson_uint64)0x01010101UL)
+#define SWAR_HIGHS (SWAR_ONES * 0x80)
+/* nonzero if any byte of word is below limit (limit <= 128) */
+#define swar_has_less(word, limit) (((word) - (SWAR_ONES * (limit))) & ~(word) & SWAR_HIGHS)
+#define swar_has_byte(word, byte) swar_has_less((word) ^ (SWAR_ONES * (byte)), 1)
+
+#define needs_attention(character, control) (((character) == '\"') || ((character) == '\\') || ((control) && ((character) < 32)))
+
+/* portable fallback, 8 bytes at a time */
+static size_t skip_plain_characters_swar(const unsigned char * const start, const size_t length, const cJSON_bool control)
+{
+    size_t i = 0;
+    cjson_uint64 word = 0;
+
+    for (; (i + 8) <= length; i += 8)
+    {
+        memcpy(&word, start + i, sizeof(word));
+        if (swar_has_byte(word, '\"') | swar_has_byte(word, '\\') | (control ? swar_has_less(word, 32) : 0))
+        {
+            break;
+        }
+    }
+    for (; (i < length) && !needs_attention(start[i], control); i++)
+    {
+    }
+
+    return i;
+}
+
+#ifdef CJSON_SSE2
+static size_t skip_plain_characters_sse2(const unsigned char * const start, const size_t length, const cJSON_bool control)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i last_control = _mm_set1_epi8(31);
+    size_t i = 0;
+
+    for (; (i + 16) <= length; i += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(start + i));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+        int mask = 0;
+        if (control)
+        {
+            /* unsigned chunk <= 31 */
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_max_epu8(chunk, last_control), last_control));
+        }
+        mask = _mm_movemask_epi8(special);
+        if (mask != 0)
+        {
+            return i + (size_t)__builtin_ctz((unsigned int)mask);
+        }
+    }
+
+    return i + skip_plain_characters_swar(start + i, length - i, control);
+}
+#endif
+
+#ifdef CJSON_AVX2
+__attribute__((target("avx2")))
+static size_t skip_plain_characters_avx2(const unsigned char * const start, const size_t length, const cJSON_bool control)
+{
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i last_control = _mm256_set1_epi8(31);
+    size_t i = 0;
+
+    for (; (i + 32) <= length; i += 32)
+    {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(start + i));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash));
+        unsigned int mask = 0;
+        if (control)
+        {
+            special = _mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, last_control), last_control));
+        }
+        mask = (unsigned int)_mm256_movemask_epi8(special);
+        if (mask != 0)
+        {
+            return i + (size_t)__builtin_ctz(mask);
+        }
+    }
+
+    return i + skip_plain_characters_sse2(start + i, length - i, control);
+}
+
+/* -1: not checked yet */
+static int cpu_has_avx2 = -1;
+#endif
+
+/* length of the prefix of start that can be copied as is */
+static size_t skip_plain_characters(const unsigned char * const start, const size_t length, const cJSON_bool control)
+{
+#ifdef CJSON_AVX2
+    if (length >= 64)
+    {
+        if (cpu_has_avx2 < 0)
+        {
+            cpu_has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+        }
+        if (cpu_has_avx2)
+        {
+            return skip_plain_characters_avx2(start, length, control);
+        }
+    }
+#endif
+#ifdef CJSON_SSE2
+    return skip_plain_characters_sse2(start, length, control);
+#else
+    return skip_plain_characters_swar(start, length, control);
+#endif
+}
+
+/* parse 4 digit hexadecimal number */
+static unsigned parse_hex4(const unsigned char * const input)
+{
+    unsigned int h = 0;
+    size_t i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        /* parse digit */
+        if ((input[i] >= '0') && (input[i] <= '9'))
+        {
+            h += (unsigned int) input[i] - '0';
+        }
+        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        {
+            h += (unsigned int) 10 + input[i] - 'A';
+        }
+        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        {
+            h += (unsigned int) 10 + input[i] - 'a';
+        }
+        else /* invalid */
+        {
+            return 0;
+        }
+
+        if (i < 3)
+        {
+            /* shift left to make place for the next nibble */
+            h = h << 4;
+        }
+    }
+
+    return h;
+}
+
+/* decodes a UTF-16 literal, one or two sequences of the form \uXXXX, into codepoint
+ * returns the length of the literal, 0 if it is invalid */
+static unsigned char utf16_literal_codepoint(const unsigned char * const input_pointer, const unsigned char * const input_end, long unsigned int * const codepoint)
+{
+    unsigned int first_code = 0;
+    const unsigned char *first_sequence = input_pointer;
+    unsigned char sequence_length = 0;
+
+    if ((input_end - first_sequence) < 6)
+    {
+        /* input ends unexpectedly */
+        goto fail;
+    }
+
+    /* get the first utf16 sequence */
+    first_code = parse_hex4(first_sequence + 2);
+
+    /* check that the code is valid */
+    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    {
+        goto fail;
+    }
+
+    /* UTF16 surrogate pair */
+    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+    {
+        const unsigned char *second_sequence = first_sequence + 6;
+        unsigned int second_code = 0;
+        sequence_length = 12; /* \uXXXX\uXXXX */
+
+        if ((input_end - second_sequence) < 6)
+        {
+            /* input ends unexpectedly */
+            goto fail;
+        }
+
+        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
+        {
+            /* missing second half of the surrogate pair */
+            goto fail;
+        }
+
+        /* get the second utf16 sequence */
+        second_code = parse_hex4(second_sequence + 2);
+        /* check that the code is valid */
+        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+        {
+            /* invalid second half of the surrogate pair */
+            goto fail;
+        }
+
+
+        /* calculate the unicode codepoint from the surrogate pair */
+        *codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+    }
+    else
+    {
+        sequence_length = 6; /* \uXXXX */
+        *codepoint = first_code;
+    }
+
+    return sequence_length;
+
+fail:
+    return 0;
+}
+
+/* converts a UTF-16 literal to UTF-8 */
+static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+{
+    long unsigned int codepoint = 0;
+    unsigned char utf8_length = 0;
+    unsigned char utf8_position = 0;
+    unsigned char sequence_length = 0;
+    unsigned char first_byte_mark = 0;
+
+    sequence_length = utf16_literal_codepoint(input_pointer, input_end, &codepoint);
+    if (sequence_length == 0)
+    {
+        goto fail;
+    }
+
+    /* encode as UTF-8
+     * takes at maximum 4 bytes to encode:
+     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
+    if (codepoint < 0x80)
+    {
+        /* normal ascii, encoding 0xxxxxxx */
+        utf8_length = 1;
+    }
+    else if (codepoint < 0x800)
+    {
+        /* two bytes, encoding 110xxxxx 10xxxxxx */
+        utf8_length = 2;
+        first_byte_mark = 0xC0; /* 11000000 */
+    }
+    else if (codepoint < 0x10000)
+    {
+        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 3;
+        first_byte_mark = 0xE0; /* 11100000 */
+    }
+    else if (codepoint <= 0x10FFFF)
+    {
+        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 4;
+        first_byte_mark = 0xF0; /* 11110000 */
+    }
+    else
+    {
+        /* invalid unicode codepoint */
+        goto fail;
+    }
+
+    /* encode as utf8 */
+    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+    {
+        /* 10xxxxxx */
+        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
+        codepoint >>= 6;
+    }
+    /* encode first byte */
+    if (utf8_length > 1)
+    {
+        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+    }
+    else
+    {
+        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+    }
+
+    *output_pointer += utf8_length;
+
+    return sequence_length;
+
+fail:
+    return 0;
+}
+
+static void* cast_away_const(const void* string);
+
+/* Parse the input text into an unescaped cinput, and populate item. */
+static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
+    unsigned char *output_pointer = NULL;
+    unsigned char *output = NULL;
+    cJSON_bool output_allocated = false; /* output is from the hooks, not the input, scratch memory or arena */
+
+    /* not a string, the error is at this character (only object keys get here) */
+    if (buffer_at_offset(input_buffer)[0] != '\"')
+    {
+        return false;
+    }
+
+    {
+        /* calculate approximate size of the output (overestimate) */
+        size_t allocation_length = 0;
+        size_t skipped_bytes = 0;
+        while ((size_t)(input_end - input_buffer->content) < input_buffer->length)
+        {
+            input_end += skip_plain_characters(input_end, input_buffer->length - (size_t)(input_end - input_buffer->content), false);
+            if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end == '\"'))
+            {
+                break;
+            }
+
+            /* is escape sequence */
+            if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
+            {
+                /* prevent buffer overflow when last input character is a backslash */
+                goto fail;
+            }
+            skipped_bytes++;
+            input_end += 2;
+        }
+        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
+        {
+            goto fail; /* string ended unexpectedly */
+        }
+
+        /* This is at most how much we need for the output */
+        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
+        if (input_buffer->in_situ)
+        {
+            /* decoded strings are never longer, the closing quote makes room for the terminator */
+            output = (unsigned char*)cast_away_const(input_pointer);
+        }
+        else if ((input_buffer->events != NULL) || input_buffer->scratch_string)
+        {
+            output = parse_scratch_allocate(input_buffer, allocation_length + sizeof(""));
+        }
+        else if (input_buffer->arena != NULL)
+        {
+            output = (unsigned char*)arena_allocate(input_buffer->arena, allocation_length + sizeof(""));
+        }
+        else
+        {
+            output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+            output_allocated = true;
+        }
+        if (output == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+    }
+
+    output_pointer = output;
+    /* loop through the string literal */
+    while (input_pointer < input_end)
+    {
+        /* copy everything up to the next escape sequence at once */
+        size_t plain_length = skip_plain_characters(input_pointer, (size_t)(input_end - input_pointer), false);
+        if (output_pointer != input_pointer)
+        {
+            /* overlaps when decoding in place */
+            memmove(output_pointer, input_pointer, plain_length);
+        }
+        input_pointer += plain_length;
+        output_pointer += plain_length;
+        if (input_pointer >= input_end)
+        {
+            break;
+        }
+
+        if (*input_pointer != '\\')
+        {
+            /* a quote that a malformed uXXXX escape ran into, it is copied like any other character */
+            *output_pointer++ = *input_pointer++;
+        }
+        /* escape sequence */
+        else
+        {
+            unsigned char sequence_length = 2;
+            if ((input_end - input_pointer) < 1)
+            {
+                goto fail;
+            }
+
+            switch (input_pointer[1])
+            {
+                case 'b':
+                    *output_pointer++ = '\b';
+                    break;
+                case 'f':
+                    *output_pointer++ = '\f';
+                    break;
+                case 'n':
+                    *output_pointer++ = '\n';
+                    break;
+                case 'r':
+                    *output_pointer++ = '\r';
+                    break;
+                case 't':
+                    *output_pointer++ = '\t';
+                    break;
+                case '\"':
+                case '\\':
+                case '/':
+                    *output_pointer++ = input_pointer[1];
+                    break;
+
+                /* UTF-16 literal */
+                case 'u':
+                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
+                    if (sequence_length == 0)
+                    {
+                        /* failed to convert UTF16-literal to UTF-8 */
+                        goto fail;
+                    }
+                    break;
+
+                default:
+                    goto fail;
+            }
+            input_pointer += sequence_length;
+        }
+    }
+
+    /* zero terminate the output */
+    *output_pointer = '\0';
+
+    item->type = cJSON_String;
+    item->valuestring = (char*)output;
+
+    input_buffer->offset = (size_t) (input_end - input_buffer->content);
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if ((output != NULL) && output_allocated)
+    {
+        input_buffer->hooks.deallocate(output);
+        output = NULL;
+    }
+
+    if (input_pointer != NULL)
+    {
+        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+    }
+
+    return false;
+}
+
+/* the number of additional characters needed to escape a string */
+static size_t count_escape_characters(const unsigned char *input, const unsigned char * const input_end)
+{
+    size_t escape_characters = 0;
+
+    /* jump from one candidate to the next */
+    for (; ; input++)
+    {
+        input += skip_plain_characters(input, (size_t)(input_end - input), true);
+        if (input >= input_end)
+        {
+            break;
+        }
+
+        switch (*input)
+        {
+            case '\"':
+            case '\\':
+            case '\b':
+            case '\f':
+            case '\n':
+            case '\r':
+            case '\t':
+                /* one character escape sequence */
+                escape_characters++;
+                break;
+            default:
+                /* UTF-16 escape sequence uXXXX */
+                escape_characters += 5;
+                break;
+        }
+    }
+
+    return escape_characters;
+}
+
+/* Render the cstring provided to an escaped version that can be printed. */
+static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+{
+    const unsigned char *input_pointer = NULL;
+    const unsigned char *input_end = NULL;
+    unsigned char *output = NULL;
+    unsigned char *output_pointer = NULL;
+    size_t output_length = 0;
+    size_t plain_length = 0;
+    /* numbers of additional characters needed for escaping */
+    size_t escape_characters = 0;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* empty string */
+    if (input == NULL)
+    {
+        output = ensure(output_buffer, sizeof("\"\""));
+        if (output == NULL)
+        {
+            return false;
+        }
+        strcpy((char*)output, "\"\"");
+
+        return true;
+    }
+
+    input_end = input + strlen((const char*)input);
+    escape_characters = count_escape_characters(input, input_end);
+    output_length = (size_t)(input_end - input) + escape_characters;
+
+    output = ensure(output_buffer, output_length + sizeof("\"\""));
+    if (output == NULL)
+    {
+        return false;
+    }
+
+    /* no characters have to be escaped */
+    if (escape_characters == 0)
+    {
+        output[0] = '\"';
+        memcpy(output + 1, input, output_length);
+        output[output_length + 1] = '\"';
+        output[output_length + 2] = '\0';
+
+        return true;
+    }
+
+    output[0] = '\"';
+    output_pointer = output + 1;
+    /* copy the string */
+    for (input_pointer = input; input_pointer < input_end; (void)input_pointer++, output_pointer++)
+    {
+        /* normal characters, copy in bulk */
+        plain_length = skip_plain_characters(input_pointer, (size_t)(input_end - input_pointer), true);
+        memcpy(output_pointer, input_pointer, plain_length);
+        input_pointer += plain_length;
+        output_pointer += plain_length;
+        if (input_pointer >= input_end)
+        {
+            break;
+        }
+
+        /* character needs to be escaped */
+        *output_pointer++ = '\\';
+        switch (*input_pointer)
+        {
+            case '\\':
+                *output_pointer = '\\';
+                break;
+            case '\"':
+                *output_pointer = '\"';
+                break;
+            case '\b':
+                *output_pointer = 'b';
+                break;
+            case '\f':
+                *output_pointer = 'f';
+                break;
+            case '\n':
+                *output_pointer = 'n';
+                break;
+            case '\r':
+                *output_pointer = 'r';
+                break;
+            case '\t':
+                *output_pointer = 't';
+                break;
+            default:
+                /* escape and print as unicode codepoint */
+                sprintf((char*)output_pointer, "u%04x", *input_pointer);
+                output_pointer += 4;
+                break;
+        }
+    }
+    output[output_length + 1] = '\"';
+    output[output_length + 2] = '\0';
+
+    return true;
+}
+
+/* Invoke print_string_ptr (which is useful) on an item. */
+static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+{
+    return print_string_ptr((unsigned char*)item->valuestring, p);
+}
+
+/* Nested arrays and objects are walked with a stack of frames, the first ones are kept on the C stack. */
+#define INLINE_STACK_FRAMES 32
+
+/* double the capacity of a stack of frames; the old frames are freed unless they are inline_frames */
+static void *grow_stack(void * const frames, size_t * const capacity, const size_t frame_size, const void * const inline_frames, const internal_hooks * const hooks)
+{
+    void *grown = NULL;
+
+    if (*capacity > (((size_t)-1) / 2 / frame_size))
+    {
+        return NULL; /* overflow */
+    }
+
+    grown = hooks->allocate(*capacity * 2 * frame_size);
+    if (grown == NULL)
+    {
+        return NULL;
+    }
+    memcpy(grown, frames, *capacity * frame_size);
+    if (frames != inline_frames)
+    {
+        hooks->deallocate(frames);
+    }
+    *capacity *= 2;
+
+    return grown;
+}
+
+/* an array or object that is being printed, and the member to print next */
+typedef struct
+{
+    const cJSON *container;
+    const cJSON *current;
+} print_frame;
+
+/* Predeclare these prototypes. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_container(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_container(const cJSON * const item, printbuffer * const output_buffer);
+
+/* Utility to jump whitespace and cr/lf */
+static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL))
+    {
+        return NULL;
+    }
+
+    if (cannot_access_at_index(buffer, 0))
+    {
+        return buffer;
+    }
+
+    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    {
+       buffer->offset++;
+    }
+
+    if (buffer->offset == buffer->length)
+    {
+        buffer->offset--;
+    }
+
+    return buffer;
+}
+
+/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
+static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+    {
+        return NULL;
+    }
+
+    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    {
+        buffer->offset += 3;
+    }
+
+    return buffer;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    size_t buffer_length;
+
+    if (NULL == value)
+    {
+        return NULL;
+    }
+
+    /* Adding null character size due to require_null_terminated. */
+    buffer_length = strlen(value) + sizeof("");
+
+    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
+}
+
+/* Parse an object - create a new root, and populate. */
+/* parse a whole document, buffer is zero initialized apart from the arena and events members */
+static cJSON *parse_document(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, parse_buffer * const buffer)
+{
+    cJSON *item = NULL;
+
+    /* reset error position */
+    if (buffer->context != NULL)
+    {
+        buffer->context->error = NULL;
+        buffer->context->error_offset = 0;
+        set_hooks(&buffer->hooks, &buffer->context->hooks);
+    }
+    else
+    {
+        global_error.json = NULL;
+        global_error.position = 0;
+        buffer->hooks = global_hooks;
+    }
+
+    if (value == NULL || 0 == buffer_length)
+    {
+        goto fail;
+    }
+    if ((buffer->context != NULL) && (buffer->context->length_limit != 0) && (buffer_length > buffer->context->length_limit))
+    {
+        goto fail;
+    }
+
+    buffer->content = (const unsigned char*)value;
+    buffer->length = buffer_length;
+    buffer->offset = 0;
+
+    item = parse_new_item(buffer);
+    if (item == NULL) /* memory fail */
+    {
+        goto fail;
+    }
+
+    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(buffer))))
+    {
+        /* parse failure. ep is set. */
+        goto fail;
+    }
+    if (!parse_finish_item(item, buffer))
+    {
+        goto fail;
+    }
+
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (require_null_terminated)
+    {
+        buffer_skip_whitespace(buffer);
+        if ((buffer->offset >= buffer->length) || buffer_at_offset(buffer)[0] != '\0')
+        {
+            goto fail;
+        }
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(buffer);
+    }
+
+    return item;
+
+fail:
+    if ((item != NULL) && (buffer->arena == NULL) && (buffer->events == NULL))
+    {
+        delete_item(item, &buffer->hooks);
+    }
+
+    if (value != NULL)
+    {
+        error local_error;
+        local_error.json = (const unsigned char*)value;
+        local_error.position = 0;
+
+        if (buffer->offset < buffer->length)
+        {
+            local_error.position = buffer->offset;
+        }
+        else if (buffer->length > 0)
+        {
+            local_error.position = buffer->length - 1;
+        }
+
+        if (return_parse_end != NULL)
+        {
+            *return_parse_end = (const char*)local_error.json + local_error.position;
+        }
+
+        if (buffer->context != NULL)
+        {
+            buffer->context->error = (const char*)local_error.json + local_error.position;
+            buffer->context->error_offset = local_error.position;
+        }
+        else
+        {
+            global_error = local_error;
+        }
+    }
+
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+
+    return parse_document(value, buffer_length, return_parse_end, require_null_terminated, &buffer);
+}
+
+CJSON_PUBLIC(void) cJSON_InitContext(cJSON_Context *context)
+{
+    if (context != NULL)
+    {
+        memset(context, '\0', sizeof(cJSON_Context));
+    }
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseCtx(const char *value, size_t buffer_length, cJSON_Context *context)
+{
+    parse_buffer buffer;
+
+    if (context == NULL)
+    {
+        return NULL;
+    }
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.context = context;
+    buffer.arena = context->arena;
+    context->end = NULL;
+
+    return parse_document(value, buffer_length, &context->end, context->require_null_terminated, &buffer);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithArena(const char *value, size_t buffer_length, cJSON_Arena *arena)
+{
+    return cJSON_ParseWithArenaOpts(value, buffer_length, NULL, false, arena);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithArenaOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, cJSON_Arena *arena)
+{
+    parse_buffer buffer;
+
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.arena = arena;
+
+    return parse_document(value, buffer_length, return_parse_end, require_null_terminated, &buffer);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value, size_t buffer_length, cJSON_Arena *arena)
+{
+    parse_buffer buffer;
+
+    if (value == NULL)
+    {
+        return NULL;
+    }
+    if ((arena == NULL) || !arena_adopt(arena, value))
+    {
+        /* the buffer is owned by the document even if there is none */
+        global_hooks.deallocate(value);
+        return NULL;
+    }
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.arena = arena;
+    buffer.in_situ = true;
+
+    return parse_document(value, buffer_length, NULL, false, &buffer);
+}
+
+/* parse the contents of a file, in situ if the context has an arena (which has to own them already) */
+static cJSON *parse_file_contents(char * const content, const size_t length, cJSON_Context * const context)
+{
+    parse_buffer buffer;
+    const char *end = NULL;
+    cJSON *item = NULL;
+
+    memset(&buffer, '\0', sizeof(buffer));
+    if (context != NULL)
+    {
+        buffer.context = context;
+        buffer.arena = context->arena;
+        buffer.in_situ = (context->arena != NULL);
+    }
+
+    item = parse_document(content, length, &end, false, &buffer);
+    if ((item != NULL) && (context != NULL) && context->require_null_terminated)
+    {
+        /* nothing but whitespace may follow the value */
+        while ((buffer.offset < length) && ((unsigned char)content[buffer.offset] <= 32))
+        {
+            buffer.offset++;
+        }
+        if (buffer.offset < length)
+        {
+            if (buffer.arena == NULL)
+            {
+                delete_item(item, &buffer.hooks);
+            }
+            item = NULL;
+            end = content + buffer.offset;
+            context->error = end;
+            context->error_offset = buffer.offset;
+        }
+    }
+    if (context != NULL)
+    {
+        context->end = end;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseFile(const char *path, cJSON_Context *context)
+{
+    cJSON_Arena *arena = (context != NULL) ? context->arena : NULL;
+    cJSON *item = NULL;
+#ifdef CJSON_POSIX
+    struct stat status;
+    void *content = NULL;
+    size_t length = 0;
+    int file = -1;
+#else
+    FILE *file = NULL;
+    char *content = NULL;
+    size_t length = 0;
+    size_t size = 64 * 1024;
+#endif
+
+    if (context != NULL)
+    {
+        context->end = NULL;
+        context->error = NULL;
+        context->error_offset = 0;
+    }
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+#ifdef CJSON_POSIX
+    file = open(path, O_RDONLY);
+    if (file < 0)
+    {
+        return NULL;
+    }
+    if ((fstat(file, &status) != 0) || (status.st_size <= 0) || ((off_t)(size_t)status.st_size != status.st_size))
+    {
+        close(file);
+        return NULL;
+    }
+    length = (size_t)status.st_size;
+
+    /* decoding in situ writes to private copies of the pages it touches */
+    content = mmap(NULL, length, (arena != NULL) ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (content == MAP_FAILED)
+    {
+        return NULL;
+    }
+    (void)posix_madvise(content, length, POSIX_MADV_SEQUENTIAL);
+
+    if (arena != NULL)
+    {
+        if (!arena_adopt(arena, content))
+        {
+            munmap(content, length);
+            return NULL;
+        }
+        arena->adopted->mapped = length;
+        return parse_file_contents((char*)content, length, context);
+    }
+
+    item = parse_file_contents((char*)content, length, context);
+    munmap(content, length);
+#else
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    /* read the whole file, growing the buffer as needed */
+    content = (char*)global_hooks.allocate(size);
+    while (content != NULL)
+    {
+        char *new_content = NULL;
+
+        length += fread(content + length, 1, size - length, file);
+        if (length < size)
+        {
+            break;
+        }
+        new_content = (char*)global_hooks.allocate(size * 2);
+        if (new_content != NULL)
+        {
+            memcpy(new_content, content, length);
+        }
+        global_hooks.deallocate(content);
+        content = new_content;
+        size *= 2;
+    }
+    if ((content != NULL) && ferror(file))
+    {
+        global_hooks.deallocate(content);
+        content = NULL;
+    }
+    fclose(file);
+    if (content == NULL)
+    {
+        return NULL;
+    }
+
+    if (arena != NULL)
+    {
+        if (!arena_adopt(arena, content))
+        {
+            global_hooks.deallocate(content);
+            return NULL;
+        }
+        return parse_file_contents(content, length, context);
+    }
+
+    item = parse_file_contents(content, length, context);
+    global_hooks.deallocate(content);
+#endif
+
+    /* positions in the released contents would be left dangling */
+    if (context != NULL)
+    {
+        context->end = NULL;
+        context->error = NULL;
+    }
+    else
+    {
+        global_error.json = NULL;
+        global_error.position = 0;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithKeyPool(const char *value, size_t buffer_length, cJSON_KeyPool *pool)
+{
+    parse_buffer buffer;
+    cJSON_KeyPool *document_pool = NULL;
+    cJSON *item = NULL;
+
+    if (pool == NULL)
+    {
+        /* share keys within this document only */
+        document_pool = pool = cJSON_KeyPoolNew();
+        if (pool == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.keys = pool;
+
+    item = parse_document(value, buffer_length, NULL, false, &buffer);
+    if (buffer.scratch != NULL)
+    {
+        buffer.hooks.deallocate(buffer.scratch);
+    }
+    cJSON_KeyPoolFree(document_pool);
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseEvents(const char *value, size_t buffer_length, const cJSON_EventHandler *handler, void *context)
+{
+    parse_buffer buffer;
+    cJSON_bool success = false;
+
+    if (handler == NULL)
+    {
+        return false;
+    }
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.events = handler;
+    buffer.events_context = context;
+
+    success = (parse_document(value, buffer_length, NULL, false, &buffer) != NULL);
+    if (buffer.scratch != NULL)
+    {
+        buffer.hooks.deallocate(buffer.scratch);
+    }
+
+    return success;
+}
+
+/* Push parser: the document arrives in chunks and the parser state survives between them.
+ * Containers and punctuation are handled by a small state machine, scalars are collected as
+ * text tokens (across chunk boundaries) and parsed with parse_value once complete. */
+typedef enum
+{
+    stream_value, /* a value has to follow */
+    stream_value_or_end, /* after '[' */
+    stream_key, /* after ',' in an object */
+    stream_key_or_end, /* after '{' */
+    stream_colon,
+    stream_next, /* after a value in a container: ',' or the end of it */
+    stream_string, /* inside a string token */
+    stream_scalar, /* inside a number or literal token */
+    stream_done, /* only whitespace may follow */
+    stream_error
+} stream_state;
+
+static cJSON_bool add_item_to_array(cJSON *array, cJSON *item);
+
+typedef struct
+{
+    cJSON *node; /* NULL in event mode */
+    unsigned char type; /* '[' or '{' */
+} stream_frame;
+
+struct cJSON_StreamParser
+{
+    const cJSON_EventHandler *events; /* NULL to build a tree */
+    void *events_context;
+    internal_hooks hooks;
+    stream_state state;
+    size_t position; /* of the next byte in the whole stream */
+    size_t error_position;
+    stream_frame *stack;
+    size_t depth;
+    size_t stack_size;
+    cJSON *root;
+    char *key; /* tree mode: the key waiting for its value */
+    unsigned char *token;
+    size_t token_length;
+    size_t token_size;
+    size_t token_start; /* position of the first byte of the token */
+    size_t token_error; /* offset in the token where parsing it stopped */
+    cJSON_bool token_is_key;
+    cJSON_bool escaped; /* the last byte of the string token was a backslash */
+    size_t bom_matched;
+};
+
+CJSON_PUBLIC(cJSON_StreamParser *) cJSON_StreamParserNew(const cJSON_EventHandler *handler, void *context)
+{
+    cJSON_StreamParser *parser = (cJSON_StreamParser*)global_hooks.allocate(sizeof(cJSON_StreamParser));
+    if (parser == NULL)
+    {
+        return NULL;
+    }
+
+    memset(parser, '\0', sizeof(cJSON_StreamParser));
+    parser->events = handler;
+    parser->events_context = context;
+    parser->hooks = global_hooks;
+    parser->state = stream_value;
+
+    return parser;
+}
+
+CJSON_PUBLIC(void) cJSON_StreamParserDelete(cJSON_StreamParser *parser)
+{
+    if (parser == NULL)
+    {
+        return;
+    }
+
+    cJSON_Delete(parser->root);
+    if (parser->key != NULL)
+    {
+        parser->hooks.deallocate(parser->key);
+    }
+    if (parser->token != NULL)
+    {
+        parser->hooks.deallocate(parser->token);
+    }
+    if (parser->stack != NULL)
+    {
+        parser->hooks.deallocate(parser->stack);
+    }
+    parser->hooks.deallocate(parser);
+}
+
+static cJSON_bool stream_fail(cJSON_StreamParser * const parser)
+{
+    parser->state = stream_error;
+    parser->error_position = parser->position;
+
+    return false;
+}
+
+/* the error of a token is where the parser stopped in it, as cJSON_ParseCtx reports it */
+static cJSON_bool stream_token_fail(cJSON_StreamParser * const parser)
+{
+    parser->state = stream_error;
+    parser->error_position = parser->token_start + parser->token_error;
+
+    return false;
+}
+
+static cJSON_bool stream_append_token(cJSON_StreamParser * const parser, const unsigned char * const bytes, const size_t length)
+{
+    if ((parser->token_size - parser->token_length) < (length + 1))
+    {
+        size_t new_size = (parser->token_size == 0) ? 64 : parser->token_size;
+        unsigned char *new_token = NULL;
+
+        while ((new_size - parser->token_length) < (length + 1))
+        {
+            new_size *= 2;
+        }
+        new_token = (unsigned char*)parser->hooks.allocate(new_size);
+        if (new_token == NULL)
+        {
+            return false;
+        }
+        if (parser->token != NULL)
+        {
+            memcpy(new_token, parser->token, parser->token_length);
+            parser->hooks.deallocate(parser->token);
+        }
+        parser->token = new_token;
+        parser->token_size = new_size;
+    }
+
+    memcpy(parser->token + parser->token_length, bytes, length);
+    parser->token_length += length;
+    parser->token[parser->token_length] = '\0';
+
+    return true;
+}
+
+/* a value is complete, what is expected next depends on the container around it */
+static void stream_after_value(cJSON_StreamParser * const parser)
+{
+    parser->state = (parser->depth == 0) ? stream_done : stream_next;
+}
+
+/* hand a parsed scalar (or a new container in tree mode) to its parent, item is consumed */
+static cJSON_bool stream_attach(cJSON_StreamParser * const parser, cJSON * const item)
+{
+    if (parser->depth == 0)
+    {
+        parser->root = item;
+        return true;
+    }
+
+    item->string = parser->key;
+    parser->key = NULL;
+
+    return add_item_to_array(parser->stack[parser->depth - 1].node, item);
+}
+
+/* parse the collected token as key or scalar value */
+static cJSON_bool stream_finish_token(cJSON_StreamParser * const parser)
+{
+    parse_buffer buffer;
+    cJSON scratch;
+    cJSON *item = NULL;
+    cJSON_bool success = false;
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.content = parser->token;
+    buffer.length = parser->token_length;
+    buffer.hooks = parser->hooks;
+    parser->token_error = 0;
+
+    if ((parser->events != NULL) || parser->token_is_key)
+    {
+        memset(&scratch, '\0', sizeof(cJSON));
+        item = &scratch;
+    }
+    else
+    {
+        item = cJSON_New_Item(&parser->hooks);
+        if (item == NULL)
+        {
+            return false;
+        }
+    }
+
+    /* the whole token has to be a single value */
+    if (parser->token_is_key)
+    {
+        success = parse_string(item, &buffer) && (buffer.offset == buffer.length);
+    }
+    else
+    {
+        success = parse_value(item, &buffer) && (buffer.offset == buffer.length);
+    }
+    if (!success)
+    {
+        parser->token_error = (buffer.offset < buffer.length) ? buffer.offset : (buffer.length - 1);
+    }
+    parser->token_length = 0;
+
+    if (success && parser->token_is_key)
+    {
+        if (parser->events != NULL)
+        {
+            success = (parser->events->key == NULL) || parser->events->key(parser->events_context, item->valuestring);
+        }
+        else
+        {
+            parser->key = item->valuestring;
+            item->valuestring = NULL;
+        }
+    }
+    else if (success && (parser->events != NULL))
+    {
+        success = (parser->events->value == NULL) || parser->events->value(parser->events_context, item);
+    }
+    else if (success)
+    {
+        success = stream_attach(parser, item);
+        item = NULL;
+    }
+
+    if (item == &scratch)
+    {
+        if (scratch.valuestring != NULL)
+        {
+            parser->hooks.deallocate(scratch.valuestring);
+        }
+    }
+    else if (item != NULL)
+    {
+        cJSON_Delete(item);
+    }
+
+    return success;
+}
+
+static cJSON_bool stream_open(cJSON_StreamParser * const parser, const unsigned char type)
+{
+    cJSON *node = NULL;
+
+    if (parser->depth >= CJSON_NESTING_LIMIT)
+    {
+        return false;
+    }
+    if (parser->depth == parser->stack_size)
+    {
+        size_t new_size = (parser->stack_size == 0) ? 16 : (parser->stack_size * 2);
+        stream_frame *new_stack = (stream_frame*)parser->hooks.allocate(new_size * sizeof(stream_frame));
+        if (new_stack == NULL)
+        {
+            return false;
+        }
+        if (parser->stack != NULL)
+        {
+            memcpy(new_stack, parser->stack, parser->depth * sizeof(stream_frame));
+            parser->hooks.deallocate(parser->stack);
+        }
+        parser->stack = new_stack;
+        parser->stack_size = new_size;
+    }
+
+    if (parser->events != NULL)
+    {
+        cJSON_bool (*start)(void *context) = (type == '[') ? parser->events->start_array : parser->events->start_object;
+        if ((start != NULL) && !start(parser->events_context))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        node = cJSON_New_Item(&parser->hooks);
+        if (node == NULL)
+        {
+            return false;
+        }
+        node->type = (type == '[') ? cJSON_Array : cJSON_Object;
+        if (!stream_attach(parser, node))
+        {
+            cJSON_Delete(node);
+            return false;
+        }
+    }
+
+    parser->stack[parser->depth].node = node;
+    parser->stack[parser->depth].type = type;
+    parser->depth++;
+    parser->state = (type == '[') ? stream_value_or_end : stream_key_or_end;
+
+    return true;
+}
+
+static cJSON_bool stream_close(cJSON_StreamParser * const parser, const unsigned char closing)
+{
+    if ((parser->depth == 0) || (parser->stack[parser->depth - 1].type != ((closing == ']') ? '[' : '{')))
+    {
+        return false;
+    }
+    if (parser->events != NULL)
+    {
+        cJSON_bool (*end)(void *context) = (closing == ']') ? parser->events->end_array : parser->events->end_object;
+        if ((end != NULL) && !end(parser->events_context))
+        {
+            return false;
+        }
+    }
+
+    parser->depth--;
+    stream_after_value(parser);
+
+    return true;
+}
+
+/* feed a single byte that doesn't continue a token */
+static cJSON_bool stream_structural(cJSON_StreamParser * const parser, const unsigned char character)
+{
+    if (character <= 32)
+    {
+        return true; /* whitespace */
+    }
+
+    switch (parser->state)
+    {
+        case stream_value_or_end:
+            if (character == ']')
+            {
+                return stream_close(parser, character);
+            }
+            /* fall through */
+        case stream_value:
+            if ((character == '[') || (character == '{'))
+            {
+                return stream_open(parser, character);
+            }
+            if ((character == ']') || (character == '}') || (character == ',') || (character == ':'))
+            {
+                return false;
+            }
+            parser->token_is_key = false;
+            parser->escaped = false;
+            parser->token_start = parser->position;
+            parser->state = (character == '\"') ? stream_string : stream_scalar;
+            return stream_append_token(parser, &character, 1);
+
+        case stream_key_or_end:
+            if (character == '}')
+            {
+                return stream_close(parser, character);
+            }
+            /* fall through */
+        case stream_key:
+            if (character != '\"')
+            {
+                return false;
+            }
+            parser->token_is_key = true;
+            parser->escaped = false;
+            parser->token_start = parser->position;
+            parser->state = stream_string;
+            return stream_append_token(parser, &character, 1);
+
+        case stream_colon:
+            if (character != ':')
+            {
+                return false;
+            }
+            parser->state = stream_value;
+            return true;
+
+        case stream_next:
+            if (character == ',')
+            {
+                parser->state = (parser->stack[parser->depth - 1].type == '[') ? stream_value : stream_key;
+                return true;
+            }
+            if ((character == ']') || (character == '}'))
+            {
+                return stream_close(parser, character);
+            }
+            return false;
+
+        default:
+            /* anything after the document */
+            return false;
+    }
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_StreamParserFeed(cJSON_StreamParser *parser, const char *chunk, size_t length)
+{
+    const unsigned char *input = (const unsigned char*)chunk;
+    const unsigned char * const input_end = input + length;
+    static const unsigned char bom[] = { 0xEF, 0xBB, 0xBF };
+
+    if ((parser == NULL) || ((chunk == NULL) && (length > 0)) || (parser->state == stream_error))
+    {
+        return false;
+    }
+
+    /* the UTF-8 BOM, which may be split as well */
+    while ((input < input_end) && (parser->position == parser->bom_matched) && (parser->bom_matched < sizeof(bom)) && (*input == bom[parser->bom_matched]))
+    {
+        parser->bom_matched++;
+        parser->position++;
+        input++;
+    }
+    if ((parser->bom_matched > 0) && (parser->bom_matched < sizeof(bom)) && (input < input_end))
+    {
+        return stream_fail(parser);
+    }
+
+    while (input < input_end)
+    {
+        if (parser->state == stream_string)
+        {
+            /* copy up to the next quote or backslash at once */
+            size_t run = parser->escaped ? 0 : skip_plain_characters(input, (size_t)(input_end - input), false);
+            cJSON_bool closed = false;
+
+            if ((run == (size_t)(input_end - input)) || parser->escaped || (input[run] == '\\'))
+            {
+                /* the character after a backslash never ends the string */
+                if (run < (size_t)(input_end - input))
+                {
+                    parser->escaped = parser->escaped ? false : true;
+                    run++;
+                }
+            }
+            else
+            {
+                /* closing quote */
+                run++;
+                closed = true;
+            }
+
+            if (!stream_append_token(parser, input, run))
+            {
+                return stream_fail(parser);
+            }
+            parser->position += run;
+            input += run;
+
+            if (closed)
+            {
+                if (!stream_finish_token(parser))
+                {
+                    return stream_token_fail(parser);
+                }
+                if (parser->token_is_key)
+                {
+                    parser->state = stream_colon;
+                }
+                else
+                {
+                    stream_after_value(parser);
+                }
+            }
+            continue;
+        }
+
+        if (parser->state == stream_scalar)
+        {
+            /* numbers and literals end at whitespace or punctuation */
+            const unsigned char *end = input;
+            while ((end < input_end) && (*end > 32) && (*end != ',') && (*end != ']') && (*end != '}') && (*end != ':') && (*end != '\"') && (*end != '[') && (*end != '{'))
+            {
+                end++;
+            }
+            if (!stream_append_token(parser, input, (size_t)(end - input)))
+            {
+                return stream_fail(parser);
+            }
+            parser->position += (size_t)(end - input);
+            input = end;
+            if (input == input_end)
+            {
+                break; /* may continue in the next chunk */
+            }
+            if (!stream_finish_token(parser))
+            {
+                return stream_token_fail(parser);
+            }
+            stream_after_value(parser);
+            /* the terminating byte is handled below */
+        }
+
+        if (!stream_structural(parser, *input))
+        {
+            return stream_fail(parser);
+        }
+        parser->position++;
+        input++;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_StreamParserFinish(cJSON_StreamParser *parser, cJSON **root)
+{
+    if (root != NULL)
+    {
+        *root = NULL;
+    }
+    if ((parser == NULL) || (parser->state == stream_error))
+    {
+        return false;
+    }
+
+    /* a number or literal at the end of the input is only complete now */
+    if (parser->state == stream_scalar)
+    {
+        if (!stream_finish_token(parser))
+        {
+            return stream_token_fail(parser);
+        }
+        stream_after_value(parser);
+    }
+    if (parser->state != stream_done)
+    {
+        /* incomplete document */
+        return stream_fail(parser);
+    }
+
+    if (root != NULL)
+    {
+        *root = parser->root;
+        parser->root = NULL;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(size_t) cJSON_StreamParserGetErrorOffset(const cJSON_StreamParser *parser)
+{
+    if ((parser == NULL) || (parser->state != stream_error))
+    {
+        return 0;
+    }
+
+    return parser->error_position;
+}
+
+/* Lazy parsing: a first pass only checks the structure and records where every value (and key) starts
+ * in a tape, in document order. Containers know where their children end, so accessors can jump over
+ * whole subtrees. Values are decoded with the normal parser when they are accessed. */
+typedef struct
+{
+    size_t offset; /* of the first character of the value in the input */
+    size_t end; /* tape index after the value and all of its children */
+} lazy_entry;
+
+struct cJSON_Lazy
+{
+    const unsigned char *content;
+    size_t length;
+    lazy_entry *tape;
+    size_t count;
+    size_t size;
+    internal_hooks hooks;
+};
+
+#define lazy_is_delimiter(character) (((character) <= 32) || ((character) == ',') || ((character) == ']') || ((character) == '}'))
+
+static cJSON_bool lazy_add_entry(cJSON_Lazy * const document, const size_t offset, size_t * const index)
+{
+    if (document->count == document->size)
+    {
+        size_t new_size = document->size * 2;
+        lazy_entry *new_tape = NULL;
+
+        if (new_size > (((size_t)-1) / sizeof(lazy_entry)))
+        {
+            return false;
+        }
+        new_tape = (lazy_entry*)document->hooks.allocate(new_size * sizeof(lazy_entry));
+        if (new_tape == NULL)
+        {
+            return false;
+        }
+        memcpy(new_tape, document->tape, document->count * sizeof(lazy_entry));
+        document->hooks.deallocate(document->tape);
+        document->tape = new_tape;
+        document->size = new_size;
+    }
+
+    document->tape[document->count].offset = offset;
+    document->tape[document->count].end = document->count + 1;
+    if (index != NULL)
+    {
+        *index = document->count;
+    }
+    document->count++;
+
+    return true;
+}
+
+/* skip a string, quotes included, without decoding it */
+static cJSON_bool lazy_skip_string(parse_buffer * const buffer)
+{
+    const unsigned char *input = buffer_at_offset(buffer) + 1;
+    const unsigned char * const end = buffer->content + buffer->length;
+
+    while (input < end)
+    {
+        input += skip_plain_characters(input, (size_t)(end - input), false);
+        if (input >= end)
+        {
+            break;
+        }
+        if (*input == '\"')
+        {
+            buffer->offset = (size_t)(input - buffer->content) + 1;
+            return true;
+        }
+        /* backslash, the escape sequence is checked when the string is decoded */
+        input += 2;
+    }
+
+    return false;
+}
+
+static cJSON_bool lazy_scan_value(cJSON_Lazy * const document, parse_buffer * const buffer);
+
+/* check the structure of a value and record it and its children in the tape */
+static cJSON_bool lazy_scan_value(cJSON_Lazy * const document, parse_buffer * const buffer)
+{
+    size_t entry = 0;
+    unsigned char opening = 0;
+    unsigned char closing = 0;
+
+    buffer_skip_whitespace(buffer);
+    if (!can_read(buffer, 1))
+    {
+        return false;
+    }
+    if (!lazy_add_entry(document, buffer->offset, &entry))
+    {
+        return false;
+    }
+
+    opening = *buffer_at_offset(buffer);
+    switch (opening)
+    {
+        case '\"':
+            return lazy_skip_string(buffer);
+
+        case '[':
+            closing = ']';
+            break;
+
+        case '{':
+            closing = '}';
+            break;
+
+        case 't':
+        case 'f':
+        case 'n':
+        {
+            const char *literal = (opening == 't') ? "true" : ((opening == 'f') ? "false" : "null");
+            size_t literal_length = strlen(literal);
+            if (!can_read(buffer, literal_length) || (strncmp((const char*)buffer_at_offset(buffer), literal, literal_length) != 0))
+            {
+                return false;
+            }
+            buffer->offset += literal_length;
+            return !can_access_at_index(buffer, 0) || lazy_is_delimiter(*buffer_at_offset(buffer));
+        }
+
+        default:
+            /* numbers are only checked roughly here, fully when they are decoded */
+            if ((opening != '-') && ((opening < '0') || (opening > '9')))
+            {
+                return false;
+            }
+            while (can_access_at_index(buffer, 0) && !lazy_is_delimiter(*buffer_at_offset(buffer)))
+            {
+                unsigned char character = *buffer_at_offset(buffer);
+                if (((character < '0') || (character > '9')) && (character != '-') && (character != '+') && (character != '.') && (character != 'e') && (character != 'E'))
+                {
+                    return false;
+                }
+                buffer->offset++;
+            }
+            return true;
+    }
+
+    if (buffer->depth >= CJSON_NESTING_LIMIT)
+    {
+        return false;
+    }
+    buffer->depth++;
+    buffer->offset++;
+    buffer_skip_whitespace(buffer);
+
+    if (can_access_at_index(buffer, 0) && (*buffer_at_offset(buffer) == closing))
+    {
+        /* empty container */
+        buffer->offset++;
+    }
+    else
+    {
+        for (;;)
+        {
+            if (closing == '}')
+            {
+                buffer_skip_whitespace(buffer);
+                if (!can_access_at_index(buffer, 0) || (*buffer_at_offset(buffer) != '\"') || !lazy_add_entry(document, buffer->offset, NULL) || !lazy_skip_string(buffer))
+                {
+                    return false;
+                }
+                buffer_skip_whitespace(buffer);
+                if (!can_access_at_index(buffer, 0) || (*buffer_at_offset(buffer) != ':'))
+                {
+                    return false;
+                }
+                buffer->offset++;
+            }
+            if (!lazy_scan_value(document, buffer))
+            {
+                return false;
+            }
+            buffer_skip_whitespace(buffer);
+            if (!can_access_at_index(buffer, 0))
+            {
+                return false;
+            }
+            if (*buffer_at_offset(buffer) == closing)
+            {
+                buffer->offset++;
+                break;
+            }
+            if (*buffer_at_offset(buffer) != ',')
+            {
+                return false;
+            }
+            buffer->offset++;
+        }
+    }
+
+    buffer->depth--;
+    document->tape[entry].end = document->count;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_Lazy *) cJSON_ParseLazy(const char *value, size_t buffer_length)
+{
+    cJSON_Lazy *document = NULL;
+    parse_buffer buffer;
+
+    if ((value == NULL) || (buffer_length == 0))
+    {
+        return NULL;
+    }
+
+    document = (cJSON_Lazy*)global_hooks.allocate(sizeof(cJSON_Lazy));
+    if (document == NULL)
+    {
+        return NULL;
+    }
+    memset(document, '\0', sizeof(cJSON_Lazy));
+    document->content = (const unsigned char*)value;
+    document->length = buffer_length;
+    document->hooks = global_hooks;
+    /* rough guess, grows as needed */
+    document->size = (buffer_length / 16) + 16;
+    document->tape = (lazy_entry*)document->hooks.allocate(document->size * sizeof(lazy_entry));
+    if (document->tape == NULL)
+    {
+        goto fail;
+    }
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.content = document->content;
+    buffer.length = buffer_length;
+    buffer.hooks = global_hooks;
+
+    if (!lazy_scan_value(document, skip_utf8_bom(&buffer)))
+    {
+        goto fail;
+    }
+    /* only whitespace (or the null terminator) may follow */
+    buffer_skip_whitespace(&buffer);
+    if (can_access_at_index(&buffer, 0) && (*buffer_at_offset(&buffer) > 32))
+    {
+        goto fail;
+    }
+
+    return document;
+
+fail:
+    cJSON_LazyDelete(document);
+
+    return NULL;
+}
+
+CJSON_PUBLIC(void) cJSON_LazyDelete(cJSON_Lazy *document)
+{
+    if (document == NULL)
+    {
+        return;
+    }
+
+    if (document->tape != NULL)
+    {
+        document->hooks.deallocate(document->tape);
+    }
+    document->hooks.deallocate(document);
+}
+
+static cJSON_Cursor lazy_cursor(const cJSON_Lazy * const document, const size_t index)
+{
+    cJSON_Cursor cursor;
+
+    cursor.document = document;
+    cursor.index = index;
+
+    return cursor;
+}
+
+static const cJSON_Cursor invalid_cursor = { NULL, 0 };
+
+CJSON_PUBLIC(cJSON_Cursor) cJSON_LazyGetRoot(const cJSON_Lazy *document)
+{
+    if (document == NULL)
+    {
+        return invalid_cursor;
+    }
+
+    return lazy_cursor(document, 0);
+}
+
+static unsigned char lazy_first_character(const cJSON_Cursor cursor)
+{
+    if ((cursor.document == NULL) || (cursor.index >= cursor.document->count))
+    {
+        return '\0';
+    }
+
+    return cursor.document->content[cursor.document->tape[cursor.index].offset];
+}
+
+CJSON_PUBLIC(int) cJSON_CursorGetType(const cJSON_Cursor cursor)
+{
+    switch (lazy_first_character(cursor))
+    {
+        case '\0':
+            return cJSON_Invalid;
+        case '{':
+            return cJSON_Object;
+        case '[':
+            return cJSON_Array;
+        case '\"':
+            return cJSON_String;
+        case 't':
+            return cJSON_True;
+        case 'f':
+            return cJSON_False;
+        case 'n':
+            return cJSON_NULL;
+        default:
+            return cJSON_Number;
+    }
+}
+
+static void lazy_buffer(const cJSON_Lazy * const document, const size_t index, parse_buffer * const buffer)
+{
+    memset(buffer, '\0', sizeof(parse_buffer));
+    buffer->content = document->content;
+    buffer->length = document->length;
+    buffer->offset = document->tape[index].offset;
+    buffer->hooks = document->hooks;
+}
+
+/* decode the value at the cursor into item */
+static cJSON_bool lazy_decode(const cJSON_Cursor cursor, cJSON * const item)
+{
+    parse_buffer buffer;
+
+    if (lazy_first_character(cursor) == '\0')
+    {
+        return false;
+    }
+
+    lazy_buffer(cursor.document, cursor.index, &buffer);
+    if (!parse_value(item, &buffer))
+    {
+        return false;
+    }
+
+    /* numbers were only roughly checked by the first pass, make sure all of it was used */
+    return !can_access_at_index(&buffer, 0) || lazy_is_delimiter(*buffer_at_offset(&buffer));
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CursorDecode(const cJSON_Cursor cursor)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if (item == NULL)
+    {
+        return NULL;
+    }
+
+    if (!lazy_decode(cursor, item))
+    {
+        cJSON_Delete(item);
+        return NULL;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(double) cJSON_CursorGetNumberValue(const cJSON_Cursor cursor)
+{
+    cJSON number;
+    cJSON_bool decoded = false;
+
+    memset(&number, '\0', sizeof(number));
+    if (cJSON_CursorGetType(cursor) != cJSON_Number)
+    {
+        return (double) NAN;
+    }
+    decoded = lazy_decode(cursor, &number);
+    if (number.valuestring != NULL)
+    {
+        /* the exact value of a big integer */
+        cursor.document->hooks.deallocate(number.valuestring);
+    }
+
+    return decoded ? number.valuedouble : (double) NAN;
+}
+
+/* compare the key at index with name, decoding it only if it contains escapes */
+static cJSON_bool lazy_key_equals(const cJSON_Lazy * const document, const size_t index, const unsigned char * const name, const size_t name_length, const cJSON_bool case_sensitive)
+{
+    const unsigned char *key = document->content + document->tape[index].offset + 1;
+    const unsigned char * const end = document->content + document->length;
+    size_t key_length = skip_plain_characters(key, (size_t)(end - key), false);
+    cJSON decoded;
+    cJSON_bool equal = false;
+    size_t i = 0;
+
+    memset(&decoded, '\0', sizeof(decoded));
+    if (key[key_length] == '\\')
+    {
+        parse_buffer buffer;
+        lazy_buffer(document, index, &buffer);
+        if (!parse_string(&decoded, &buffer))
+        {
+            return false;
+        }
+        key = (const unsigned char*)decoded.valuestring;
+        key_length = strlen(decoded.valuestring);
+    }
+
+    if (key_length == name_length)
+    {
+        equal = true;
+        for (i = 0; equal && (i < name_length); i++)
+        {
+            equal = case_sensitive ? (key[i] == name[i]) : (tolower(key[i]) == tolower(name[i]));
+        }
+    }
+
+    if (decoded.valuestring != NULL)
+    {
+        document->hooks.deallocate(decoded.valuestring);
+    }
+
+    return equal;
+}
+
+static cJSON_Cursor lazy_get_object_item(const cJSON_Cursor object, const unsigned char * const name, const size_t name_length, const cJSON_bool case_sensitive)
+{
+    size_t index = 0;
+    size_t end = 0;
+
+    if (lazy_first_character(object) != '{')
+    {
+        return invalid_cursor;
+    }
+
+    /* keys and values alternate */
+    end = object.document->tape[object.index].end;
+    for (index = object.index + 1; index < end; index = object.document->tape[index + 1].end)
+    {
+        if (lazy_key_equals(object.document, index, name, name_length, case_sensitive))
+        {
+            return lazy_cursor(object.document, index + 1);
+        }
+    }
+
+    return invalid_cursor;
+}
+
+CJSON_PUBLIC(cJSON_Cursor) cJSON_CursorGetObjectItem(const cJSON_Cursor object, const char *string)
+{
+    if (string == NULL)
+    {
+        return invalid_cursor;
+    }
+
+    return lazy_get_object_item(object, (const unsigned char*)string, strlen(string), false);
+}
+
+CJSON_PUBLIC(cJSON_Cursor) cJSON_CursorGetObjectItemCaseSensitive(const cJSON_Cursor object, const char *string)
+{
+    if (string == NULL)
+    {
+        return invalid_cursor;
+    }
+
+    return lazy_get_object_item(object, (const unsigned char*)string, strlen(string), true);
+}
+
+CJSON_PUBLIC(cJSON_Cursor) cJSON_CursorGetArrayItem(const cJSON_Cursor array, int index)
+{
+    size_t current = 0;
+    size_t end = 0;
+
+    if ((lazy_first_character(array) != '[') || (index < 0))
+    {
+        return invalid_cursor;
+    }
+
+    end = array.document->tape[array.index].end;
+    for (current = array.index + 1; (current < end) && (index > 0); index--)
+    {
+        current = array.document->tape[current].end;
+    }
+
+    if (current >= end)
+    {
+        return invalid_cursor;
+    }
+
+    return lazy_cursor(array.document, current);
+}
+
+CJSON_PUBLIC(int) cJSON_CursorGetArraySize(const cJSON_Cursor array)
+{
+    size_t current = 0;
+    size_t end = 0;
+    size_t size = 0;
+
+    if (lazy_first_character(array) != '[')
+    {
+        return 0;
+    }
+
+    end = array.document->tape[array.index].end;
+    for (current = array.index + 1; current < end; current = array.document->tape[current].end)
+    {
+        size++;
+    }
+
+    return (int)size;
+}
+
+CJSON_PUBLIC(cJSON_Cursor) cJSON_CursorGetPointer(const cJSON_Cursor cursor, const char *pointer)
+{
+    cJSON_Cursor current = cursor;
+    unsigned char *token = NULL;
+
+    if ((pointer == NULL) || (lazy_first_character(cursor) == '\0'))
+    {
+        return invalid_cursor;
+    }
+
+    /* the unescaped reference tokens are never longer than the pointer */
+    token = (unsigned char*)cursor.document->hooks.allocate(strlen(pointer) + 1);
+    if (token == NULL)
+    {
+        return invalid_cursor;
+    }
+
+    while ((*pointer == '/') && (current.document != NULL))
+    {
+        size_t length = 0;
+
+        /* unescape ~0 and ~1 */
+        for (pointer++; (*pointer != '\0') && (*pointer != '/'); pointer++)
+        {
+            if (*pointer == '~')
+            {
+                if ((pointer[1] != '0') && (pointer[1] != '1'))
+                {
+                    current = invalid_cursor;
+                    break;
+                }
+                pointer++;
+                token[length++] = (*pointer == '0') ? '~' : '/';
+            }
+            else
+            {
+                token[length++] = (unsigned char)*pointer;
+            }
+        }
+        if (current.document == NULL)
+        {
+            break;
+        }
+
+        if (lazy_first_character(current) == '[')
+        {
+            /* decimal index without leading zeros */
+            size_t position = 0;
+            size_t i = 0;
+            if ((length == 0) || ((length > 1) && (token[0] == '0')) || (length > 9))
+            {
+                current = invalid_cursor;
+                break;
+            }
+            for (i = 0; i < length; i++)
+            {
+                if ((token[i] < '0') || (token[i] > '9'))
+                {
+                    break;
+                }
+                position = (10 * position) + (size_t)(token[i] - '0');
+            }
+            current = (i == length) ? cJSON_CursorGetArrayItem(current, (int)position) : invalid_cursor;
+        }
+        else
+        {
+            current = lazy_get_object_item(current, token, length, true);
+        }
+    }
+
+    cursor.document->hooks.deallocate(token);
+
+    /* a pointer is either empty or starts with '/' */
+    if (*pointer != '\0')
+    {
+        return invalid_cursor;
+    }
+
+    return current;
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+#define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
+
+static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
+{
+    static const size_t default_buffer_size = 256;
+    printbuffer buffer[1];
+    unsigned char *printed = NULL;
+
+    memset(buffer, 0, sizeof(buffer));
+
+    /* create buffer */
+    buffer->buffer = (unsigned char*) hooks->allocate(default_buffer_size);
+    buffer->length = default_buffer_size;
+    buffer->format = format;
+    buffer->hooks = *hooks;
+    if (buffer->buffer == NULL)
+    {
+        goto fail;
+    }
+
+    /* print the value */
+    if (!print_value(item, buffer))
+    {
+        goto fail;
+    }
+    update_offset(buffer);
+
+    /* check if reallocate is available */
+    if (hooks->reallocate != NULL)
+    {
+        printed = (unsigned char*) hooks->reallocate(buffer->buffer, buffer->offset + 1);
+        if (printed == NULL) {
+            goto fail;
+        }
+        buffer->buffer = NULL;
+    }
+    else /* otherwise copy the JSON over to a new buffer */
+    {
+        printed = (unsigned char*) hooks->allocate(buffer->offset + 1);
+        if (printed == NULL)
+        {
+            goto fail;
+        }
+        memcpy(printed, buffer->buffer, cjson_min(buffer->length, buffer->offset + 1));
+        printed[buffer->offset] = '\0'; /* just to be sure */
+
+        /* free the buffer */
+        hooks->deallocate(buffer->buffer);
+        buffer->buffer = NULL;
+    }
+
+    return printed;
+
+fail:
+    if (buffer->buffer != NULL)
+    {
+        hooks->deallocate(buffer->buffer);
+        buffer->buffer = NULL;
+    }
+
+    if (printed != NULL)
+    {
+        hooks->deallocate(printed);
+        printed = NULL;
+    }
+
+    return NULL;
+}
+
+/* Render a cJSON item/entity/structure to text. */
+CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item)
+{
+    return (char*)print(item, true, &global_hooks);
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item)
+{
+    return (char*)print(item, false, &global_hooks);
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintCtx(const cJSON *item, cJSON_bool format, const cJSON_Context *context)
+{
+    internal_hooks hooks;
+
+    if (context == NULL)
+    {
+        return NULL;
+    }
+    set_hooks(&hooks, &context->hooks);
+
+    return (char*)print(item, format, &hooks);
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+
+    if (prebuffer < 0)
+    {
+        return NULL;
+    }
+
+    p.buffer = (unsigned char*)global_hooks.allocate((size_t)prebuffer);
+    if (!p.buffer)
+    {
+        return NULL;
+    }
+
+    p.length = (size_t)prebuffer;
+    p.offset = 0;
+    p.noalloc = false;
+    p.format = fmt;
+    p.hooks = global_hooks;
+
+    if (!print_value(item, &p))
+    {
+        global_hooks.deallocate(p.buffer);
+        p.buffer = NULL;
+        return NULL;
+    }
+
+    return (char*)p.buffer;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToWriter(const cJSON *item, cJSON_bool format, cJSON_Writer writer, void *context)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+    cJSON_bool success = false;
+
+    if ((item == NULL) || (writer == NULL))
+    {
+        return false;
+    }
+
+    p.buffer = (unsigned char*)global_hooks.allocate(CJSON_PRINT_CHUNK_SIZE);
+    if (p.buffer == NULL)
+    {
+        return false;
+    }
+    p.length = CJSON_PRINT_CHUNK_SIZE;
+    p.format = format;
+    p.hooks = global_hooks;
+    p.writer = writer;
+    p.writer_context = context;
+
+    if (print_value(item, &p))
+    {
+        update_offset(&p);
+        success = (p.offset == 0) || writer(context, (const char*)p.buffer, p.offset);
+    }
+
+    if (p.buffer != NULL)
+    {
+        global_hooks.deallocate(p.buffer);
+    }
+
+    return success;
+}
+
+static cJSON_bool write_to_file(void *context, const char *data, size_t length)
+{
+    return fwrite(data, 1, length, (FILE*)context) == length;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToFile(const cJSON *item, cJSON_bool format, FILE *file)
+{
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    return cJSON_PrintToWriter(item, format, write_to_file, file);
+}
+
+static cJSON_bool write_to_fd(void *context, const char *data, size_t length)
+{
+    const int fd = *(const int*)context;
+
+    while (length > 0)
+    {
+#ifdef _WIN32
+        int written = _write(fd, data, (length > INT_MAX) ? INT_MAX : (unsigned int)length);
+#else
+        ssize_t written = write(fd, data, length);
+        if ((written < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+#endif
+        if (written <= 0)
+        {
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToFd(const cJSON *item, cJSON_bool format, int fd)
+{
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    return cJSON_PrintToWriter(item, format, write_to_fd, &fd);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+
+    if ((length < 0) || (buffer == NULL))
+    {
+        return false;
+    }
+
+    p.buffer = (unsigned char*)buffer;
+    p.length = (size_t)length;
+    p.offset = 0;
+    p.noalloc = true;
+    p.format = format;
+    p.hooks = global_hooks;
+
+    return print_value(item, &p);
+}
+
+static size_t printed_string_length(const unsigned char * const string)
+{
+    size_t length = 0;
+
+    if (string == NULL)
+    {
+        return sizeof("\"\"") - 1;
+    }
+
+    length = strlen((const char*)string);
+
+    return length + count_escape_characters(string, string + length) + sizeof("\"\"") - 1;
+}
+
+/* the length print_value would produce, mirroring the print functions; false where they fail */
+static cJSON_bool printed_length(const cJSON * const item, const cJSON_bool format, size_t * const length)
+{
+    print_frame inline_frames[INLINE_STACK_FRAMES];
+    print_frame *frames = inline_frames;
+    print_frame *frame = NULL;
+    size_t capacity = INLINE_STACK_FRAMES;
+    size_t count = 0;
+    const cJSON *current = item;
+    cJSON_bool object = false;
+    unsigned char number_buffer[26];
+    packed_numbers *packed = NULL;
+    cJSON number;
+    size_t i = 0;
+
+value:
+    if ((count > 0) && ((frames[count - 1].container->type & 0xFF) == cJSON_Object))
+    {
+        /* indentation, key, ":\t" or ":" */
+        *length += format ? count : 0;
+        *length += printed_string_length((const unsigned char*)current->string);
+        *length += format ? 2 : 1;
+    }
+
+    switch ((current->type) & 0xFF)
+    {
+        case cJSON_NULL:
+        case cJSON_True:
+            *length += 4;
+            break;
+
+        case cJSON_False:
+            *length += 5;
+            break;
+
+        case cJSON_Number:
+            *length += (size_t)format_number(current, number_buffer);
+            break;
+
+        case cJSON_Raw:
+            if (current->valuestring == NULL)
+            {
+                goto fail;
+            }
+            *length += strlen(current->valuestring);
+            break;
+
+        case cJSON_String:
+            *length += printed_string_length((const unsigned char*)current->valuestring);
+            break;
+
+        case cJSON_Array:
+        case cJSON_Object:
+            /* "{\n" or "{" or "[", closed with depth tabs and "}" or with "]" */
+            object = ((current->type & 0xFF) == cJSON_Object);
+            *length += (object && format) ? 2 : 1;
+            if (current->type & cJSON_PackedNumberArray)
+            {
+                /* the numbers, separated by ", " or ",", and "]" */
+                packed = packed_numbers_of(current);
+                for (i = 0; i < packed->count; i++)
+                {
+                    packed_number(packed, i, &number);
+                    *length += (size_t)format_number(&number, number_buffer);
+                }
+                *length += (packed->count - 1) * (format ? 2 : 1) + 1;
+                break;
+            }
+            if (current->child == NULL)
+            {
+                *length += (object && format) ? (count + 1) : 1;
+                break;
+            }
+            if (count == capacity)
+            {
+                print_frame *grown = (print_frame*)grow_stack(frames, &capacity, sizeof(print_frame), inline_frames, &global_hooks);
+                if (grown == NULL)
+                {
+                    goto fail;
+                }
+                frames = grown;
+            }
+            frames[count].container = current;
+            frames[count].current = current->child;
+            count++;
+            current = current->child;
+            goto value;
+
+        default:
+            goto fail;
+    }
+
+value_done:
+    if (count == 0)
+    {
+        if (frames != inline_frames)
+        {
+            global_hooks.deallocate(frames);
+        }
+        return true;
+    }
+
+    /* ",\n" or "," after object members, ", " or "," between array elements */
+    frame = &frames[count - 1];
+    object = ((frame->container->type & 0xFF) == cJSON_Object);
+    if (object)
+    {
+        *length += (format ? 1 : 0) + ((frame->current->next != NULL) ? 1 : 0);
+    }
+    else if (frame->current->next != NULL)
+    {
+        *length += format ? 2 : 1;
+    }
+
+    if (frame->current->next != NULL)
+    {
+        current = frame->current = frame->current->next;
+        goto value;
+    }
+
+    count--;
+    *length += (object && format) ? (count + 1) : 1;
+    goto value_done;
+
+fail:
+    if (frames != inline_frames)
+    {
+        global_hooks.deallocate(frames);
+    }
+
+    return false;
+}
+
+CJSON_PUBLIC(size_t) cJSON_PrintedLength(const cJSON *item, cJSON_bool format)
+{
+    size_t length = 0;
+
+    if ((item == NULL) || !printed_length(item, format, &length))
+    {
+        return 0;
+    }
+
+    return length;
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintExact(const cJSON *item, cJSON_bool format)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 }, 0, 0 };
+    size_t length = cJSON_PrintedLength(item, format);
+
+    if ((length == 0) || (length > (INT_MAX - 2)))
+    {
+        return NULL;
+    }
+
+    /* ensure() always wants a spare byte after what is requested, including the terminator */
+    p.length = length + sizeof("") + 1;
+    p.buffer = (unsigned char*)global_hooks.allocate(p.length);
+    if (p.buffer == NULL)
+    {
+        return NULL;
+    }
+    p.noalloc = true;
+    p.format = format;
+    p.hooks = global_hooks;
+
+    if (!print_value(item, &p))
+    {
+        global_hooks.deallocate(p.buffer);
+        return NULL;
+    }
+
+    return (char*)p.buffer;
+}
+
+/* Parser core - when encountering text, process appropriately. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
+{
+    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    {
+        return false; /* no input */
+    }
+
+    /* parse the different types of values */
+    /* null */
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
+    {
+        item->type = cJSON_NULL;
+        input_buffer->offset += 4;
+        return true;
+    }
+    /* false */
     if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
     {
-        item->type = cJSON_False;
-        input_buffer->offset += 5;
-        return true;
+        item->type = cJSON_False;
+        input_buffer->offset += 5;
+        return true;
+    }
+    /* true */
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
+    {
+        item->type = cJSON_True;
+        item->valueint = 1;
+        input_buffer->offset += 4;
+        return true;
+    }
+    /* string */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+    {
+        return parse_string(item, input_buffer);
+    }
+    /* number */
+    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9'))))
+    {
+        return parse_number(item, input_buffer) && parse_exact_integer(item, input_buffer);
+    }
+    /* array or object */
+    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '[') || (buffer_at_offset(input_buffer)[0] == '{')))
+    {
+        return parse_container(item, input_buffer);
+    }
+
+    return false;
+}
+
+/* Render a value to text. */
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output = NULL;
+
+    if ((item == NULL) || (output_buffer == NULL))
+    {
+        return false;
+    }
+
+    switch ((item->type) & 0xFF)
+    {
+        case cJSON_NULL:
+            output = ensure(output_buffer, 5);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "null");
+            return true;
+
+        case cJSON_False:
+            output = ensure(output_buffer, 6);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "false");
+            return true;
+
+        case cJSON_True:
+            output = ensure(output_buffer, 5);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "true");
+            return true;
+
+        case cJSON_Number:
+            return print_number(item, output_buffer);
+
+        case cJSON_Raw:
+        {
+            size_t raw_length = 0;
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+
+            raw_length = strlen(item->valuestring) + sizeof("");
+            output = ensure(output_buffer, raw_length);
+            if (output == NULL)
+            {
+                return false;
+            }
+            memcpy(output, item->valuestring, raw_length);
+            return true;
+        }
+
+        case cJSON_String:
+            return print_string(item, output_buffer);
+
+        case cJSON_Array:
+        case cJSON_Object:
+            return print_container(item, output_buffer);
+
+        default:
+            return false;
+    }
+}
+
+/* numeric arrays are packed on request, but not into arenas, for events or with other hooks than the global ones */
+#define can_pack_numbers(buffer) (((buffer)->context != NULL) && (buffer)->context->pack_number_arrays \
+    && ((buffer)->arena == NULL) && ((buffer)->events == NULL) \
+    && ((buffer)->hooks.allocate == global_hooks.allocate) && ((buffer)->hooks.deallocate == global_hooks.deallocate))
+
+/* Parse an array that only holds numbers into a packed array. Returns false and leaves the input at the '['
+ * for anything else (empty arrays, other values, errors, integers that mixed with other numbers would lose
+ * digits), the array is then parsed into items. */
+static cJSON_bool parse_packed_array(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const size_t start = input_buffer->offset;
+    packed_numbers *packed = NULL;
+    packed_numbers *grown = NULL;
+    size_t capacity = 0;
+    size_t count = 0;
+    size_t i = 0;
+    cJSON number;
+
+    do
+    {
+        /* skip the '[' or ',' */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (cannot_access_at_index(input_buffer, 0)
+            || ((buffer_at_offset(input_buffer)[0] != '-') && ((buffer_at_offset(input_buffer)[0] < '0') || (buffer_at_offset(input_buffer)[0] > '9'))))
+        {
+            goto fail;
+        }
+        memset(&number, '\0', sizeof(number));
+        if (!parse_number(&number, input_buffer))
+        {
+            goto fail;
+        }
+
+        if (count == capacity)
+        {
+            capacity = (capacity == 0) ? 16 : (capacity * 2);
+            grown = packed_numbers_new(capacity, (packed == NULL) || packed->integers);
+            if (grown == NULL)
+            {
+                goto fail;
+            }
+            if (packed != NULL)
+            {
+                memcpy(grown->values, packed->values, count * sizeof(packed_value));
+                global_hooks.deallocate(packed);
+            }
+            packed = grown;
+        }
+
+        if (packed->integers && !(number.type & cJSON_IsInt64))
+        {
+            /* the integers so far become doubles */
+            for (i = 0; i < count; i++)
+            {
+                if ((packed->values[i].integer <= -CJSON_DOUBLE_EXACT_LIMIT) || (packed->values[i].integer >= CJSON_DOUBLE_EXACT_LIMIT))
+                {
+                    goto fail;
+                }
+                packed->values[i].number = (double)packed->values[i].integer;
+            }
+            packed->integers = false;
+        }
+
+        if (packed->integers)
+        {
+            packed->values[count].integer = input_buffer->integer;
+        }
+        else if ((number.type & cJSON_IsInt64) && ((input_buffer->integer <= -CJSON_DOUBLE_EXACT_LIMIT) || (input_buffer->integer >= CJSON_DOUBLE_EXACT_LIMIT)))
+        {
+            goto fail;
+        }
+        else
+        {
+            packed->values[count].number = number.valuedouble;
+        }
+        count++;
+
+        buffer_skip_whitespace(input_buffer);
+    } while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ']'))
+    {
+        goto fail;
+    }
+    input_buffer->offset++;
+
+    packed->count = count;
+    if ((count < capacity) && (global_hooks.reallocate != NULL))
+    {
+        /* give back the room to grow */
+        grown = (packed_numbers*)global_hooks.reallocate(packed, packed_numbers_size(count));
+        if (grown != NULL)
+        {
+            packed = grown;
+        }
+    }
+
+    item->type = cJSON_Array | cJSON_PackedNumberArray;
+    item->valuestring = (char*)packed;
+
+    return true;
+
+fail:
+    if (packed != NULL)
+    {
+        global_hooks.deallocate(packed);
+    }
+    input_buffer->offset = start;
+
+    return false;
+}
+
+/* an array or object whose members are being parsed */
+typedef struct
+{
+    cJSON *container;
+    cJSON *head; /* head of the linked list */
+    cJSON *current;
+    cJSON_bool object;
+} parse_frame;
+
+/* Build an array or object from input text. Nested arrays and objects are parsed in the same loop,
+ * with a frame per level on an explicit stack instead of recursion. */
+static cJSON_bool parse_container(cJSON * const item, parse_buffer * const input_buffer)
+{
+    parse_frame inline_frames[INLINE_STACK_FRAMES];
+    parse_frame *frames = inline_frames;
+    parse_frame *frame = NULL;
+    size_t capacity = INLINE_STACK_FRAMES;
+    size_t count = 0;
+    cJSON *container = item;
+    cJSON *new_item = NULL;
+
+open:
+    if (input_buffer->depth >= nesting_limit(input_buffer))
+    {
+        goto fail; /* to deeply nested */
+    }
+    if ((buffer_at_offset(input_buffer)[0] == '[') && can_pack_numbers(input_buffer) && parse_packed_array(container, input_buffer))
+    {
+        /* no items and no frame, continue with the enclosing array or object */
+        if (count > 0)
+        {
+            frame = &frames[count - 1];
+            goto value_done;
+        }
+        goto done;
+    }
+    if (count == capacity)
+    {
+        parse_frame *grown = (parse_frame*)grow_stack(frames, &capacity, sizeof(parse_frame), inline_frames, &input_buffer->hooks);
+        if (grown == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+        frames = grown;
+    }
+    frame = &frames[count++];
+    frame->container = container;
+    frame->head = NULL;
+    frame->current = NULL;
+    frame->object = (buffer_at_offset(input_buffer)[0] == '{');
+    input_buffer->depth++;
+
+    if (input_buffer->events != NULL)
+    {
+        if (frame->object ? ((input_buffer->events->start_object != NULL) && !input_buffer->events->start_object(input_buffer->events_context))
+                          : ((input_buffer->events->start_array != NULL) && !input_buffer->events->start_array(input_buffer->events_context)))
+        {
+            goto fail; /* aborted by the event handler */
+        }
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == (frame->object ? '}' : ']')))
+    {
+        goto close; /* empty array or object */
+    }
+
+    /* check if we skipped to the end of the buffer */
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        input_buffer->offset--;
+        goto fail;
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+
+element:
+    /* allocate next item */
+    new_item = parse_new_item(input_buffer);
+    if (new_item == NULL)
+    {
+        goto fail; /* allocation failure */
+    }
+
+    /* attach next item to list */
+    if (input_buffer->events != NULL)
+    {
+        /* no tree in event parsing, new_item is the scratch item */
+        frame->current = new_item;
+    }
+    else if (frame->head == NULL)
+    {
+        /* start the linked list */
+        frame->current = frame->head = new_item;
+    }
+    else
+    {
+        /* add to the end and advance */
+        frame->current->next = new_item;
+        new_item->prev = frame->current;
+        frame->current = new_item;
+    }
+
+    if (frame->object)
+    {
+        if (cannot_access_at_index(input_buffer, 1))
+        {
+            goto fail; /* nothing comes after the comma */
+        }
+
+        /* parse the name of the child */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (input_buffer->keys != NULL)
+        {
+            /* only keys that aren't pooled yet need memory of their own */
+            input_buffer->scratch_used = 0;
+            input_buffer->scratch_string = true;
+        }
+        if (!parse_string(frame->current, input_buffer))
+        {
+            goto fail; /* failed to parse name */
+        }
+        input_buffer->scratch_string = false;
+        buffer_skip_whitespace(input_buffer);
+
+        /* swap valuestring and string, because we parsed the name */
+        frame->current->string = frame->current->valuestring;
+        frame->current->valuestring = NULL;
+
+        if (input_buffer->keys != NULL)
+        {
+            frame->current->string = key_pool_intern(input_buffer->keys, (const unsigned char*)frame->current->string);
+            if (frame->current->string == NULL)
+            {
+                goto fail; /* allocation failure */
+            }
+            frame->current->type = cJSON_StringIsConst | cJSON_StringIsInterned;
+        }
+
+        if (input_buffer->events != NULL)
+        {
+            if ((input_buffer->events->key != NULL) && !input_buffer->events->key(input_buffer->events_context, frame->current->string))
+            {
+                goto fail; /* aborted by the event handler */
+            }
+            /* the scratch memory of the key may be reused for the value */
+            frame->current->string = NULL;
+        }
+
+        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+        {
+            goto fail; /* invalid object */
+        }
+    }
+
+    /* parse next value, arrays and objects get a frame of their own */
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '[') || (buffer_at_offset(input_buffer)[0] == '{')))
+    {
+        container = frame->current;
+        goto open;
+    }
+    if (!parse_value(frame->current, input_buffer))
+    {
+        goto fail; /* failed to parse value */
+    }
+
+value_done:
+    if (!parse_finish_item(frame->current, input_buffer))
+    {
+        goto fail; /* aborted by the event handler */
+    }
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','))
+    {
+        goto element;
+    }
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != (frame->object ? '}' : ']')))
+    {
+        goto fail; /* expected end of array or object */
     }
-    /* true */
-    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
+
+close:
+    if (input_buffer->events != NULL)
     {
-        item->type = cJSON_True;
-        item->valueint = 1;
-        input_buffer->offset += 4;
-        return true;
+        if (frame->object ? ((input_buffer->events->end_object != NULL) && !input_buffer->events->end_object(input_buffer->events_context))
+                          : ((input_buffer->events->end_array != NULL) && !input_buffer->events->end_array(input_buffer->events_context)))
+        {
+            goto fail; /* aborted by the event handler */
+        }
     }
-    /* string */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+    input_buffer->depth--;
+
+    if (frame->head != NULL) {
+        frame->head->prev = frame->current;
+    }
+
+    frame->container->type = frame->object ? cJSON_Object : cJSON_Array;
+    frame->container->child = frame->head;
+
+    input_buffer->offset++;
+
+    /* continue with the enclosing array or object */
+    count--;
+    if (count > 0)
     {
-        return parse_string(item, input_buffer);
+        frame = &frames[count - 1];
+        goto value_done;
     }
-    /* number */
-    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9'))))
+
+done:
+    if (frames != inline_frames)
     {
-        return parse_number(item, input_buffer);
+        input_buffer->hooks.deallocate(frames);
     }
-    /* array */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '['))
+
+    return true;
+
+fail:
+    while (count > 0)
     {
-        return parse_array(item, input_buffer);
+        frame = &frames[--count];
+        if (frame->object && (frame->current != NULL) && (frame->current->string != NULL) && (input_buffer->keys != NULL))
+        {
+            /* parse_value may have overwritten the flags */
+            frame->current->type |= cJSON_StringIsConst | cJSON_StringIsInterned;
+        }
+        /* arena memory is released with the arena */
+        if ((frame->head != NULL) && (input_buffer->arena == NULL))
+        {
+            delete_item(frame->head, &input_buffer->hooks);
+        }
     }
-    /* object */
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '{'))
+    if (frames != inline_frames)
     {
-        return parse_object(item, input_buffer);
+        input_buffer->hooks.deallocate(frames);
     }
 
     return false;
 }
 
-/* Render a value to text. */
-static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer)
-{
-    unsigned char *output = NULL;
+/* Validation: the same checks as parse_value, parse_string and parse_container, with the same error positions,
+ * but nothing is decoded or allocated. Strings are also checked to be well-formed UTF-8, which the parser
+ * doesn't do. */
 
-    if ((item == NULL) || (output_buffer == NULL))
-    {
-        return false;
-    }
+/* length of the well-formed UTF-8 at the start of [start, end): no overlong forms, surrogates or code points
+ * above U+10FFFF (RFC 3629) */
+static size_t valid_utf8_length(const unsigned char * const start, const unsigned char * const end)
+{
+    const unsigned char *pointer = start;
+    cjson_uint64 word = 0;
+    unsigned char lower = 0;
+    unsigned char upper = 0;
+    size_t continuation = 0;
+    size_t i = 0;
 
-    switch ((item->type) & 0xFF)
+    while (pointer < end)
     {
-        case cJSON_NULL:
-            output = ensure(output_buffer, 5);
-            if (output == NULL)
+        /* skip ASCII 8 bytes at a time */
+        if ((size_t)(end - pointer) >= sizeof(word))
+        {
+            memcpy(&word, pointer, sizeof(word));
+            if ((word & SWAR_HIGHS) == 0)
             {
-                return false;
+                pointer += sizeof(word);
+                continue;
             }
-            strcpy((char*)output, "null");
-            return true;
+        }
+        if (*pointer < 0x80)
+        {
+            pointer++;
+            continue;
+        }
 
-        case cJSON_False:
-            output = ensure(output_buffer, 6);
-            if (output == NULL)
+        /* the range of the second byte depends on the first one */
+        lower = 0x80;
+        upper = 0xBF;
+        if ((*pointer >= 0xC2) && (*pointer <= 0xDF))
+        {
+            continuation = 1;
+        }
+        else if ((*pointer >= 0xE0) && (*pointer <= 0xEF))
+        {
+            continuation = 2;
+            if (*pointer == 0xE0)
             {
-                return false;
+                lower = 0xA0; /* overlong */
             }
-            strcpy((char*)output, "false");
-            return true;
-
-        case cJSON_True:
-            output = ensure(output_buffer, 5);
-            if (output == NULL)
+            else if (*pointer == 0xED)
             {
-                return false;
+                upper = 0x9F; /* surrogates */
             }
-            strcpy((char*)output, "true");
-            return true;
-
-        case cJSON_Number:
-            return print_number(item, output_buffer);
-
-        case cJSON_Raw:
+        }
+        else if ((*pointer >= 0xF0) && (*pointer <= 0xF4))
         {
-            size_t raw_length = 0;
-            if (item->valuestring == NULL)
+            continuation = 3;
+            if (*pointer == 0xF0)
             {
-                return false;
+                lower = 0x90; /* overlong */
             }
-
-            raw_length = strlen(item->valuestring) + sizeof("");
-            output = ensure(output_buffer, raw_length);
-            if (output == NULL)
+            else if (*pointer == 0xF4)
             {
-                return false;
+                upper = 0x8F; /* above U+10FFFF */
             }
-            memcpy(output, item->valuestring, raw_length);
-            return true;
+        }
+        else
+        {
+            break;
         }
 
-        case cJSON_String:
-            return print_string(item, output_buffer);
-
-        case cJSON_Array:
-            return print_array(item, output_buffer);
-
-        case cJSON_Object:
-            return print_object(item, output_buffer);
-
-        default:
-            return false;
+        if (((size_t)(end - pointer) <= continuation) || (pointer[1] < lower) || (pointer[1] > upper))
+        {
+            break;
+        }
+        for (i = 2; (i <= continuation) && ((pointer[i] & 0xC0) == 0x80); i++)
+        {
+        }
+        if (i <= continuation)
+        {
+            break;
+        }
+        pointer += continuation + 1;
     }
+
+    return (size_t)(pointer - start);
 }
 
-/* Build an array from input text. */
-static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer)
+/* check a string like parse_string */
+static cJSON_bool validate_string(parse_buffer * const input_buffer)
 {
-    cJSON *head = NULL; /* head of the linked list */
-    cJSON *current_item = NULL;
-
-    if (input_buffer->depth >= CJSON_NESTING_LIMIT)
-    {
-        return false; /* to deeply nested */
-    }
-    input_buffer->depth++;
+    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
+    long unsigned int codepoint = 0;
+    unsigned char sequence_length = 0;
+    size_t plain_length = 0;
+    size_t utf8_length = 0;
 
-    if (buffer_at_offset(input_buffer)[0] != '[')
+    /* not a string, the error is at this character (only object keys get here) */
+    if (buffer_at_offset(input_buffer)[0] != '\"')
     {
-        /* not an array */
-        goto fail;
+        return false;
     }
 
-    input_buffer->offset++;
-    buffer_skip_whitespace(input_buffer);
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
+    /* find the closing quote */
+    while ((size_t)(input_end - input_buffer->content) < input_buffer->length)
     {
-        /* empty array */
-        goto success;
+        input_end += skip_plain_characters(input_end, input_buffer->length - (size_t)(input_end - input_buffer->content), false);
+        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end == '\"'))
+        {
+            break;
+        }
+        if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
+        {
+            goto fail;
+        }
+        input_end += 2;
     }
-
-    /* check if we skipped to the end of the buffer */
-    if (cannot_access_at_index(input_buffer, 0))
+    if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
     {
-        input_buffer->offset--;
         goto fail;
     }
 
-    /* step back to character in front of the first element */
-    input_buffer->offset--;
-    /* loop through the comma separated array elements */
-    do
+    /* check the escape sequences and the UTF-8 between them */
+    while (input_pointer < input_end)
     {
-        /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
-        if (new_item == NULL)
+        plain_length = skip_plain_characters(input_pointer, (size_t)(input_end - input_pointer), false);
+        utf8_length = valid_utf8_length(input_pointer, input_pointer + plain_length);
+        input_pointer += utf8_length;
+        if (utf8_length < plain_length)
         {
-            goto fail; /* allocation failure */
+            goto fail;
         }
-
-        /* attach next item to list */
-        if (head == NULL)
+        if (input_pointer >= input_end)
         {
-            /* start the linked list */
-            current_item = head = new_item;
+            break;
         }
-        else
+        if (*input_pointer != '\\')
         {
-            /* add to the end and advance */
-            current_item->next = new_item;
-            new_item->prev = current_item;
-            current_item = new_item;
+            input_pointer++;
+            continue;
         }
 
-        /* parse next value */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_value(current_item, input_buffer))
+        switch (input_pointer[1])
         {
-            goto fail; /* failed to parse value */
-        }
-        buffer_skip_whitespace(input_buffer);
-    }
-    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
-
-    if (cannot_access_at_index(input_buffer, 0) || buffer_at_offset(input_buffer)[0] != ']')
-    {
-        goto fail; /* expected end of array */
-    }
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+            case '\"':
+            case '\\':
+            case '/':
+                sequence_length = 2;
+                break;
 
-success:
-    input_buffer->depth--;
+            case 'u':
+                sequence_length = utf16_literal_codepoint(input_pointer, input_end, &codepoint);
+                if (sequence_length == 0)
+                {
+                    goto fail;
+                }
+                break;
 
-    if (head != NULL) {
-        head->prev = current_item;
+            default:
+                goto fail;
+        }
+        input_pointer += sequence_length;
     }
 
-    item->type = cJSON_Array;
-    item->child = head;
-
-    input_buffer->offset++;
+    input_buffer->offset = (size_t)(input_end - input_buffer->content) + 1;
 
     return true;
 
 fail:
-    if (head != NULL)
-    {
-        cJSON_Delete(head);
-    }
+    input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
 
     return false;
 }
 
-/* Render an array to text */
-static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer)
+/* check a value like parse_value, arrays and objects with a bit per nesting level instead of a stack of frames */
+static cJSON_bool validate_value(parse_buffer * const input_buffer)
 {
-    unsigned char *output_pointer = NULL;
-    size_t length = 0;
-    cJSON *current_element = item->child;
+    unsigned char objects[(CJSON_NESTING_LIMIT + 7) / 8];
+    cJSON number;
+    cJSON_bool object = false;
 
-    if (output_buffer == NULL)
+value:
+    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '[') || (buffer_at_offset(input_buffer)[0] == '{')))
     {
-        return false;
+        goto open;
     }
-
-    /* Compose the output array. */
-    /* opening square bracket */
-    output_pointer = ensure(output_buffer, 1);
-    if (output_pointer == NULL)
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
     {
-        return false;
+        input_buffer->offset += 4;
     }
-
-    *output_pointer = '[';
-    output_buffer->offset++;
-    output_buffer->depth++;
-
-    while (current_element != NULL)
+    else if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
+    {
+        input_buffer->offset += 5;
+    }
+    else if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
     {
-        if (!print_value(current_element, output_buffer))
+        input_buffer->offset += 4;
+    }
+    else if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+    {
+        if (!validate_string(input_buffer))
         {
             return false;
         }
-        update_offset(output_buffer);
-        if (current_element->next)
+    }
+    else if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9'))))
+    {
+        /* numbers are parsed into a scratch item, which needs no memory */
+        memset(&number, '\0', sizeof(number));
+        if (!parse_number(&number, input_buffer))
         {
-            length = (size_t) (output_buffer->format ? 2 : 1);
-            output_pointer = ensure(output_buffer, length + 1);
-            if (output_pointer == NULL)
-            {
-                return false;
-            }
-            *output_pointer++ = ',';
-            if(output_buffer->format)
-            {
-                *output_pointer++ = ' ';
-            }
-            *output_pointer = '\0';
-            output_buffer->offset += length;
+            return false;
         }
-        current_element = current_element->next;
     }
-
-    output_pointer = ensure(output_buffer, 2);
-    if (output_pointer == NULL)
+    else
     {
         return false;
     }
-    *output_pointer++ = ']';
-    *output_pointer = '\0';
-    output_buffer->depth--;
 
-    return true;
-}
+value_done:
+    if (input_buffer->depth == 0)
+    {
+        return true;
+    }
+    object = (objects[(input_buffer->depth - 1) / 8] >> ((input_buffer->depth - 1) % 8)) & 1;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','))
+    {
+        goto element;
+    }
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != (object ? '}' : ']')))
+    {
+        return false; /* expected end of array or object */
+    }
 
-/* Build an object from the text. */
-static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer)
-{
-    cJSON *head = NULL; /* linked list head */
-    cJSON *current_item = NULL;
+close:
+    input_buffer->depth--;
+    input_buffer->offset++;
+    goto value_done;
 
+open:
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
         return false; /* to deeply nested */
     }
-    input_buffer->depth++;
-
-    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '{'))
+    object = (buffer_at_offset(input_buffer)[0] == '{');
+    if (object)
+    {
+        objects[input_buffer->depth / 8] |= (unsigned char)(1 << (input_buffer->depth % 8));
+    }
+    else
     {
-        goto fail; /* not an object */
+        objects[input_buffer->depth / 8] &= (unsigned char)~(1 << (input_buffer->depth % 8));
     }
+    input_buffer->depth++;
 
     input_buffer->offset++;
     buffer_skip_whitespace(input_buffer);
-    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == (object ? '}' : ']')))
     {
-        goto success; /* empty object */
+        goto close; /* empty array or object */
     }
-
-    /* check if we skipped to the end of the buffer */
     if (cannot_access_at_index(input_buffer, 0))
     {
         input_buffer->offset--;
-        goto fail;
-    }
-
-    /* step back to character in front of the first element */
-    input_buffer->offset--;
-    /* loop through the comma separated array elements */
-    do
-    {
-        /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
-        if (new_item == NULL)
-        {
-            goto fail; /* allocation failure */
-        }
-
-        /* attach next item to list */
-        if (head == NULL)
-        {
-            /* start the linked list */
-            current_item = head = new_item;
-        }
-        else
-        {
-            /* add to the end and advance */
-            current_item->next = new_item;
-            new_item->prev = current_item;
-            current_item = new_item;
-        }
-
-        if (cannot_access_at_index(input_buffer, 1))
-        {
-            goto fail; /* nothing comes after the comma */
-        }
-
-        /* parse the name of the child */
-        input_buffer->offset++;
-        buffer_skip_whitespace(input_buffer);
-        if (!parse_string(current_item, input_buffer))
-        {
-            goto fail; /* failed to parse name */
-        }
-        buffer_skip_whitespace(input_buffer);
-
-        /* swap valuestring and string, because we parsed the name */
-        current_item->string = current_item->valuestring;
-        current_item->valuestring = NULL;
+        return false;
+    }
+    input_buffer->offset--;
 
-        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+element:
+    if (object)
+    {
+        if (cannot_access_at_index(input_buffer, 1))
         {
-            goto fail; /* invalid object */
+            return false; /* nothing comes after the comma */
         }
-
-        /* parse the value */
         input_buffer->offset++;
         buffer_skip_whitespace(input_buffer);
-        if (!parse_value(current_item, input_buffer))
+        if (!validate_string(input_buffer))
         {
-            goto fail; /* failed to parse value */
+            return false; /* invalid name */
         }
         buffer_skip_whitespace(input_buffer);
+        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+        {
+            return false; /* invalid object */
+        }
     }
-    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    goto value;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_Validate(const char *value, size_t buffer_length, size_t *error_offset)
+{
+    parse_buffer buffer;
 
-    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    memset(&buffer, '\0', sizeof(buffer));
+    if (error_offset != NULL)
+    {
+        *error_offset = 0;
+    }
+    if ((value == NULL) || (buffer_length == 0))
     {
-        goto fail; /* expected end of object */
+        return false;
     }
 
-success:
-    input_buffer->depth--;
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length;
 
-    if (head != NULL) {
-        head->prev = current_item;
+    if (validate_value(buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    {
+        /* nothing but whitespace may follow the value */
+        while ((buffer.offset < buffer.length) && (buffer_at_offset(&buffer)[0] <= 32))
+        {
+            buffer.offset++;
+        }
+        if (buffer.offset == buffer.length)
+        {
+            return true;
+        }
     }
 
-    item->type = cJSON_Object;
-    item->child = head;
+    if (error_offset != NULL)
+    {
+        /* where cJSON_GetErrorPtr would point */
+        *error_offset = (buffer.offset < buffer.length) ? buffer.offset : (buffer.length - 1);
+    }
 
-    input_buffer->offset++;
-    return true;
+    return false;
+}
 
-fail:
-    if (head != NULL)
+/* print the elements of a packed array, like the items it expands to */
+static cJSON_bool print_packed_numbers(const cJSON * const array, printbuffer * const output_buffer)
+{
+    packed_numbers *packed = packed_numbers_of(array);
+    unsigned char number_buffer[26];
+    unsigned char *output_pointer = NULL;
+    cJSON number;
+    size_t length = 0;
+    size_t separator = 0;
+    size_t i = 0;
+
+    for (i = 0; i < packed->count; i++)
     {
-        cJSON_Delete(head);
+        packed_number(packed, i, &number);
+        length = (size_t)format_number(&number, number_buffer);
+        separator = (i + 1 < packed->count) ? (size_t)(output_buffer->format ? 2 : 1) : 0;
+
+        output_pointer = ensure(output_buffer, length + separator + 1);
+        if (output_pointer == NULL)
+        {
+            return false;
+        }
+        memcpy(output_pointer, number_buffer, length);
+        output_pointer += length;
+        if (separator > 0)
+        {
+            *output_pointer++ = ',';
+            if (output_buffer->format)
+            {
+                *output_pointer++ = ' ';
+            }
+        }
+        *output_pointer = '\0';
+        output_buffer->offset += length + separator;
     }
 
-    return false;
+    return true;
 }
 
-/* Render an object to text. */
-static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer)
+/* Render an array or object to text. Nested arrays and objects are printed in the same loop,
+ * with a frame per level on an explicit stack instead of recursion. */
+static cJSON_bool print_container(const cJSON * const item, printbuffer * const output_buffer)
 {
+    print_frame inline_frames[INLINE_STACK_FRAMES];
+    print_frame *frames = inline_frames;
+    print_frame *frame = NULL;
+    size_t capacity = INLINE_STACK_FRAMES;
+    size_t count = 0;
+    const cJSON *container = item;
     unsigned char *output_pointer = NULL;
     size_t length = 0;
-    cJSON *current_item = item->child;
 
     if (output_buffer == NULL)
     {
         return false;
     }
 
-    /* Compose the output: */
-    length = (size_t) (output_buffer->format ? 2 : 1); /* fmt: {\n */
-    output_pointer = ensure(output_buffer, length + 1);
-    if (output_pointer == NULL)
+open:
+    if (count == capacity)
     {
-        return false;
+        print_frame *grown = (print_frame*)grow_stack(frames, &capacity, sizeof(print_frame), inline_frames, &output_buffer->hooks);
+        if (grown == NULL)
+        {
+            goto fail;
+        }
+        frames = grown;
     }
+    frame = &frames[count++];
+    frame->container = container;
+    frame->current = container->child;
 
-    *output_pointer++ = '{';
+    if ((container->type & 0xFF) == cJSON_Object)
+    {
+        length = (size_t) (output_buffer->format ? 2 : 1); /* fmt: {\n */
+        output_pointer = ensure(output_buffer, length + 1);
+        if (output_pointer == NULL)
+        {
+            goto fail;
+        }
+        *output_pointer++ = '{';
+        if (output_buffer->format)
+        {
+            *output_pointer++ = '\n';
+        }
+        output_buffer->offset += length;
+    }
+    else
+    {
+        output_pointer = ensure(output_buffer, 1);
+        if (output_pointer == NULL)
+        {
+            goto fail;
+        }
+        *output_pointer = '[';
+        output_buffer->offset++;
+    }
     output_buffer->depth++;
-    if (output_buffer->format)
+
+    if ((container->type & cJSON_PackedNumberArray) && !print_packed_numbers(container, output_buffer))
+    {
+        goto fail;
+    }
+
+element:
+    if (frame->current == NULL)
     {
-        *output_pointer++ = '\n';
+        goto close;
     }
-    output_buffer->offset += length;
 
-    while (current_item)
+    if ((frame->container->type & 0xFF) == cJSON_Object)
     {
         if (output_buffer->format)
         {
@@ -1775,7 +6212,7 @@ static cJSON_bool print_object(const cJSON * const item, printbuffer * const out
             output_pointer = ensure(output_buffer, output_buffer->depth);
             if (output_pointer == NULL)
             {
-                return false;
+                goto fail;
             }
             for (i = 0; i < output_buffer->depth; i++)
             {
@@ -1785,9 +6222,9 @@ static cJSON_bool print_object(const cJSON * const item, printbuffer * const out
         }
 
         /* print key */
-        if (!print_string_ptr((unsigned char*)current_item->string, output_buffer))
+        if (!print_string_ptr((unsigned char*)frame->current->string, output_buffer))
         {
-            return false;
+            goto fail;
         }
         update_offset(output_buffer);
 
@@ -1795,7 +6232,7 @@ static cJSON_bool print_object(const cJSON * const item, printbuffer * const out
         output_pointer = ensure(output_buffer, length);
         if (output_pointer == NULL)
         {
-            return false;
+            goto fail;
         }
         *output_pointer++ = ':';
         if (output_buffer->format)
@@ -1803,59 +6240,153 @@ static cJSON_bool print_object(const cJSON * const item, printbuffer * const out
             *output_pointer++ = '\t';
         }
         output_buffer->offset += length;
+    }
 
-        /* print value */
-        if (!print_value(current_item, output_buffer))
-        {
-            return false;
-        }
-        update_offset(output_buffer);
+    /* print value, arrays and objects get a frame of their own */
+    if (((frame->current->type & 0xFF) == cJSON_Array) || ((frame->current->type & 0xFF) == cJSON_Object))
+    {
+        container = frame->current;
+        goto open;
+    }
+    if (!print_value(frame->current, output_buffer))
+    {
+        goto fail;
+    }
 
-        /* print comma if not last */
-        length = ((size_t)(output_buffer->format ? 1 : 0) + (size_t)(current_item->next ? 1 : 0));
+value_done:
+    update_offset(output_buffer);
+
+    /* print comma if not last */
+    if ((frame->container->type & 0xFF) == cJSON_Object)
+    {
+        length = ((size_t)(output_buffer->format ? 1 : 0) + (size_t)(frame->current->next ? 1 : 0));
         output_pointer = ensure(output_buffer, length + 1);
         if (output_pointer == NULL)
         {
-            return false;
+            goto fail;
         }
-        if (current_item->next)
+        if (frame->current->next)
         {
             *output_pointer++ = ',';
         }
-
         if (output_buffer->format)
         {
             *output_pointer++ = '\n';
         }
         *output_pointer = '\0';
         output_buffer->offset += length;
-
-        current_item = current_item->next;
     }
+    else if (frame->current->next)
+    {
+        length = (size_t) (output_buffer->format ? 2 : 1);
+        output_pointer = ensure(output_buffer, length + 1);
+        if (output_pointer == NULL)
+        {
+            goto fail;
+        }
+        *output_pointer++ = ',';
+        if (output_buffer->format)
+        {
+            *output_pointer++ = ' ';
+        }
+        *output_pointer = '\0';
+        output_buffer->offset += length;
+    }
+    frame->current = frame->current->next;
+    goto element;
 
-    output_pointer = ensure(output_buffer, output_buffer->format ? (output_buffer->depth + 1) : 2);
-    if (output_pointer == NULL)
+close:
+    if ((frame->container->type & 0xFF) == cJSON_Object)
     {
-        return false;
+        output_pointer = ensure(output_buffer, output_buffer->format ? (output_buffer->depth + 1) : 2);
+        if (output_pointer == NULL)
+        {
+            goto fail;
+        }
+        if (output_buffer->format)
+        {
+            size_t i;
+            for (i = 0; i < (output_buffer->depth - 1); i++)
+            {
+                *output_pointer++ = '\t';
+            }
+        }
+        *output_pointer++ = '}';
     }
-    if (output_buffer->format)
+    else
     {
-        size_t i;
-        for (i = 0; i < (output_buffer->depth - 1); i++)
+        output_pointer = ensure(output_buffer, 2);
+        if (output_pointer == NULL)
         {
-            *output_pointer++ = '\t';
+            goto fail;
         }
+        *output_pointer++ = ']';
     }
-    *output_pointer++ = '}';
     *output_pointer = '\0';
     output_buffer->depth--;
 
+    /* continue with the enclosing array or object, the caller advances past the outermost bracket */
+    count--;
+    if (count > 0)
+    {
+        frame = &frames[count - 1];
+        goto value_done;
+    }
+
+    if (frames != inline_frames)
+    {
+        output_buffer->hooks.deallocate(frames);
+    }
+
     return true;
+
+fail:
+    if (frames != inline_frames)
+    {
+        output_buffer->hooks.deallocate(frames);
+    }
+
+    return false;
+}
+
+/* copy on write for cJSON_DuplicateShared, defined with the duplication functions */
+static cJSON_bool unshare(cJSON * const item, cJSON ** const member);
+
+/* Items found in shared children could be changed through the pointer that is returned, so the
+ * container gets its own children first, see cJSON_DuplicateShared. A packed array is expanded into
+ * the items it would have. */
+static cJSON_bool own_children(const cJSON * const item)
+{
+    if ((item->type & cJSON_IsReference) || !(item->type & (cJSON_IsShared | cJSON_PackedNumberArray)))
+    {
+        return true;
+    }
+
+    return unshare((cJSON*)cast_away_const(item), NULL);
+}
+
+/* a lookup walked that many children of item, which has no index that is up to date: build one if that was a lot */
+static void index_after_walk(const cJSON * const item, const struct cJSON_Index * const index, const size_t walked)
+{
+    if ((walked < CJSON_INDEX_THRESHOLD) || ((index != NULL) && index_current(item, index)))
+    {
+        return;
+    }
+
+    if ((item->type & 0xFF) == cJSON_Object)
+    {
+        index_build((cJSON*)cast_away_const(item));
+    }
+    else if ((item->type & 0xFF) == cJSON_Array)
+    {
+        index_build_array((cJSON*)cast_away_const(item));
+    }
 }
 
 /* Get Array size/item / object item. */
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 {
+    const struct cJSON_Index *index = NULL;
     cJSON *child = NULL;
     size_t size = 0;
 
@@ -1864,6 +6395,17 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
         return 0;
     }
 
+    if (array->type & cJSON_PackedNumberArray)
+    {
+        return (int)packed_numbers_of(array)->count;
+    }
+
+    index = index_of(array);
+    if ((index != NULL) && (index->items != NULL) && index_current(array, index))
+    {
+        return (int)index->count;
+    }
+
     child = array->child;
 
     while(child != NULL)
@@ -1871,6 +6413,7 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
         size++;
         child = child->next;
     }
+    index_after_walk(array, index, size);
 
     /* FIXME: Can overflow here. Cannot be fixed without breaking the API */
 
@@ -1879,19 +6422,40 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 
 static cJSON* get_array_item(const cJSON *array, size_t index)
 {
+    const struct cJSON_Index *vector = NULL;
     cJSON *current_child = NULL;
+    size_t walked = 0;
 
-    if (array == NULL)
+    if ((array == NULL) || !own_children(array))
     {
         return NULL;
     }
 
+    vector = index_of(array);
+    if ((vector != NULL) && (vector->items != NULL) && index_current(array, vector))
+    {
+        if (index >= vector->count)
+        {
+            return NULL;
+        }
+        current_child = vector->items[index];
+        /* the neighbours have to agree, or the children were relinked by hand */
+        if (index_linked(array, current_child)
+                && ((index == 0) || (current_child->prev == vector->items[index - 1]))
+                && (((index + 1) == vector->count) ? (current_child->next == NULL) : (current_child->next == vector->items[index + 1])))
+        {
+            return current_child;
+        }
+    }
+
     current_child = array->child;
     while ((current_child != NULL) && (index > 0))
     {
         index--;
+        walked++;
         current_child = current_child->next;
     }
+    index_after_walk(array, vector, walked);
 
     return current_child;
 }
@@ -1906,20 +6470,39 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
     return get_array_item(array, (size_t)index);
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_GetChild(const cJSON *item)
+{
+    if ((item == NULL) || !own_children(item))
+    {
+        return NULL;
+    }
+
+    return item->child;
+}
+
 static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
 {
+    const struct cJSON_Index *index = NULL;
     cJSON *current_element = NULL;
+    size_t walked = 0;
 
-    if ((object == NULL) || (name == NULL))
+    if ((object == NULL) || (name == NULL) || !own_children(object))
     {
         return NULL;
     }
 
+    index = index_of(object);
+    if ((index != NULL) && index_lookup(object, index, name, case_sensitive, &current_element))
+    {
+        return current_element;
+    }
+
     current_element = object->child;
     if (case_sensitive)
     {
         while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
         {
+            walked++;
             current_element = current_element->next;
         }
     }
@@ -1927,9 +6510,12 @@ static cJSON *get_object_item(const cJSON * const object, const char * const nam
     {
         while ((current_element != NULL) && (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(current_element->string)) != 0))
         {
+            walked++;
             current_element = current_element->next;
         }
     }
+    /* the index doesn't change any children, current_element stays what was found */
+    index_after_walk(object, index, walked);
 
     if ((current_element == NULL) || (current_element->string == NULL)) {
         return NULL;
@@ -1968,6 +6554,16 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
     {
         return NULL;
     }
+    if ((item->type & cJSON_PackedNumberArray) && !unpack_array((cJSON*)cast_away_const(item)))
+    {
+        /* the reference needs items to point to */
+        return NULL;
+    }
+    if (!own_children(item))
+    {
+        /* the reference has to see the children of item, not those of another copy */
+        return NULL;
+    }
 
     reference = cJSON_New_Item(hooks);
     if (reference == NULL)
@@ -1978,6 +6574,12 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
     memcpy(reference, item, sizeof(cJSON));
     reference->string = NULL;
     reference->type |= cJSON_IsReference;
+    /* the index belongs to the original, the reference itself is not in any shared children */
+    reference->type &= ~(cJSON_IsArenaItem | cJSON_IsIndexed);
+    if (item->type & cJSON_IsIndexed)
+    {
+        reference->valuestring = NULL;
+    }
     reference->next = reference->prev = NULL;
     return reference;
 }
@@ -1986,11 +6588,12 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
 {
     cJSON *child = NULL;
 
-    if ((item == NULL) || (array == NULL) || (array == item))
+    if ((item == NULL) || (array == NULL) || (array == item) || !unshare(array, NULL))
     {
         return false;
     }
 
+    index_check(array);
     child = array->child;
     /*
      * To find the last item in array quickly, we use prev in array
@@ -2011,6 +6614,7 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
             array->child->prev = item;
         }
     }
+    index_insert(array, item);
 
     return true;
 }
@@ -2046,6 +6650,11 @@ static cJSON_bool add_item_to_object(cJSON * const object, const char * const st
     {
         return false;
     }
+    if (!unshare(object, NULL))
+    {
+        /* don't touch the key of an item that can't be added */
+        return false;
+    }
 
     if (constant_key)
     {
@@ -2062,10 +6671,16 @@ static cJSON_bool add_item_to_object(cJSON * const object, const char * const st
 
         new_type = item->type & ~cJSON_StringIsConst;
     }
+    new_type &= ~cJSON_StringIsInterned;
 
-    if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+    if (item->string != new_key)
     {
-        hooks->deallocate(item->string);
+        delete_key(item, hooks);
+    }
+    else
+    {
+        /* added again under its own key, the reference stays */
+        new_type |= item->type & cJSON_StringIsInterned;
     }
 
     item->string = new_key;
@@ -2087,22 +6702,41 @@ CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObjectCS(cJSON *object, const char *stri
 
 CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToArray(cJSON *array, cJSON *item)
 {
+    cJSON *reference = NULL;
+
     if (array == NULL)
     {
         return false;
     }
 
-    return add_item_to_array(array, create_reference(item, &global_hooks));
+    reference = create_reference(item, &global_hooks);
+    if (add_item_to_array(array, reference))
+    {
+        return true;
+    }
+
+    /* e.g. out of memory, the reference doesn't own anything else */
+    cJSON_Delete(reference);
+    return false;
 }
 
 CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToObject(cJSON *object, const char *string, cJSON *item)
 {
+    cJSON *reference = NULL;
+
     if ((object == NULL) || (string == NULL))
     {
         return false;
     }
 
-    return add_item_to_object(object, string, create_reference(item, &global_hooks), &global_hooks, false);
+    reference = create_reference(item, &global_hooks);
+    if (add_item_to_object(object, string, reference, &global_hooks, false))
+    {
+        return true;
+    }
+
+    cJSON_Delete(reference);
+    return false;
 }
 
 CJSON_PUBLIC(cJSON*) cJSON_AddNullToObject(cJSON * const object, const char * const name)
@@ -2213,13 +6847,20 @@ CJSON_PUBLIC(cJSON*) cJSON_AddArrayToObject(cJSON * const object, const char * c
     return NULL;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const item)
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON *item)
 {
     if ((parent == NULL) || (item == NULL) || (item != parent->child && item->prev == NULL))
     {
         return NULL;
     }
 
+    /* a shared child is detached from the copy of the children */
+    if (!unshare(parent, &item))
+    {
+        return NULL;
+    }
+
+    index_check(parent);
     if (item != parent->child)
     {
         /* not the first element */
@@ -2245,10 +6886,22 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
     /* make sure the detached item doesn't point anywhere anymore */
     item->prev = NULL;
     item->next = NULL;
+    index_remove(parent, item);
 
     return item;
 }
 
+/* the items of an array that is about to be changed, a packed array is expanded for them */
+static cJSON *get_array_item_to_change(cJSON * const array, const size_t index)
+{
+    if ((array != NULL) && (array->type & cJSON_PackedNumberArray) && !unshare(array, NULL))
+    {
+        return NULL;
+    }
+
+    return get_array_item(array, index);
+}
+
 CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromArray(cJSON *array, int which)
 {
     if (which < 0)
@@ -2256,7 +6909,7 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromArray(cJSON *array, int which)
         return NULL;
     }
 
-    return cJSON_DetachItemViaPointer(array, get_array_item(array, (size_t)which));
+    return cJSON_DetachItemViaPointer(array, get_array_item_to_change(array, (size_t)which));
 }
 
 CJSON_PUBLIC(void) cJSON_DeleteItemFromArray(cJSON *array, int which)
@@ -2297,6 +6950,10 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
     {
         return false;
     }
+    if ((array != NULL) && (array->type & cJSON_PackedNumberArray) && !unshare(array, NULL))
+    {
+        return false;
+    }
 
     after_inserted = get_array_item(array, (size_t)which);
     if (after_inserted == NULL)
@@ -2309,6 +6966,12 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
         return false;
     }
 
+    if (!unshare(array, &after_inserted))
+    {
+        return false;
+    }
+
+    index_check(array);
     newitem->next = after_inserted;
     newitem->prev = after_inserted->prev;
     after_inserted->prev = newitem;
@@ -2320,10 +6983,11 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
     {
         newitem->prev->next = newitem;
     }
+    index_insert(array, newitem);
     return true;
 }
 
-CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON * const item, cJSON * replacement)
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON *item, cJSON * replacement)
 {
     if ((parent == NULL) || (parent->child == NULL) || (replacement == NULL) || (item == NULL))
     {
@@ -2334,7 +6998,12 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
     {
         return true;
     }
+    if (!unshare(parent, &item))
+    {
+        return false;
+    }
 
+    index_check(parent);
     replacement->next = item->next;
     replacement->prev = item->prev;
 
@@ -2367,6 +7036,8 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
 
     item->next = NULL;
     item->prev = NULL;
+    index_remove(parent, item);
+    index_insert(parent, replacement);
     cJSON_Delete(item);
 
     return true;
@@ -2379,7 +7050,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON
         return false;
     }
 
-    return cJSON_ReplaceItemViaPointer(array, get_array_item(array, (size_t)which), newitem);
+    return cJSON_ReplaceItemViaPointer(array, get_array_item_to_change(array, (size_t)which), newitem);
 }
 
 static cJSON_bool replace_item_in_object(cJSON *object, const char *string, cJSON *replacement, cJSON_bool case_sensitive)
@@ -2390,18 +7061,13 @@ static cJSON_bool replace_item_in_object(cJSON *object, const char *string, cJSO
     }
 
     /* replace the name in the replacement */
-    if (!(replacement->type & cJSON_StringIsConst) && (replacement->string != NULL))
-    {
-        cJSON_free(replacement->string);
-    }
+    delete_key(replacement, &global_hooks);
     replacement->string = (char*)cJSON_strdup((const unsigned char*)string, &global_hooks);
     if (replacement->string == NULL)
     {
         return false;
     }
 
-    replacement->type &= ~cJSON_StringIsConst;
-
     return cJSON_ReplaceItemViaPointer(object, get_object_item(object, string, case_sensitive), replacement);
 }
 
@@ -2466,20 +7132,30 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateNumber(double num)
     if(item)
     {
         item->type = cJSON_Number;
-        item->valuedouble = num;
+        set_number(item, num, CJSON_INT64_LIMIT);
+    }
 
-        /* use saturation in case of overflow */
-        if (num >= INT_MAX)
-        {
-            item->valueint = INT_MAX;
-        }
-        else if (num <= (double)INT_MIN)
-        {
-            item->valueint = INT_MIN;
-        }
-        else
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateInt64(cJSON_int64 num)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = cJSON_Number;
+        set_number(item, (double)num, CJSON_INT64_LIMIT);
+        item->type |= cJSON_IsInt64;
+        if (integer_rounded(num, item->valuedouble))
         {
-            item->valueint = (int)num;
+            /* the double had to round */
+            item->valuestring = (char*)global_hooks.allocate(sizeof(cJSON_int64));
+            if (item->valuestring == NULL)
+            {
+                cJSON_Delete(item);
+                return NULL;
+            }
+            memcpy(item->valuestring, &num, sizeof(cJSON_int64));
         }
     }
 
@@ -2733,101 +7409,552 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateStringArray(const char *const *strings, int co
         a->child->prev = n;
     }
 
-    return a;
-}
-
-/* Duplication */
-cJSON * cJSON_Duplicate_rec(const cJSON *item, size_t depth, cJSON_bool recurse);
+    return a;
+}
+
+static cJSON *create_packed_array(packed_numbers * const packed)
+{
+    cJSON *array = NULL;
+
+    if (packed == NULL)
+    {
+        return NULL;
+    }
+
+    array = cJSON_New_Item(&global_hooks);
+    if (array == NULL)
+    {
+        global_hooks.deallocate(packed);
+        return NULL;
+    }
+    array->type = cJSON_Array | cJSON_PackedNumberArray;
+    array->valuestring = (char*)packed;
+
+    return array;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreatePackedDoubleArray(const double *numbers, int count)
+{
+    packed_numbers *packed = NULL;
+    size_t i = 0;
+
+    if ((count < 0) || (numbers == NULL))
+    {
+        return NULL;
+    }
+    if (count == 0)
+    {
+        return cJSON_CreateArray();
+    }
+
+    packed = packed_numbers_new((size_t)count, false);
+    for (i = 0; packed && (i < (size_t)count); i++)
+    {
+        packed->values[i].number = numbers[i];
+    }
+
+    return create_packed_array(packed);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreatePackedInt64Array(const cJSON_int64 *numbers, int count)
+{
+    packed_numbers *packed = NULL;
+    size_t i = 0;
+
+    if ((count < 0) || (numbers == NULL))
+    {
+        return NULL;
+    }
+    if (count == 0)
+    {
+        return cJSON_CreateArray();
+    }
+
+    packed = packed_numbers_new((size_t)count, true);
+    for (i = 0; packed && (i < (size_t)count); i++)
+    {
+        packed->values[i].integer = numbers[i];
+    }
+
+    return create_packed_array(packed);
+}
+
+/* copy the numbers of an array into doubles or integers, whichever isn't NULL */
+static int get_numbers(const cJSON * const array, double * const doubles, cJSON_int64 * const integers, const int count)
+{
+    const packed_numbers *packed = NULL;
+    const cJSON *child = NULL;
+    const cJSON *element = NULL;
+    cJSON number;
+    size_t i = 0;
+
+    if (!cJSON_IsArray(array) || (count < 0))
+    {
+        return -1;
+    }
+
+    if ((array->type & cJSON_PackedNumberArray) && (packed_numbers_of(array)->integers == (integers != NULL)))
+    {
+        /* no conversion needed */
+        packed = packed_numbers_of(array);
+        for (i = 0; (i < (size_t)count) && (i < packed->count); i++)
+        {
+            if (doubles != NULL)
+            {
+                doubles[i] = packed->values[i].number;
+            }
+            else
+            {
+                integers[i] = packed->values[i].integer;
+            }
+        }
+        return (int)i;
+    }
+
+    child = array->child;
+    for (i = 0; i < (size_t)count; i++)
+    {
+        element = array_element(array, i, &child, &number);
+        if (element == NULL)
+        {
+            break;
+        }
+        if (!cJSON_IsNumber(element))
+        {
+            return -1;
+        }
+        if (doubles != NULL)
+        {
+            doubles[i] = element->valuedouble;
+        }
+        else
+        {
+            integers[i] = cJSON_GetInt64Value(element);
+        }
+    }
+
+    return (int)i;
+}
+
+CJSON_PUBLIC(int) cJSON_GetDoubleArray(const cJSON *array, double *numbers, int count)
+{
+    if (numbers == NULL)
+    {
+        return -1;
+    }
+
+    return get_numbers(array, numbers, NULL, count);
+}
+
+CJSON_PUBLIC(int) cJSON_GetInt64Array(const cJSON *array, cJSON_int64 *numbers, int count)
+{
+    if (numbers == NULL)
+    {
+        return -1;
+    }
+
+    return get_numbers(array, NULL, numbers, count);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_GetPackedNumber(const cJSON *array, int index, cJSON *number)
+{
+    if ((array == NULL) || (number == NULL) || (index < 0) || !(array->type & cJSON_PackedNumberArray))
+    {
+        return false;
+    }
+    if ((size_t)index >= packed_numbers_of(array)->count)
+    {
+        return false;
+    }
+
+    packed_number(packed_numbers_of(array), (size_t)index, number);
+    return true;
+}
+
+/* Duplication */
+cJSON * cJSON_Duplicate_rec(const cJSON *item, size_t depth, cJSON_bool recurse);
+
+CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
+{
+    return cJSON_Duplicate_rec(item, 0, recurse );
+}
+
+/* copy a single item without its children */
+static cJSON *duplicate_item(const cJSON * const item)
+{
+    cJSON *newitem = cJSON_New_Item(&global_hooks);
+    if (!newitem)
+    {
+        return NULL;
+    }
+    /* Copy over all vars */
+    newitem->type = item->type & (~(cJSON_IsReference | cJSON_IsArenaItem | cJSON_IsShared | cJSON_IsIndexed));
+    newitem->valueint = item->valueint;
+    newitem->valuedouble = item->valuedouble;
+    if ((item->type & 0xFF) == cJSON_Number)
+    {
+        /* the exact value of a big integer */
+        if (item->valuestring != NULL)
+        {
+            newitem->valuestring = (char*)global_hooks.allocate(sizeof(cJSON_int64));
+            if (!newitem->valuestring)
+            {
+                goto fail;
+            }
+            memcpy(newitem->valuestring, item->valuestring, sizeof(cJSON_int64));
+        }
+    }
+    else if (item->type & cJSON_PackedNumberArray)
+    {
+        newitem->valuestring = (char*)global_hooks.allocate(packed_numbers_size(packed_numbers_of(item)->count));
+        if (!newitem->valuestring)
+        {
+            goto fail;
+        }
+        memcpy(newitem->valuestring, item->valuestring, packed_numbers_size(packed_numbers_of(item)->count));
+    }
+    /* the valuestring of a shared or indexed array or object is its share count or index */
+    else if (item->valuestring && !(item->type & (cJSON_IsShared | cJSON_IsIndexed)))
+    {
+        newitem->valuestring = (char*)cJSON_strdup((unsigned char*)item->valuestring, &global_hooks);
+        if (!newitem->valuestring)
+        {
+            goto fail;
+        }
+    }
+    if (item->string)
+    {
+        /* constant keys of arena items are arena memory, they can't be shared */
+        if ((item->type & cJSON_StringIsConst) && !(item->type & cJSON_IsArenaItem))
+        {
+            newitem->string = item->string;
+            if (item->type & cJSON_StringIsInterned)
+            {
+                interned_key_of(item->string)->references++;
+            }
+        }
+        else
+        {
+            newitem->string = (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+            newitem->type &= ~cJSON_StringIsConst;
+        }
+        if (!newitem->string)
+        {
+            goto fail;
+        }
+    }
+
+    return newitem;
+
+fail:
+    cJSON_Delete(newitem);
+
+    return NULL;
+}
+
+/* an array or object whose children are being copied */
+typedef struct
+{
+    const cJSON *child; /* next child to copy */
+    cJSON *newitem;
+    cJSON *last; /* last copy added to newitem */
+    size_t references; /* references on the way down to newitem, only they can lead around in circles */
+} duplicate_frame;
+
+cJSON * cJSON_Duplicate_rec(const cJSON *item, size_t depth, cJSON_bool recurse)
+{
+    duplicate_frame inline_frames[INLINE_STACK_FRAMES];
+    duplicate_frame *frames = inline_frames;
+    duplicate_frame *frame = NULL;
+    size_t capacity = INLINE_STACK_FRAMES;
+    size_t count = 0;
+    cJSON *newitem = NULL;
+    cJSON *newchild = NULL;
+
+    /* Bail on bad ptr */
+    if (!item)
+    {
+        goto fail;
+    }
+    /* Create new item */
+    newitem = duplicate_item(item);
+    if (!newitem)
+    {
+        goto fail;
+    }
+    /* If non-recursive, then we're done! */
+    if (!recurse || (item->child == NULL))
+    {
+        return newitem;
+    }
+
+    /* Walk the ->next chains depth first, with a frame for every array and object on the way down */
+    frames[0].child = item->child;
+    frames[0].newitem = newitem;
+    frames[0].last = NULL;
+    frames[0].references = (item->type & cJSON_IsReference) ? 1 : 0;
+    count = 1;
+    while (count > 0)
+    {
+        frame = &frames[count - 1];
+        if (frame->child == NULL)
+        {
+            /* all children copied */
+            if (frame->newitem->child != NULL)
+            {
+                frame->newitem->child->prev = frame->last;
+            }
+            count--;
+            continue;
+        }
+
+        newchild = duplicate_item(frame->child);
+        if (!newchild)
+        {
+            goto fail;
+        }
+        if (frame->last != NULL)
+        {
+            /* If newitem->child already set, then crosswire ->prev and ->next and move on */
+            frame->last->next = newchild;
+            newchild->prev = frame->last;
+        }
+        else
+        {
+            /* Set newitem->child and move to it */
+            frame->newitem->child = newchild;
+        }
+        frame->last = newchild;
+
+        if (frame->child->child != NULL)
+        {
+            /* copy the children of this child before its siblings */
+            const cJSON *grandchild = frame->child->child;
+            const size_t references = frame->references + ((frame->child->type & cJSON_IsReference) ? 1 : 0);
+            if ((depth + references) >= CJSON_CIRCULAR_LIMIT)
+            {
+                goto fail;
+            }
+            frame->child = frame->child->next;
+            if (count == capacity)
+            {
+                duplicate_frame *grown = (duplicate_frame*)grow_stack(frames, &capacity, sizeof(duplicate_frame), inline_frames, &global_hooks);
+                if (grown == NULL)
+                {
+                    goto fail;
+                }
+                frames = grown;
+            }
+            frames[count].child = grandchild;
+            frames[count].newitem = newchild;
+            frames[count].last = NULL;
+            frames[count].references = references;
+            count++;
+        }
+        else
+        {
+            frame->child = frame->child->next;
+        }
+    }
+
+    if (frames != inline_frames)
+    {
+        global_hooks.deallocate(frames);
+    }
+
+    return newitem;
+
+fail:
+    /* close the unfinished lists, then delete everything copied so far */
+    while (count > 0)
+    {
+        frame = &frames[--count];
+        if (frame->newitem->child != NULL)
+        {
+            frame->newitem->child->prev = frame->last;
+        }
+    }
+    if (frames != inline_frames)
+    {
+        global_hooks.deallocate(frames);
+    }
+    if (newitem != NULL)
+    {
+        cJSON_Delete(newitem);
+    }
+
+    return NULL;
+}
+
+/* Copy on write. Arrays and objects with cJSON_IsShared have the same child list, which is copied
+ * one level deep by the first function that changes one of them. References and arena items
+ * don't own their memory, they are always copied. */
+static cJSON_bool can_share(const cJSON * const item)
+{
+    if (item->type & (cJSON_IsReference | cJSON_IsArenaItem))
+    {
+        return false;
+    }
+    if (((item->type & 0xFF) != cJSON_Array) && ((item->type & 0xFF) != cJSON_Object))
+    {
+        return false;
+    }
+
+    return (item->child != NULL) && ((item->type & (cJSON_IsShared | cJSON_IsIndexed)) || (item->valuestring == NULL));
+}
+
+/* let copy use the children of source */
+static cJSON_bool share_children(cJSON * const source, cJSON * const copy)
+{
+    shared_children *shared = NULL;
+
+    if (source->type & cJSON_IsShared)
+    {
+        shared = shared_children_of(source);
+    }
+    else
+    {
+        shared = (shared_children*)global_hooks.allocate(sizeof(shared_children));
+        if (shared == NULL)
+        {
+            return false;
+        }
+        /* the valuestring holds the share count from now on */
+        index_free(source);
+        shared->references = 1;
+        source->valuestring = (char*)shared;
+        source->type |= cJSON_IsShared;
+    }
+
+    shared->references++;
+    copy->child = source->child;
+    copy->valuestring = (char*)shared;
+    copy->type |= cJSON_IsShared;
 
-CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
-{
-    return cJSON_Duplicate_rec(item, 0, recurse );
+    return true;
 }
 
-cJSON * cJSON_Duplicate_rec(const cJSON *item, size_t depth, cJSON_bool recurse)
+/* give item its own children, *member is moved to its copy if it is one of the old children */
+static cJSON_bool unshare(cJSON * const item, cJSON ** const member)
 {
-    cJSON *newitem = NULL;
-    cJSON *child = NULL;
-    cJSON *next = NULL;
-    cJSON *newchild = NULL;
+    shared_children *shared = NULL;
+    const cJSON *child = NULL;
+    cJSON *head = NULL;
+    cJSON *last = NULL;
+    cJSON *copy = NULL;
+    cJSON *moved = NULL;
 
-    /* Bail on bad ptr */
-    if (!item)
+    if (item->type & cJSON_PackedNumberArray)
     {
-        goto fail;
+        /* changing a packed array needs its items, a reference can't expand its original */
+        return !(item->type & cJSON_IsReference) && unpack_array(item);
     }
-    /* Create new item */
-    newitem = cJSON_New_Item(&global_hooks);
-    if (!newitem)
+    if ((item->type & (cJSON_IsShared | cJSON_IsReference)) != cJSON_IsShared)
     {
-        goto fail;
+        return true;
     }
-    /* Copy over all vars */
-    newitem->type = item->type & (~cJSON_IsReference);
-    newitem->valueint = item->valueint;
-    newitem->valuedouble = item->valuedouble;
-    if (item->valuestring)
+
+    shared = shared_children_of(item);
+    if (shared->references == 1)
     {
-        newitem->valuestring = (char*)cJSON_strdup((unsigned char*)item->valuestring, &global_hooks);
-        if (!newitem->valuestring)
-        {
-            goto fail;
-        }
+        /* the other copies are gone, the children are already item's own */
+        global_hooks.deallocate(shared);
+        item->valuestring = NULL;
+        item->type &= ~cJSON_IsShared;
+        return true;
     }
-    if (item->string)
+
+    for (child = item->child; child != NULL; child = child->next)
     {
-        newitem->string = (item->type&cJSON_StringIsConst) ? item->string : (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
-        if (!newitem->string)
+        if (can_share(child))
         {
-            goto fail;
+            /* the grandchildren stay shared */
+            copy = duplicate_item(child);
+            if ((copy != NULL) && !share_children((cJSON*)cast_away_const(child), copy))
+            {
+                cJSON_Delete(copy);
+                copy = NULL;
+            }
         }
-    }
-    /* If non-recursive, then we're done! */
-    if (!recurse)
-    {
-        return newitem;
-    }
-    /* Walk the ->next chain for the child. */
-    child = item->child;
-    while (child != NULL)
-    {
-        if(depth >= CJSON_CIRCULAR_LIMIT) {
-            goto fail;
+        else
+        {
+            copy = cJSON_Duplicate_rec(child, 0, true);
         }
-        newchild = cJSON_Duplicate_rec(child, depth + 1, true); /* Duplicate (with recurse) each item in the ->next chain */
-        if (!newchild)
+        if (copy == NULL)
         {
             goto fail;
         }
-        if (next != NULL)
+
+        if (last == NULL)
         {
-            /* If newitem->child already set, then crosswire ->prev and ->next and move on */
-            next->next = newchild;
-            newchild->prev = next;
-            next = newchild;
+            head = copy;
         }
         else
         {
-            /* Set newitem->child and move to it */
-            newitem->child = newchild;
-            next = newchild;
+            suffix_object(last, copy);
+        }
+        last = copy;
+        if ((member != NULL) && (*member == child))
+        {
+            moved = copy;
         }
-        child = child->next;
     }
-    if (newitem && newitem->child)
+    head->prev = last;
+
+    shared->references--;
+    index_free(item);
+    item->child = head;
+    item->valuestring = NULL;
+    item->type &= ~cJSON_IsShared;
+    if (moved != NULL)
     {
-        newitem->child->prev = newchild;
+        *member = moved;
     }
 
-    return newitem;
+    return true;
 
 fail:
-    if (newitem != NULL)
+    /* item stays shared */
+    cJSON_Delete(head);
+
+    return false;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_DuplicateShared(cJSON *item)
+{
+    cJSON *copy = NULL;
+
+    if (item == NULL)
     {
-        cJSON_Delete(newitem);
+        return NULL;
+    }
+    if (!can_share(item))
+    {
+        return cJSON_Duplicate(item, true);
     }
 
-    return NULL;
+    copy = duplicate_item(item);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    if (!share_children(item, copy))
+    {
+        cJSON_Delete(copy);
+        return NULL;
+    }
+
+    return copy;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_Unshare(cJSON *item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return unshare(item, NULL);
 }
 
 static void skip_oneline_comment(char **input)
@@ -2857,74 +7984,471 @@ static void skip_multiline_comment(char **input)
     }
 }
 
-static void minify_string(char **input, char **output) {
-    (*output)[0] = (*input)[0];
-    *input += static_strlen("\"");
-    *output += static_strlen("\"");
+/* Minifying works on blocks of 64 bytes, with one bit per byte for whitespace, quotes, backslashes and slashes.
+ * Which bytes are escaped and which are inside of strings follows from those masks, so the bytes to keep
+ * are known without a branch per byte and get packed together with a shuffle table.
+ * A block with a slash outside of a string might start a comment and is minified byte by byte instead. */
+#define MINIFY_BLOCK_SIZE 64
+
+typedef struct
+{
+    unsigned char *json;
+    size_t length;
+    /* offsets of the next byte to read and to write */
+    size_t read;
+    size_t write;
+    cJSON_bool in_string;
+    /* the next byte follows an unescaped backslash */
+    cJSON_bool escaped;
+} minify_buffer;
+
+typedef struct
+{
+    cjson_uint64 whitespace;
+    cjson_uint64 quote;
+    cjson_uint64 backslash;
+    cjson_uint64 slash;
+} minify_masks;
+
+#ifndef CJSON_SSE2
+static void classify_block_portable(const unsigned char * const block, minify_masks * const masks)
+{
+    size_t i = 0;
+
+    memset(masks, 0, sizeof(*masks));
+    for (i = 0; i < MINIFY_BLOCK_SIZE; i++)
+    {
+        const cjson_uint64 bit = (cjson_uint64)1 << i;
+        switch (block[i])
+        {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                masks->whitespace |= bit;
+                break;
 
+            case '\"':
+                masks->quote |= bit;
+                break;
 
-    for (; (*input)[0] != '\0'; (void)++(*input), ++(*output)) {
-        (*output)[0] = (*input)[0];
+            case '\\':
+                masks->backslash |= bit;
+                break;
 
-        if ((*input)[0] == '\"') {
-            (*output)[0] = '\"';
-            *input += static_strlen("\"");
-            *output += static_strlen("\"");
-            return;
-        } else if (((*input)[0] == '\\') && ((*input)[1] == '\"')) {
-            (*output)[1] = (*input)[1];
-            *input += static_strlen("\"");
-            *output += static_strlen("\"");
+            case '/':
+                masks->slash |= bit;
+                break;
+
+            default:
+                break;
         }
     }
 }
+#endif
 
-CJSON_PUBLIC(void) cJSON_Minify(char *json)
+#ifdef CJSON_SSE2
+static void classify_block_sse2(const unsigned char * const block, minify_masks * const masks)
 {
-    char *into = json;
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i carriage_return = _mm_set1_epi8('\r');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i slash = _mm_set1_epi8('/');
+    size_t i = 0;
 
-    if (json == NULL)
+    memset(masks, 0, sizeof(*masks));
+    for (i = 0; i < MINIFY_BLOCK_SIZE; i += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(block + i));
+        const __m128i whitespace = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, carriage_return), _mm_cmpeq_epi8(chunk, newline)));
+        masks->whitespace |= (cjson_uint64)(unsigned int)_mm_movemask_epi8(whitespace) << i;
+        masks->quote |= (cjson_uint64)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)) << i;
+        masks->backslash |= (cjson_uint64)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)) << i;
+        masks->slash |= (cjson_uint64)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, slash)) << i;
+    }
+}
+#endif
+
+#ifdef CJSON_AVX2
+__attribute__((target("avx2")))
+static void classify_block_avx2(const unsigned char * const block, minify_masks * const masks)
+{
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i carriage_return = _mm256_set1_epi8('\r');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i slash = _mm256_set1_epi8('/');
+    size_t i = 0;
+
+    memset(masks, 0, sizeof(*masks));
+    for (i = 0; i < MINIFY_BLOCK_SIZE; i += 32)
+    {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(block + i));
+        const __m256i whitespace = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, tab)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, carriage_return), _mm256_cmpeq_epi8(chunk, newline)));
+        masks->whitespace |= (cjson_uint64)(unsigned int)_mm256_movemask_epi8(whitespace) << i;
+        masks->quote |= (cjson_uint64)(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, quote)) << i;
+        masks->backslash |= (cjson_uint64)(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslash)) << i;
+        masks->slash |= (cjson_uint64)(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, slash)) << i;
+    }
+}
+#endif
+
+static void classify_block(const unsigned char * const block, minify_masks * const masks)
+{
+#ifdef CJSON_AVX2
+    if (cpu_has_avx2 < 0)
+    {
+        cpu_has_avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    if (cpu_has_avx2)
     {
+        classify_block_avx2(block, masks);
         return;
     }
+#endif
+#ifdef CJSON_SSE2
+    classify_block_sse2(block, masks);
+#else
+    classify_block_portable(block, masks);
+#endif
+}
+
+#define MINIFY_EVEN_BITS (((cjson_uint64)0x55555555UL << 32) | (cjson_uint64)0x55555555UL)
+
+/* bytes that follow an odd run of backslashes, *carry is set when such a run reaches the end of the block */
+static cjson_uint64 find_escaped(cjson_uint64 backslash, cjson_uint64 * const carry)
+{
+    cjson_uint64 follows_backslash = 0;
+    cjson_uint64 odd_starts = 0;
+    cjson_uint64 runs = 0;
+
+    /* a backslash escaped by the previous block doesn't escape anything */
+    backslash &= ~*carry;
+    follows_backslash = (backslash << 1) | *carry;
+    /* adding the runs that start on odd bits to the backslashes carries past the end of those runs,
+     * which flips the even/odd pattern for them */
+    odd_starts = backslash & ~MINIFY_EVEN_BITS & ~follows_backslash;
+    runs = odd_starts + backslash;
+    *carry = (runs < backslash) ? 1 : 0;
+
+    return (MINIFY_EVEN_BITS ^ (runs << 1)) & follows_backslash;
+}
+
+/* bit i is set if an odd number of bits 0 to i are set */
+static cjson_uint64 prefix_xor(cjson_uint64 bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+
+    return bits;
+}
+
+/* positions of the set bits of every byte, the bytes a group of 8 keeps in order */
+static const unsigned char minify_shuffle[256][8] =
+{
+    {0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0}, {1, 0, 0, 0, 0, 0, 0, 0}, {0, 1, 0, 0, 0, 0, 0, 0},
+    {2, 0, 0, 0, 0, 0, 0, 0}, {0, 2, 0, 0, 0, 0, 0, 0}, {1, 2, 0, 0, 0, 0, 0, 0}, {0, 1, 2, 0, 0, 0, 0, 0},
+    {3, 0, 0, 0, 0, 0, 0, 0}, {0, 3, 0, 0, 0, 0, 0, 0}, {1, 3, 0, 0, 0, 0, 0, 0}, {0, 1, 3, 0, 0, 0, 0, 0},
+    {2, 3, 0, 0, 0, 0, 0, 0}, {0, 2, 3, 0, 0, 0, 0, 0}, {1, 2, 3, 0, 0, 0, 0, 0}, {0, 1, 2, 3, 0, 0, 0, 0},
+    {4, 0, 0, 0, 0, 0, 0, 0}, {0, 4, 0, 0, 0, 0, 0, 0}, {1, 4, 0, 0, 0, 0, 0, 0}, {0, 1, 4, 0, 0, 0, 0, 0},
+    {2, 4, 0, 0, 0, 0, 0, 0}, {0, 2, 4, 0, 0, 0, 0, 0}, {1, 2, 4, 0, 0, 0, 0, 0}, {0, 1, 2, 4, 0, 0, 0, 0},
+    {3, 4, 0, 0, 0, 0, 0, 0}, {0, 3, 4, 0, 0, 0, 0, 0}, {1, 3, 4, 0, 0, 0, 0, 0}, {0, 1, 3, 4, 0, 0, 0, 0},
+    {2, 3, 4, 0, 0, 0, 0, 0}, {0, 2, 3, 4, 0, 0, 0, 0}, {1, 2, 3, 4, 0, 0, 0, 0}, {0, 1, 2, 3, 4, 0, 0, 0},
+    {5, 0, 0, 0, 0, 0, 0, 0}, {0, 5, 0, 0, 0, 0, 0, 0}, {1, 5, 0, 0, 0, 0, 0, 0}, {0, 1, 5, 0, 0, 0, 0, 0},
+    {2, 5, 0, 0, 0, 0, 0, 0}, {0, 2, 5, 0, 0, 0, 0, 0}, {1, 2, 5, 0, 0, 0, 0, 0}, {0, 1, 2, 5, 0, 0, 0, 0},
+    {3, 5, 0, 0, 0, 0, 0, 0}, {0, 3, 5, 0, 0, 0, 0, 0}, {1, 3, 5, 0, 0, 0, 0, 0}, {0, 1, 3, 5, 0, 0, 0, 0},
+    {2, 3, 5, 0, 0, 0, 0, 0}, {0, 2, 3, 5, 0, 0, 0, 0}, {1, 2, 3, 5, 0, 0, 0, 0}, {0, 1, 2, 3, 5, 0, 0, 0},
+    {4, 5, 0, 0, 0, 0, 0, 0}, {0, 4, 5, 0, 0, 0, 0, 0}, {1, 4, 5, 0, 0, 0, 0, 0}, {0, 1, 4, 5, 0, 0, 0, 0},
+    {2, 4, 5, 0, 0, 0, 0, 0}, {0, 2, 4, 5, 0, 0, 0, 0}, {1, 2, 4, 5, 0, 0, 0, 0}, {0, 1, 2, 4, 5, 0, 0, 0},
+    {3, 4, 5, 0, 0, 0, 0, 0}, {0, 3, 4, 5, 0, 0, 0, 0}, {1, 3, 4, 5, 0, 0, 0, 0}, {0, 1, 3, 4, 5, 0, 0, 0},
+    {2, 3, 4, 5, 0, 0, 0, 0}, {0, 2, 3, 4, 5, 0, 0, 0}, {1, 2, 3, 4, 5, 0, 0, 0}, {0, 1, 2, 3, 4, 5, 0, 0},
+    {6, 0, 0, 0, 0, 0, 0, 0}, {0, 6, 0, 0, 0, 0, 0, 0}, {1, 6, 0, 0, 0, 0, 0, 0}, {0, 1, 6, 0, 0, 0, 0, 0},
+    {2, 6, 0, 0, 0, 0, 0, 0}, {0, 2, 6, 0, 0, 0, 0, 0}, {1, 2, 6, 0, 0, 0, 0, 0}, {0, 1, 2, 6, 0, 0, 0, 0},
+    {3, 6, 0, 0, 0, 0, 0, 0}, {0, 3, 6, 0, 0, 0, 0, 0}, {1, 3, 6, 0, 0, 0, 0, 0}, {0, 1, 3, 6, 0, 0, 0, 0},
+    {2, 3, 6, 0, 0, 0, 0, 0}, {0, 2, 3, 6, 0, 0, 0, 0}, {1, 2, 3, 6, 0, 0, 0, 0}, {0, 1, 2, 3, 6, 0, 0, 0},
+    {4, 6, 0, 0, 0, 0, 0, 0}, {0, 4, 6, 0, 0, 0, 0, 0}, {1, 4, 6, 0, 0, 0, 0, 0}, {0, 1, 4, 6, 0, 0, 0, 0},
+    {2, 4, 6, 0, 0, 0, 0, 0}, {0, 2, 4, 6, 0, 0, 0, 0}, {1, 2, 4, 6, 0, 0, 0, 0}, {0, 1, 2, 4, 6, 0, 0, 0},
+    {3, 4, 6, 0, 0, 0, 0, 0}, {0, 3, 4, 6, 0, 0, 0, 0}, {1, 3, 4, 6, 0, 0, 0, 0}, {0, 1, 3, 4, 6, 0, 0, 0},
+    {2, 3, 4, 6, 0, 0, 0, 0}, {0, 2, 3, 4, 6, 0, 0, 0}, {1, 2, 3, 4, 6, 0, 0, 0}, {0, 1, 2, 3, 4, 6, 0, 0},
+    {5, 6, 0, 0, 0, 0, 0, 0}, {0, 5, 6, 0, 0, 0, 0, 0}, {1, 5, 6, 0, 0, 0, 0, 0}, {0, 1, 5, 6, 0, 0, 0, 0},
+    {2, 5, 6, 0, 0, 0, 0, 0}, {0, 2, 5, 6, 0, 0, 0, 0}, {1, 2, 5, 6, 0, 0, 0, 0}, {0, 1, 2, 5, 6, 0, 0, 0},
+    {3, 5, 6, 0, 0, 0, 0, 0}, {0, 3, 5, 6, 0, 0, 0, 0}, {1, 3, 5, 6, 0, 0, 0, 0}, {0, 1, 3, 5, 6, 0, 0, 0},
+    {2, 3, 5, 6, 0, 0, 0, 0}, {0, 2, 3, 5, 6, 0, 0, 0}, {1, 2, 3, 5, 6, 0, 0, 0}, {0, 1, 2, 3, 5, 6, 0, 0},
+    {4, 5, 6, 0, 0, 0, 0, 0}, {0, 4, 5, 6, 0, 0, 0, 0}, {1, 4, 5, 6, 0, 0, 0, 0}, {0, 1, 4, 5, 6, 0, 0, 0},
+    {2, 4, 5, 6, 0, 0, 0, 0}, {0, 2, 4, 5, 6, 0, 0, 0}, {1, 2, 4, 5, 6, 0, 0, 0}, {0, 1, 2, 4, 5, 6, 0, 0},
+    {3, 4, 5, 6, 0, 0, 0, 0}, {0, 3, 4, 5, 6, 0, 0, 0}, {1, 3, 4, 5, 6, 0, 0, 0}, {0, 1, 3, 4, 5, 6, 0, 0},
+    {2, 3, 4, 5, 6, 0, 0, 0}, {0, 2, 3, 4, 5, 6, 0, 0}, {1, 2, 3, 4, 5, 6, 0, 0}, {0, 1, 2, 3, 4, 5, 6, 0},
+    {7, 0, 0, 0, 0, 0, 0, 0}, {0, 7, 0, 0, 0, 0, 0, 0}, {1, 7, 0, 0, 0, 0, 0, 0}, {0, 1, 7, 0, 0, 0, 0, 0},
+    {2, 7, 0, 0, 0, 0, 0, 0}, {0, 2, 7, 0, 0, 0, 0, 0}, {1, 2, 7, 0, 0, 0, 0, 0}, {0, 1, 2, 7, 0, 0, 0, 0},
+    {3, 7, 0, 0, 0, 0, 0, 0}, {0, 3, 7, 0, 0, 0, 0, 0}, {1, 3, 7, 0, 0, 0, 0, 0}, {0, 1, 3, 7, 0, 0, 0, 0},
+    {2, 3, 7, 0, 0, 0, 0, 0}, {0, 2, 3, 7, 0, 0, 0, 0}, {1, 2, 3, 7, 0, 0, 0, 0}, {0, 1, 2, 3, 7, 0, 0, 0},
+    {4, 7, 0, 0, 0, 0, 0, 0}, {0, 4, 7, 0, 0, 0, 0, 0}, {1, 4, 7, 0, 0, 0, 0, 0}, {0, 1, 4, 7, 0, 0, 0, 0},
+    {2, 4, 7, 0, 0, 0, 0, 0}, {0, 2, 4, 7, 0, 0, 0, 0}, {1, 2, 4, 7, 0, 0, 0, 0}, {0, 1, 2, 4, 7, 0, 0, 0},
+    {3, 4, 7, 0, 0, 0, 0, 0}, {0, 3, 4, 7, 0, 0, 0, 0}, {1, 3, 4, 7, 0, 0, 0, 0}, {0, 1, 3, 4, 7, 0, 0, 0},
+    {2, 3, 4, 7, 0, 0, 0, 0}, {0, 2, 3, 4, 7, 0, 0, 0}, {1, 2, 3, 4, 7, 0, 0, 0}, {0, 1, 2, 3, 4, 7, 0, 0},
+    {5, 7, 0, 0, 0, 0, 0, 0}, {0, 5, 7, 0, 0, 0, 0, 0}, {1, 5, 7, 0, 0, 0, 0, 0}, {0, 1, 5, 7, 0, 0, 0, 0},
+    {2, 5, 7, 0, 0, 0, 0, 0}, {0, 2, 5, 7, 0, 0, 0, 0}, {1, 2, 5, 7, 0, 0, 0, 0}, {0, 1, 2, 5, 7, 0, 0, 0},
+    {3, 5, 7, 0, 0, 0, 0, 0}, {0, 3, 5, 7, 0, 0, 0, 0}, {1, 3, 5, 7, 0, 0, 0, 0}, {0, 1, 3, 5, 7, 0, 0, 0},
+    {2, 3, 5, 7, 0, 0, 0, 0}, {0, 2, 3, 5, 7, 0, 0, 0}, {1, 2, 3, 5, 7, 0, 0, 0}, {0, 1, 2, 3, 5, 7, 0, 0},
+    {4, 5, 7, 0, 0, 0, 0, 0}, {0, 4, 5, 7, 0, 0, 0, 0}, {1, 4, 5, 7, 0, 0, 0, 0}, {0, 1, 4, 5, 7, 0, 0, 0},
+    {2, 4, 5, 7, 0, 0, 0, 0}, {0, 2, 4, 5, 7, 0, 0, 0}, {1, 2, 4, 5, 7, 0, 0, 0}, {0, 1, 2, 4, 5, 7, 0, 0},
+    {3, 4, 5, 7, 0, 0, 0, 0}, {0, 3, 4, 5, 7, 0, 0, 0}, {1, 3, 4, 5, 7, 0, 0, 0}, {0, 1, 3, 4, 5, 7, 0, 0},
+    {2, 3, 4, 5, 7, 0, 0, 0}, {0, 2, 3, 4, 5, 7, 0, 0}, {1, 2, 3, 4, 5, 7, 0, 0}, {0, 1, 2, 3, 4, 5, 7, 0},
+    {6, 7, 0, 0, 0, 0, 0, 0}, {0, 6, 7, 0, 0, 0, 0, 0}, {1, 6, 7, 0, 0, 0, 0, 0}, {0, 1, 6, 7, 0, 0, 0, 0},
+    {2, 6, 7, 0, 0, 0, 0, 0}, {0, 2, 6, 7, 0, 0, 0, 0}, {1, 2, 6, 7, 0, 0, 0, 0}, {0, 1, 2, 6, 7, 0, 0, 0},
+    {3, 6, 7, 0, 0, 0, 0, 0}, {0, 3, 6, 7, 0, 0, 0, 0}, {1, 3, 6, 7, 0, 0, 0, 0}, {0, 1, 3, 6, 7, 0, 0, 0},
+    {2, 3, 6, 7, 0, 0, 0, 0}, {0, 2, 3, 6, 7, 0, 0, 0}, {1, 2, 3, 6, 7, 0, 0, 0}, {0, 1, 2, 3, 6, 7, 0, 0},
+    {4, 6, 7, 0, 0, 0, 0, 0}, {0, 4, 6, 7, 0, 0, 0, 0}, {1, 4, 6, 7, 0, 0, 0, 0}, {0, 1, 4, 6, 7, 0, 0, 0},
+    {2, 4, 6, 7, 0, 0, 0, 0}, {0, 2, 4, 6, 7, 0, 0, 0}, {1, 2, 4, 6, 7, 0, 0, 0}, {0, 1, 2, 4, 6, 7, 0, 0},
+    {3, 4, 6, 7, 0, 0, 0, 0}, {0, 3, 4, 6, 7, 0, 0, 0}, {1, 3, 4, 6, 7, 0, 0, 0}, {0, 1, 3, 4, 6, 7, 0, 0},
+    {2, 3, 4, 6, 7, 0, 0, 0}, {0, 2, 3, 4, 6, 7, 0, 0}, {1, 2, 3, 4, 6, 7, 0, 0}, {0, 1, 2, 3, 4, 6, 7, 0},
+    {5, 6, 7, 0, 0, 0, 0, 0}, {0, 5, 6, 7, 0, 0, 0, 0}, {1, 5, 6, 7, 0, 0, 0, 0}, {0, 1, 5, 6, 7, 0, 0, 0},
+    {2, 5, 6, 7, 0, 0, 0, 0}, {0, 2, 5, 6, 7, 0, 0, 0}, {1, 2, 5, 6, 7, 0, 0, 0}, {0, 1, 2, 5, 6, 7, 0, 0},
+    {3, 5, 6, 7, 0, 0, 0, 0}, {0, 3, 5, 6, 7, 0, 0, 0}, {1, 3, 5, 6, 7, 0, 0, 0}, {0, 1, 3, 5, 6, 7, 0, 0},
+    {2, 3, 5, 6, 7, 0, 0, 0}, {0, 2, 3, 5, 6, 7, 0, 0}, {1, 2, 3, 5, 6, 7, 0, 0}, {0, 1, 2, 3, 5, 6, 7, 0},
+    {4, 5, 6, 7, 0, 0, 0, 0}, {0, 4, 5, 6, 7, 0, 0, 0}, {1, 4, 5, 6, 7, 0, 0, 0}, {0, 1, 4, 5, 6, 7, 0, 0},
+    {2, 4, 5, 6, 7, 0, 0, 0}, {0, 2, 4, 5, 6, 7, 0, 0}, {1, 2, 4, 5, 6, 7, 0, 0}, {0, 1, 2, 4, 5, 6, 7, 0},
+    {3, 4, 5, 6, 7, 0, 0, 0}, {0, 3, 4, 5, 6, 7, 0, 0}, {1, 3, 4, 5, 6, 7, 0, 0}, {0, 1, 3, 4, 5, 6, 7, 0},
+    {2, 3, 4, 5, 6, 7, 0, 0}, {0, 2, 3, 4, 5, 6, 7, 0}, {1, 2, 3, 4, 5, 6, 7, 0}, {0, 1, 2, 3, 4, 5, 6, 7}
+};
+
+/* number of set bits in every 4 bit mask */
+static const unsigned char minify_bit_count[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+#define minify_kept(bits) (minify_bit_count[(bits) & 0x0F] + minify_bit_count[(bits) >> 4])
+
+/* moves the bytes of the block at buffer->read that are set in keep to buffer->write */
+static void compact_block(minify_buffer * const buffer, const cjson_uint64 keep)
+{
+    const unsigned char * const block = buffer->json + buffer->read;
+    unsigned char *output = buffer->json + buffer->write;
+    size_t i = 0;
+
+    for (i = 0; i < MINIFY_BLOCK_SIZE; i += 8)
+    {
+        const unsigned int bits = (unsigned int)(keep >> i) & 0xFF;
+        const unsigned char *shuffle = minify_shuffle[bits];
+        unsigned char group[8];
+
+        if (bits == 0)
+        {
+            continue;
+        }
+        /* output may overlap the group */
+        memcpy(group, block + i, sizeof(group));
+        if (bits == 0xFF)
+        {
+            memcpy(output, group, sizeof(group));
+            output += sizeof(group);
+            continue;
+        }
+
+        /* always writes 8 bytes, the ones past the kept bytes are overwritten later */
+        output[0] = group[shuffle[0]];
+        output[1] = group[shuffle[1]];
+        output[2] = group[shuffle[2]];
+        output[3] = group[shuffle[3]];
+        output[4] = group[shuffle[4]];
+        output[5] = group[shuffle[5]];
+        output[6] = group[shuffle[6]];
+        output[7] = group[shuffle[7]];
+        output += minify_kept(bits);
+    }
+
+    buffer->write = (size_t)(output - buffer->json);
+}
+
+#ifdef CJSON_AVX2
+/* the same with pshufb doing the shuffle */
+__attribute__((target("avx2")))
+static void compact_block_avx2(minify_buffer * const buffer, const cjson_uint64 keep)
+{
+    const unsigned char * const block = buffer->json + buffer->read;
+    unsigned char *output = buffer->json + buffer->write;
+    size_t i = 0;
+
+    for (i = 0; i < MINIFY_BLOCK_SIZE; i += 8)
+    {
+        const unsigned int bits = (unsigned int)(keep >> i) & 0xFF;
+        const __m128i group = _mm_loadl_epi64((const __m128i*)(const void*)(block + i));
+
+        _mm_storel_epi64((__m128i*)(void*)output, _mm_shuffle_epi8(group, _mm_loadl_epi64((const __m128i*)(const void*)minify_shuffle[bits])));
+        output += minify_kept(bits);
+    }
+
+    buffer->write = (size_t)(output - buffer->json);
+}
+#endif
+
+/* minifies whole blocks until the input ends or a block might contain a comment */
+static void minify_blocks(minify_buffer * const buffer)
+{
+    /* all ones while inside of a string */
+    cjson_uint64 in_string = buffer->in_string ? ~(cjson_uint64)0 : 0;
+    cjson_uint64 escaped = buffer->escaped ? 1 : 0;
+
+    while ((buffer->length - buffer->read) >= MINIFY_BLOCK_SIZE)
+    {
+        minify_masks masks;
+        cjson_uint64 carry = escaped;
+        cjson_uint64 strings = 0;
+
+        classify_block(buffer->json + buffer->read, &masks);
+        /* set from an opening quote up to, but not including, the closing quote */
+        if ((masks.quote | masks.backslash) == 0)
+        {
+            strings = in_string;
+            carry = 0;
+        }
+        else
+        {
+            strings = prefix_xor(masks.quote & ~find_escaped(masks.backslash, &carry)) ^ in_string;
+        }
+        if ((masks.slash & ~strings) != 0)
+        {
+            break;
+        }
+
+        if (masks.whitespace == 0)
+        {
+            /* nothing to remove */
+            if (buffer->write != buffer->read)
+            {
+                memmove(buffer->json + buffer->write, buffer->json + buffer->read, MINIFY_BLOCK_SIZE);
+            }
+            buffer->write += MINIFY_BLOCK_SIZE;
+        }
+#ifdef CJSON_AVX2
+        else if (cpu_has_avx2)
+        {
+            compact_block_avx2(buffer, ~masks.whitespace | strings);
+        }
+#endif
+        else
+        {
+            compact_block(buffer, ~masks.whitespace | strings);
+        }
+        buffer->read += MINIFY_BLOCK_SIZE;
+        in_string = (cjson_uint64)0 - (strings >> 63);
+        escaped = carry;
+    }
 
-    while (json[0] != '\0')
+    buffer->in_string = (in_string != 0);
+    buffer->escaped = (escaped != 0);
+}
+
+/* minifies byte by byte up to stop, or past it to the end of a comment */
+static void minify_bytes(minify_buffer * const buffer, const size_t stop)
+{
+    unsigned char * const json = buffer->json;
+
+    while (buffer->read < stop)
     {
-        switch (json[0])
+        const unsigned char character = json[buffer->read];
+        const cJSON_bool escaped = buffer->escaped;
+        char *comment = NULL;
+
+        buffer->escaped = false;
+        if (buffer->in_string)
+        {
+            if (!escaped && (character == '\\'))
+            {
+                buffer->escaped = true;
+            }
+            else if (!escaped && (character == '\"'))
+            {
+                buffer->in_string = false;
+            }
+            json[buffer->write++] = character;
+            buffer->read++;
+            continue;
+        }
+
+        switch (character)
         {
             case ' ':
             case '\t':
             case '\r':
             case '\n':
-                json++;
+                buffer->read++;
                 break;
 
             case '/':
-                if (json[1] == '/')
+                comment = (char*)json + buffer->read;
+                if (comment[1] == '/')
                 {
-                    skip_oneline_comment(&json);
+                    skip_oneline_comment(&comment);
                 }
-                else if (json[1] == '*')
+                else if (comment[1] == '*')
                 {
-                    skip_multiline_comment(&json);
+                    skip_multiline_comment(&comment);
                 } else {
-                    json++;
+                    comment++;
                 }
+                buffer->read = (size_t)((unsigned char*)comment - json);
                 break;
 
             case '\"':
-                minify_string(&json, (char**)&into);
+                buffer->in_string = !escaped;
+                json[buffer->write++] = character;
+                buffer->read++;
+                break;
+
+            case '\\':
+                buffer->escaped = !escaped;
+                json[buffer->write++] = character;
+                buffer->read++;
                 break;
 
             default:
-                into[0] = json[0];
-                json++;
-                into++;
+                json[buffer->write++] = character;
+                buffer->read++;
+        }
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_Minify(char *json)
+{
+    minify_buffer buffer;
+
+    if (json == NULL)
+    {
+        return;
+    }
+
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.json = (unsigned char*)json;
+    buffer.length = strlen(json);
+
+    while (buffer.read < buffer.length)
+    {
+        minify_blocks(&buffer);
+        /* the block that stopped minify_blocks, or what is left at the end */
+        if ((buffer.length - buffer.read) < MINIFY_BLOCK_SIZE)
+        {
+            minify_bytes(&buffer, buffer.length);
+        }
+        else
+        {
+            minify_bytes(&buffer, buffer.read + MINIFY_BLOCK_SIZE);
         }
     }
 
     /* and null-terminate. */
-    *into = '\0';
+    json[buffer.write] = '\0';
 }
 
 CJSON_PUBLIC(cJSON_bool) cJSON_IsInvalid(const cJSON * const item)
@@ -3027,8 +8551,43 @@ CJSON_PUBLIC(cJSON_bool) cJSON_IsRaw(const cJSON * const item)
     return (item->type & 0xFF) == cJSON_Raw;
 }
 
+/* compare two arrays of which at least one is packed, without expanding it */
+static cJSON_bool compare_packed(const cJSON * const a, const cJSON * const b, const cJSON_bool case_sensitive)
+{
+    const cJSON *a_child = a->child;
+    const cJSON *b_child = b->child;
+    const cJSON *a_element = NULL;
+    const cJSON *b_element = NULL;
+    cJSON a_number;
+    cJSON b_number;
+    size_t i = 0;
+
+    if (((a->type & b->type) & cJSON_PackedNumberArray) && (packed_numbers_of(a)->count != packed_numbers_of(b)->count))
+    {
+        return false;
+    }
+
+    for (i = 0; ; i++)
+    {
+        a_element = array_element(a, i, &a_child, &a_number);
+        b_element = array_element(b, i, &b_child, &b_number);
+        if ((a_element == NULL) || (b_element == NULL))
+        {
+            /* equal if both ended */
+            return a_element == b_element;
+        }
+        if (!cJSON_Compare(a_element, b_element, case_sensitive))
+        {
+            return false;
+        }
+    }
+}
+
 CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * const b, const cJSON_bool case_sensitive)
 {
+    cJSON_int64 a_integer = 0;
+    cJSON_int64 b_integer = 0;
+
     if ((a == NULL) || (b == NULL) || ((a->type & 0xFF) != (b->type & 0xFF)))
     {
         return false;
@@ -3066,6 +8625,11 @@ CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * cons
             return true;
 
         case cJSON_Number:
+            if (exact_integer(a, &a_integer) && exact_integer(b, &b_integer))
+            {
+                /* big integers that only differ in the last digits compare equal as doubles */
+                return a_integer == b_integer;
+            }
             if (compare_double(a->valuedouble, b->valuedouble))
             {
                 return true;
@@ -3090,6 +8654,11 @@ CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * cons
             cJSON *a_element = a->child;
             cJSON *b_element = b->child;
 
+            if ((a->type | b->type) & cJSON_PackedNumberArray)
+            {
+                return compare_packed(a, b, case_sensitive);
+            }
+
             for (; (a_element != NULL) && (b_element != NULL);)
             {
                 if (!cJSON_Compare(a_element, b_element, case_sensitive))
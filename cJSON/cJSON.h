@@ -84,6 +84,7 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 #define CJSON_VERSION_PATCH 18
 
 #include <stddef.h>
+#include <stdio.h>
 
 /* cJSON Types: */
 #define cJSON_Invalid (0)
@@ -98,6 +99,22 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
+#define cJSON_IsArenaItem 1024 /* the item and its valuestring belong to a cJSON_Arena */
+#define cJSON_IsInt64 2048 /* the number is integral, see cJSON_GetInt64Value for its exact value */
+#define cJSON_StringIsInterned 4096 /* string is shared with other items through a cJSON_KeyPool */
+#define cJSON_IsShared 8192 /* the children are shared with other copies, see cJSON_DuplicateShared */
+#define cJSON_PackedNumberArray 16384 /* array of numbers stored as a C array instead of items, see cJSON_CreatePackedDoubleArray */
+#define cJSON_IsIndexed 32768 /* the object or array has a lookup index, see cJSON_BuildIndex */
+
+/* exact integers, see cJSON_GetInt64Value */
+#if defined(_MSC_VER)
+typedef __int64 cJSON_int64;
+#else
+#if defined(__GNUC__)
+__extension__
+#endif
+typedef long long cJSON_int64;
+#endif
 
 /* The cJSON structure: */
 typedef struct cJSON
@@ -131,18 +148,50 @@ typedef struct cJSON_Hooks
 
 typedef int cJSON_bool;
 
+/* Bump allocator for the items and strings of parsed documents, see cJSON_ParseWithArena */
+typedef struct cJSON_Arena cJSON_Arena;
+/* Shared storage for the object keys of parsed documents, see cJSON_ParseWithKeyPool */
+typedef struct cJSON_KeyPool cJSON_KeyPool;
+
 /* Limits how deeply nested arrays/objects can be before cJSON rejects to parse them.
- * This is to prevent stack overflows. */
+ * Parsing, printing and deleting don't recurse, so this only bounds the memory for their stacks of nesting levels. */
 #ifndef CJSON_NESTING_LIMIT
 #define CJSON_NESTING_LIMIT 1000
 #endif
 
-/* Limits the length of circular references can be before cJSON rejects to parse them.
- * This is to prevent stack overflows. */
+/* Limits how many references cJSON_Duplicate follows into each other before it gives up,
+ * so circular references can't make it copy forever. Deep trees without references aren't limited. */
 #ifndef CJSON_CIRCULAR_LIMIT
 #define CJSON_CIRCULAR_LIMIT 10000
 #endif
 
+/* Lookups that walk this many children of an object or array give it an index, see cJSON_BuildIndex. */
+#ifndef CJSON_INDEX_THRESHOLD
+#define CJSON_INDEX_THRESHOLD 64
+#endif
+
+/* Per-call state for cJSON_ParseCtx, cJSON_PrintCtx and cJSON_DeleteCtx. Zero it with cJSON_InitContext,
+ * then set what is needed. Threads that each use their own context share no mutable state with each other. */
+typedef struct cJSON_Context
+{
+    /* allocator for items and strings, NULL functions select malloc and free (the global hooks are not used) */
+    cJSON_Hooks hooks;
+    /* allocate the parsed document from this arena instead of with hooks if not NULL */
+    cJSON_Arena *arena;
+    /* how deeply arrays and objects may be nested, 0 selects CJSON_NESTING_LIMIT */
+    size_t nesting_limit;
+    /* longest input that is accepted, 0 for no limit */
+    size_t length_limit;
+    cJSON_bool require_null_terminated;
+    /* set by cJSON_ParseCtx: the final byte parsed, and the error position (NULL on success) */
+    const char *end;
+    const char *error;
+    /* parse arrays that only hold numbers into cJSON_PackedNumberArray (not into an arena or with other hooks) */
+    cJSON_bool pack_number_arrays;
+    /* set with error: its offset in the input, which is still valid after cJSON_ParseFile released the file */
+    size_t error_offset;
+} cJSON_Context;
+
 /* returns the version of cJSON as a string */
 CJSON_PUBLIC(const char*) cJSON_Version(void);
 
@@ -157,6 +206,106 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 /* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error so will match cJSON_GetErrorPtr(). */
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+/* Check that value is JSON that cJSON_ParseWithLength would parse, followed by nothing but whitespace, without
+ * building a tree or allocating memory. Arrays and objects may be nested CJSON_NESTING_LIMIT deep. Unlike the
+ * parser, it also requires strings to be well-formed UTF-8 (RFC 8259). On failure error_offset (may be NULL)
+ * receives the offset cJSON_GetErrorPtr would point to after parsing, or of the first invalid UTF-8 byte. */
+CJSON_PUBLIC(cJSON_bool) cJSON_Validate(const char *value, size_t buffer_length, size_t *error_offset);
+
+/* Arena parsing: every item and string of the document is allocated from large chunks of the arena,
+ * and the whole document is released at once with cJSON_ArenaFree (no cJSON_Delete needed).
+ * Arena items can still be modified, detached and moved into other documents, but they keep belonging
+ * to their arena, so it has to outlive every tree they are linked into. Items that were added to an
+ * arena document with the normal allocator are only released by cJSON_Delete, so call it on the root
+ * before cJSON_ArenaFree in that case. An arena must not be used from multiple threads at once. */
+/* chunk_size is the size of the blocks requested from the allocator, 0 selects the default. */
+CJSON_PUBLIC(cJSON_Arena *) cJSON_ArenaNew(size_t chunk_size);
+CJSON_PUBLIC(void) cJSON_ArenaFree(cJSON_Arena *arena);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithArena(const char *value, size_t buffer_length, cJSON_Arena *arena);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithArenaOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated, cJSON_Arena *arena);
+/* In-situ parsing: strings and keys are decoded inside value itself, so valuestring and string point into it and no
+ * string is copied. value has to be allocated with the cJSON hooks (cJSON_malloc); the arena takes it over, also
+ * if parsing fails, and frees it with cJSON_ArenaFree. Its contents are undefined after the call. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value, size_t buffer_length, cJSON_Arena *arena);
+/* Parse a file. Where POSIX is available it is memory-mapped and parsed from the mapping, without a copy or
+ * a scan for its end, elsewhere it is read into memory. context works as for cJSON_ParseCtx (NULL for the global
+ * hooks), require_null_terminated rejects anything but whitespace after the value. With context->arena the
+ * strings are decoded in situ and the arena keeps the file contents; otherwise they are released before
+ * cJSON_ParseFile returns, so context->end and context->error are NULL and only error_offset tells where
+ * parsing failed (cJSON_GetErrorPtr is not set without a context). */
+CJSON_PUBLIC(cJSON *) cJSON_ParseFile(const char *path, cJSON_Context *context);
+
+/* Key interning: equal object keys are stored once and shared by reference counting, which saves an allocation
+ * per member in documents with many records of the same shape. The pool can be reused for any number of documents
+ * (NULL shares the keys within this document only) and freed at any time, keys live as long as items use them.
+ * A pool must not be used from multiple threads at once, the same goes for documents sharing keys. */
+CJSON_PUBLIC(cJSON_KeyPool *) cJSON_KeyPoolNew(void);
+CJSON_PUBLIC(void) cJSON_KeyPoolFree(cJSON_KeyPool *pool);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithKeyPool(const char *value, size_t buffer_length, cJSON_KeyPool *pool);
+/* Free the key (string) of an item, whether it is owned, constant or interned. */
+CJSON_PUBLIC(void) cJSON_ReleaseKey(cJSON * const item);
+
+/* Reentrant variants: they use the allocator and limits of the context and report errors to it instead of
+ * cJSON_GetErrorPtr. Documents from cJSON_ParseCtx have to be deleted with cJSON_DeleteCtx and the same hooks. */
+CJSON_PUBLIC(void) cJSON_InitContext(cJSON_Context *context);
+CJSON_PUBLIC(cJSON *) cJSON_ParseCtx(const char *value, size_t buffer_length, cJSON_Context *context);
+CJSON_PUBLIC(char *) cJSON_PrintCtx(const cJSON *item, cJSON_bool format, const cJSON_Context *context);
+CJSON_PUBLIC(void) cJSON_DeleteCtx(cJSON *item, const cJSON_Context *context);
+
+/* Event parsing: the document is reported to the callbacks of a cJSON_EventHandler instead of being built as a tree,
+ * so memory use doesn't grow with the document. Unused callbacks may be NULL, returning false from a callback
+ * aborts parsing. value gets all strings, numbers, booleans and nulls as a temporary item without key, which is
+ * only valid during the call (as is the key passed to key). Errors are reported via cJSON_GetErrorPtr. */
+typedef struct cJSON_EventHandler
+{
+    cJSON_bool (*start_object)(void *context);
+    cJSON_bool (*end_object)(void *context);
+    cJSON_bool (*start_array)(void *context);
+    cJSON_bool (*end_array)(void *context);
+    cJSON_bool (*key)(void *context, const char *key);
+    cJSON_bool (*value)(void *context, const cJSON *value);
+} cJSON_EventHandler;
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseEvents(const char *value, size_t buffer_length, const cJSON_EventHandler *handler, void *context);
+
+/* Incremental parsing: the document is passed in chunks of any size as they arrive (from a socket, a file read in
+ * blocks...) and the parser picks up where the previous chunk ended, also in the middle of a string or number.
+ * With a handler the document is reported as events (see cJSON_ParseEvents), with NULL it is built as a tree that
+ * cJSON_StreamParserFinish hands out. Once Feed or Finish failed, the parser stays failed and
+ * cJSON_StreamParserGetErrorOffset gives the position of the error in the whole input, like the error_offset of
+ * cJSON_ParseCtx (the end of the input for incomplete documents). */
+typedef struct cJSON_StreamParser cJSON_StreamParser;
+CJSON_PUBLIC(cJSON_StreamParser *) cJSON_StreamParserNew(const cJSON_EventHandler *handler, void *context);
+CJSON_PUBLIC(cJSON_bool) cJSON_StreamParserFeed(cJSON_StreamParser *parser, const char *chunk, size_t length);
+/* call after the last chunk, fails if the document is incomplete. root receives the tree in tree mode (may be NULL). */
+CJSON_PUBLIC(cJSON_bool) cJSON_StreamParserFinish(cJSON_StreamParser *parser, cJSON **root);
+CJSON_PUBLIC(size_t) cJSON_StreamParserGetErrorOffset(const cJSON_StreamParser *parser);
+CJSON_PUBLIC(void) cJSON_StreamParserDelete(cJSON_StreamParser *parser);
+
+/* Lazy parsing: cJSON_ParseLazy only checks the structure of the document and records where its values are,
+ * they are decoded when accessed through a cJSON_Cursor. Nothing is copied, so the input has to stay valid until
+ * cJSON_LazyDelete. Accessors return an invalid cursor (type cJSON_Invalid) if there is no such value. Numbers are
+ * fully checked only when they are decoded. */
+typedef struct cJSON_Lazy cJSON_Lazy;
+typedef struct cJSON_Cursor
+{
+    const cJSON_Lazy *document;
+    size_t index;
+} cJSON_Cursor;
+CJSON_PUBLIC(cJSON_Lazy *) cJSON_ParseLazy(const char *value, size_t buffer_length);
+CJSON_PUBLIC(void) cJSON_LazyDelete(cJSON_Lazy *document);
+CJSON_PUBLIC(cJSON_Cursor) cJSON_LazyGetRoot(const cJSON_Lazy *document);
+/* cJSON_Object, cJSON_String ... or cJSON_Invalid */
+CJSON_PUBLIC(int) cJSON_CursorGetType(const cJSON_Cursor cursor);
+CJSON_PUBLIC(cJSON_Cursor) cJSON_CursorGetObjectItem(const cJSON_Cursor object, const char *string);
+CJSON_PUBLIC(cJSON_Cursor) cJSON_CursorGetObjectItemCaseSensitive(const cJSON_Cursor object, const char *string);
+CJSON_PUBLIC(cJSON_Cursor) cJSON_CursorGetArrayItem(const cJSON_Cursor array, int index);
+CJSON_PUBLIC(int) cJSON_CursorGetArraySize(const cJSON_Cursor array);
+/* RFC6901 JSON Pointer relative to the cursor, case sensitive */
+CJSON_PUBLIC(cJSON_Cursor) cJSON_CursorGetPointer(const cJSON_Cursor cursor, const char *pointer);
+/* NAN if the value isn't a number */
+CJSON_PUBLIC(double) cJSON_CursorGetNumberValue(const cJSON_Cursor cursor);
+/* decode the value and everything below it into a normal tree, delete it with cJSON_Delete */
+CJSON_PUBLIC(cJSON *) cJSON_CursorDecode(const cJSON_Cursor cursor);
 
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
@@ -167,6 +316,19 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
 /* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
 /* NOTE: cJSON is not always 100% accurate in estimating how much memory it will use, so to be safe allocate 5 bytes more than you actually need */
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format);
+/* The exact length (without the terminator) cJSON_Print/cJSON_PrintUnformatted would return, 0 if it can't be printed. */
+CJSON_PUBLIC(size_t) cJSON_PrintedLength(const cJSON *item, cJSON_bool format);
+/* Print into a single allocation of the right size, computed with cJSON_PrintedLength first. */
+CJSON_PUBLIC(char *) cJSON_PrintExact(const cJSON *item, cJSON_bool format);
+/* Streaming: print through a fixed size buffer that is handed to writer whenever it is full, so memory use
+ * doesn't depend on the size of the document (only single strings longer than the buffer make it grow).
+ * writer returns false to abort. The output isn't zero terminated. Returns false on failure, in which case
+ * part of the output may have been written already. */
+typedef cJSON_bool (*cJSON_Writer)(void *context, const char *data, size_t length);
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToWriter(const cJSON *item, cJSON_bool format, cJSON_Writer writer, void *context);
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToFile(const cJSON *item, cJSON_bool format, FILE *file);
+/* to a file descriptor with write() */
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintToFd(const cJSON *item, cJSON_bool format, int fd);
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item);
 
@@ -178,12 +340,28 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string);
+/* Index a large object or array: objects get a hash table for cJSON_GetObjectItem,
+ * arrays a vector of their children for constant time cJSON_GetArrayItem/cJSON_GetArraySize.
+ * cJSON_GetObjectItem..., cJSON_GetArrayItem and cJSON_GetArraySize build the index themselves once they
+ * had to walk CJSON_INDEX_THRESHOLD children, so calling this only saves the first slow lookup.
+ * Since lookups can build an index, a tree must not be read from several threads at the same time.
+ * The index belongs to its object or array (it uses its valuestring), so trees don't share any state.
+ * The add/detach/insert/replace functions keep the index up to date, deleting the item drops it.
+ * Returns false if the item can't be indexed (empty, a reference, unnamed children in an object) or on allocation failure.
+ * If you relink ->child/->next/->prev or change ->string of children yourself, call cJSON_InvalidateIndex
+ * on the parent afterwards; lookups check what they cheaply can and fall back to walking the children. */
+CJSON_PUBLIC(cJSON_bool) cJSON_BuildIndex(cJSON *item);
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *object);
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
 CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void);
 
 /* Check item type and return its value */
 CJSON_PUBLIC(char *) cJSON_GetStringValue(const cJSON * const item);
 CJSON_PUBLIC(double) cJSON_GetNumberValue(const cJSON * const item);
+/* The exact value of integral numbers, even beyond 2^53 where valuedouble loses digits.
+ * Where it had to round, the exact value is kept behind the valuestring of the number, so leave that alone.
+ * Other numbers are truncated and saturated to the cJSON_int64 range, non numbers give 0. */
+CJSON_PUBLIC(cJSON_int64) cJSON_GetInt64Value(const cJSON * const item);
 
 /* These functions check the type of an item */
 CJSON_PUBLIC(cJSON_bool) cJSON_IsInvalid(const cJSON * const item);
@@ -203,6 +381,7 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateTrue(void);
 CJSON_PUBLIC(cJSON *) cJSON_CreateFalse(void);
 CJSON_PUBLIC(cJSON *) cJSON_CreateBool(cJSON_bool boolean);
 CJSON_PUBLIC(cJSON *) cJSON_CreateNumber(double num);
+CJSON_PUBLIC(cJSON *) cJSON_CreateInt64(cJSON_int64 num);
 CJSON_PUBLIC(cJSON *) cJSON_CreateString(const char *string);
 /* raw json */
 CJSON_PUBLIC(cJSON *) cJSON_CreateRaw(const char *raw);
@@ -223,6 +402,20 @@ CJSON_PUBLIC(cJSON *) cJSON_CreateIntArray(const int *numbers, int count);
 CJSON_PUBLIC(cJSON *) cJSON_CreateFloatArray(const float *numbers, int count);
 CJSON_PUBLIC(cJSON *) cJSON_CreateDoubleArray(const double *numbers, int count);
 CJSON_PUBLIC(cJSON *) cJSON_CreateStringArray(const char *const *strings, int count);
+/* Packed arrays keep the numbers in one block instead of an item per element. They are printed, compared,
+ * duplicated and read by cJSON_GetArraySize, cJSON_Get...Array and cJSON_GetPackedNumber as they are.
+ * The first call that needs their items (cJSON_GetArrayItem, cJSON_GetChild, cJSON_ArrayForEach, the
+ * modifying functions and cJSON_Unshare) expands them into items, which fails only when out of memory.
+ * Reading through ->child directly sees no items until then. */
+CJSON_PUBLIC(cJSON *) cJSON_CreatePackedDoubleArray(const double *numbers, int count);
+CJSON_PUBLIC(cJSON *) cJSON_CreatePackedInt64Array(const cJSON_int64 *numbers, int count);
+/* Copy the first count numbers of an array (packed or not) into numbers. Returns how many were copied,
+ * fewer if the array is shorter, or -1 if it isn't an array or one of them isn't a number. */
+CJSON_PUBLIC(int) cJSON_GetDoubleArray(const cJSON *array, double *numbers, int count);
+CJSON_PUBLIC(int) cJSON_GetInt64Array(const cJSON *array, cJSON_int64 *numbers, int count);
+/* Write number index of a packed array into *number, the item it would expand to. number may point into
+ * the array, so it is valid until the array changes. Returns false if array isn't packed or is shorter. */
+CJSON_PUBLIC(cJSON_bool) cJSON_GetPackedNumber(const cJSON *array, int index, cJSON *number);
 
 /* Append item to the specified array/object. */
 CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToArray(cJSON *array, cJSON *item);
@@ -256,6 +449,20 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse);
 /* Duplicate will create a new, identical cJSON item to the one you pass, in new memory that will
  * need to be released. With recurse!=0, it will duplicate any children connected to the item.
  * The item->next and ->prev pointers are always zero on return from Duplicate. */
+/* Duplicate an array or object without copying its children: the copy shares them with item until
+ * one of the two trees uses them. cJSON_GetObjectItem..., cJSON_GetArrayItem, cJSON_GetChild,
+ * cJSON_ArrayForEach and the modifying functions (cJSON_AddItemTo..., cJSON_InsertItemInArray,
+ * cJSON_Detach..., cJSON_Delete...From..., cJSON_Replace...) give the array or object they get to
+ * its own copy of the children first, one level deep, so only the path to what is used gets copied
+ * and both trees stay changeable. Items have to be looked up again after the copy is made: pointers
+ * from before it, and children reached through ->child, can belong to both trees.
+ * Since looking items up can copy them, shared trees must not be used from different threads at the
+ * same time, not even for reading. Falls back to cJSON_Duplicate(item, 1) for references and arena
+ * items and returns NULL when out of memory. */
+CJSON_PUBLIC(cJSON *) cJSON_DuplicateShared(cJSON *item);
+/* Give item its own copy of its children, if they are shared, or expand it if it is a packed array.
+ * Returns false when out of memory. */
+CJSON_PUBLIC(cJSON_bool) cJSON_Unshare(cJSON *item);
 /* Recursively compare two cJSON items for equality. If either a or b is NULL or invalid, they will be considered unequal.
  * case_sensitive determines if object keys are treated case sensitive (1) or case insensitive (0) */
 CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * const b, const cJSON_bool case_sensitive);
@@ -292,8 +499,12 @@ CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
     cJSON_Invalid\
 )
 
+/* First child of an array or object. A packed array is expanded and children shared with a copy are
+ * copied first, see cJSON_CreatePackedDoubleArray and cJSON_DuplicateShared. */
+CJSON_PUBLIC(cJSON *) cJSON_GetChild(const cJSON *item);
+
 /* Macro for iterating over an array or object */
-#define cJSON_ArrayForEach(element, array) for(element = (array != NULL) ? (array)->child : NULL; element != NULL; element = element->next)
+#define cJSON_ArrayForEach(element, array) for(element = cJSON_GetChild(array); element != NULL; element = element->next)
 
 /* malloc/free objects using the malloc/free functions that have been set with cJSON_InitHooks */
 CJSON_PUBLIC(void *) cJSON_malloc(size_t size);
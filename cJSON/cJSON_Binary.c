@@ -0,0 +1,1191 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+/* disable warnings about old C89 functions in MSVC */
+#if !defined(_CRT_SECURE_NO_DEPRECATE) && defined(_MSC_VER)
+#define _CRT_SECURE_NO_DEPRECATE
+#endif
+
+#ifdef __GNUCC__
+#pragma GCC visibility push(default)
+#endif
+#if defined(_MSC_VER)
+#pragma warning (push)
+/* disable warning about single line comments in system headers */
+#pragma warning (disable : 4001)
+#endif
+
+#include <ctype.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+
+#if defined(_MSC_VER)
+#pragma warning (pop)
+#endif
+#ifdef __GNUCC__
+#pragma GCC visibility pop
+#endif
+
+#include "cJSON_Binary.h"
+
+/* define our own boolean type */
+#ifdef true
+#undef true
+#endif
+#define true ((cJSON_bool)1)
+
+#ifdef false
+#undef false
+#endif
+#define false ((cJSON_bool)0)
+
+#ifndef NAN
+#ifdef _WIN32
+#define NAN sqrt(-1.0)
+#else
+#define NAN 0.0/0.0
+#endif
+#endif
+
+#if defined(_MSC_VER)
+typedef unsigned __int64 cjson_uint64;
+#else
+#if defined(__GNUC__)
+__extension__
+#endif
+typedef unsigned long long cjson_uint64;
+#endif
+
+#ifndef CJSON_PRINT_CHUNK_SIZE
+#define CJSON_PRINT_CHUNK_SIZE (64 * 1024)
+#endif
+
+/* CBOR major types */
+#define CBOR_UNSIGNED 0
+#define CBOR_NEGATIVE 1
+#define CBOR_BYTES 2
+#define CBOR_TEXT 3
+#define CBOR_ARRAY 4
+#define CBOR_MAP 5
+#define CBOR_TAG 6
+#define CBOR_SIMPLE 7
+/* argument of indefinite length items and of the break that ends them */
+#define CBOR_INDEFINITE 31
+#define CBOR_BREAK 0xFF
+#define CBOR_TAG_EMBEDDED_JSON 262
+
+typedef struct
+{
+    unsigned char *buffer;
+    size_t length;
+    size_t offset;
+    /* if not NULL, full buffers are handed to the writer instead of growing them */
+    cJSON_Writer writer;
+    void *context;
+} binary_output;
+
+/* make room for needed more bytes, returns where to write them */
+static unsigned char *binary_ensure(binary_output * const output, const size_t needed)
+{
+    unsigned char *grown = NULL;
+    size_t length = 0;
+
+    if (needed <= (output->length - output->offset))
+    {
+        return output->buffer + output->offset;
+    }
+
+    if (output->writer != NULL)
+    {
+        if ((output->offset > 0) && !output->writer(output->context, (const char*)output->buffer, output->offset))
+        {
+            return NULL;
+        }
+        output->offset = 0;
+        if (needed <= output->length)
+        {
+            return output->buffer;
+        }
+    }
+
+    length = output->length;
+    while ((length - output->offset) < needed)
+    {
+        if (length > (((size_t)-1) / 2))
+        {
+            return NULL; /* overflow */
+        }
+        length *= 2;
+    }
+    grown = (unsigned char*)cJSON_malloc(length);
+    if (grown == NULL)
+    {
+        return NULL;
+    }
+    memcpy(grown, output->buffer, output->offset);
+    cJSON_free(output->buffer);
+    output->buffer = grown;
+    output->length = length;
+
+    return output->buffer + output->offset;
+}
+
+static cJSON_bool binary_write(binary_output * const output, const unsigned char * const data, const size_t length)
+{
+    unsigned char *target = NULL;
+
+    if ((output->writer != NULL) && (length > output->length))
+    {
+        /* long strings go to the writer directly instead of through the buffer */
+        if ((output->offset > 0) && !output->writer(output->context, (const char*)output->buffer, output->offset))
+        {
+            return false;
+        }
+        output->offset = 0;
+        return output->writer(output->context, (const char*)data, length);
+    }
+
+    target = binary_ensure(output, length);
+    if (target == NULL)
+    {
+        return false;
+    }
+    if (length > 0)
+    {
+        memcpy(target, data, length);
+    }
+    output->offset += length;
+
+    return true;
+}
+
+/* store value big endian in size bytes */
+static void store_big_endian(unsigned char * const target, cjson_uint64 value, const size_t size)
+{
+    size_t i = size;
+    while (i > 0)
+    {
+        target[--i] = (unsigned char)(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+static cjson_uint64 load_big_endian(const unsigned char * const source, const size_t size)
+{
+    cjson_uint64 value = 0;
+    size_t i = 0;
+    for (i = 0; i < size; i++)
+    {
+        value = (value << 8) | source[i];
+    }
+
+    return value;
+}
+
+/* a one byte type followed by size bytes of value */
+static cJSON_bool write_typed(binary_output * const output, const unsigned char type, const cjson_uint64 value, const size_t size)
+{
+    unsigned char *target = binary_ensure(output, size + 1);
+    if (target == NULL)
+    {
+        return false;
+    }
+    target[0] = type;
+    store_big_endian(target + 1, value, size);
+    output->offset += size + 1;
+
+    return true;
+}
+
+static cjson_uint64 double_bits(const double number)
+{
+    cjson_uint64 bits = 0;
+    memcpy(&bits, &number, sizeof(bits));
+    return bits;
+}
+
+static double bits_double(const cjson_uint64 bits)
+{
+    double number = 0;
+    memcpy(&number, &bits, sizeof(number));
+    return number;
+}
+
+static cjson_uint64 float_bits(const float number)
+{
+    unsigned int bits = 0;
+    memcpy(&bits, &number, sizeof(bits));
+    return bits;
+}
+
+static double bits_float(const cjson_uint64 bits)
+{
+    unsigned int value = (unsigned int)bits;
+    float number = 0;
+    memcpy(&number, &value, sizeof(number));
+    return number;
+}
+
+/* true if the number survives the round trip through single precision (NaN does as well) */
+static cJSON_bool fits_float(const double number)
+{
+    float single = (float)number;
+
+    if (number != number)
+    {
+        return true;
+    }
+    if ((number > 3.4028234663852886e38) || (number < -3.4028234663852886e38))
+    {
+        /* infinity converts, but anything else that large would overflow */
+        return (number - number) != (number - number);
+    }
+
+    return (double)single == number;
+}
+
+/* decode an IEEE 754 half precision float */
+static double half_float(const unsigned int half)
+{
+    unsigned int exponent = (half >> 10) & 0x1F;
+    unsigned int mantissa = half & 0x3FF;
+    double value = 0;
+
+    if (exponent == 0)
+    {
+        value = ldexp((double)mantissa, -24);
+    }
+    else if (exponent != 31)
+    {
+        value = ldexp((double)(mantissa + 1024), (int)exponent - 25);
+    }
+    else if (mantissa == 0)
+    {
+        value = HUGE_VAL;
+    }
+    else
+    {
+        value = NAN;
+    }
+
+    return (half & 0x8000) ? -value : value;
+}
+
+/* the string to encode for a string or raw item, NULL strings are empty like in cJSON_Print */
+static const char *item_string(const cJSON * const item)
+{
+    return (item->valuestring != NULL) ? item->valuestring : "";
+}
+
+/* CBOR encoding */
+
+/* the head of a data item: major type and argument in the shortest form */
+static cJSON_bool cbor_write_head(binary_output * const output, const unsigned char major, const cjson_uint64 argument)
+{
+    unsigned char type = (unsigned char)(major << 5);
+
+    if (argument < 24)
+    {
+        return write_typed(output, (unsigned char)(type | argument), 0, 0);
+    }
+    if (argument <= 0xFF)
+    {
+        return write_typed(output, (unsigned char)(type | 24), argument, 1);
+    }
+    if (argument <= 0xFFFF)
+    {
+        return write_typed(output, (unsigned char)(type | 25), argument, 2);
+    }
+    if (argument <= 0xFFFFFFFFUL)
+    {
+        return write_typed(output, (unsigned char)(type | 26), argument, 4);
+    }
+
+    return write_typed(output, (unsigned char)(type | 27), argument, 8);
+}
+
+static cJSON_bool cbor_write_string(binary_output * const output, const char * const string)
+{
+    size_t length = strlen(string);
+    return cbor_write_head(output, CBOR_TEXT, length) && binary_write(output, (const unsigned char*)string, length);
+}
+
+/* the exact value of an integral number, false for other numbers */
+static cJSON_bool integer_value(const cJSON * const item, cJSON_int64 * const integer)
+{
+    if (!(item->type & cJSON_IsInt64))
+    {
+        return false;
+    }
+    *integer = cJSON_GetInt64Value(item);
+
+    /* valuedouble may have been written directly */
+    return (double)*integer == item->valuedouble;
+}
+
+static cJSON_bool cbor_encode(const cJSON * const item, binary_output * const output, const size_t depth)
+{
+    const cJSON *child = NULL;
+    cJSON number;
+    int index = 0;
+    cJSON_int64 integer = 0;
+
+    switch (item->type & 0xFF)
+    {
+        case cJSON_NULL:
+            return write_typed(output, (CBOR_SIMPLE << 5) | 22, 0, 0);
+
+        case cJSON_False:
+            return write_typed(output, (CBOR_SIMPLE << 5) | 20, 0, 0);
+
+        case cJSON_True:
+            return write_typed(output, (CBOR_SIMPLE << 5) | 21, 0, 0);
+
+        case cJSON_Number:
+            if (integer_value(item, &integer))
+            {
+                if (integer < 0)
+                {
+                    /* -1 - n */
+                    return cbor_write_head(output, CBOR_NEGATIVE, (cjson_uint64)(-(integer + 1)));
+                }
+                return cbor_write_head(output, CBOR_UNSIGNED, (cjson_uint64)integer);
+            }
+            if (fits_float(item->valuedouble))
+            {
+                return write_typed(output, (CBOR_SIMPLE << 5) | 26, float_bits((float)item->valuedouble), 4);
+            }
+            return write_typed(output, (CBOR_SIMPLE << 5) | 27, double_bits(item->valuedouble), 8);
+
+        case cJSON_String:
+            return cbor_write_string(output, item_string(item));
+
+        case cJSON_Raw:
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+            return cbor_write_head(output, CBOR_TAG, CBOR_TAG_EMBEDDED_JSON) && cbor_write_string(output, item->valuestring);
+
+        case cJSON_Array:
+        case cJSON_Object:
+            if (depth >= CJSON_NESTING_LIMIT)
+            {
+                return false;
+            }
+            if (!cbor_write_head(output, ((item->type & 0xFF) == cJSON_Array) ? CBOR_ARRAY : CBOR_MAP, (cjson_uint64)cJSON_GetArraySize(item)))
+            {
+                return false;
+            }
+            /* packed arrays are read as they are, they have no children */
+            for (index = 0; cJSON_GetPackedNumber(item, index, &number); index++)
+            {
+                if (!cbor_encode(&number, output, depth + 1))
+                {
+                    return false;
+                }
+            }
+            for (child = item->child; child != NULL; child = child->next)
+            {
+                if (((item->type & 0xFF) == cJSON_Object) && !cbor_write_string(output, (child->string != NULL) ? child->string : ""))
+                {
+                    return false;
+                }
+                if (!cbor_encode(child, output, depth + 1))
+                {
+                    return false;
+                }
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/* MessagePack encoding */
+
+/* the smallest of the typed forms that holds value: the one byte fixed form if small is not 0, then 8 .. 32 bit */
+static cJSON_bool msgpack_write_length(binary_output * const output, const unsigned char small, const size_t small_limit, const unsigned char type8, const unsigned char type16, const unsigned char type32, const size_t length)
+{
+    if ((small != 0) && (length < small_limit))
+    {
+        return write_typed(output, (unsigned char)(small | length), 0, 0);
+    }
+    if ((type8 != 0) && (length <= 0xFF))
+    {
+        return write_typed(output, type8, length, 1);
+    }
+    if (length <= 0xFFFF)
+    {
+        return write_typed(output, type16, length, 2);
+    }
+    if ((cjson_uint64)length <= 0xFFFFFFFFUL)
+    {
+        return write_typed(output, type32, length, 4);
+    }
+
+    return false; /* too long for MessagePack */
+}
+
+static cJSON_bool msgpack_write_string(binary_output * const output, const char * const string)
+{
+    size_t length = strlen(string);
+    return msgpack_write_length(output, 0xA0, 32, 0xD9, 0xDA, 0xDB, length) && binary_write(output, (const unsigned char*)string, length);
+}
+
+static cJSON_bool msgpack_write_integer(binary_output * const output, const cJSON_int64 number)
+{
+    if (number >= 0)
+    {
+        if (number < 128)
+        {
+            return write_typed(output, (unsigned char)number, 0, 0);
+        }
+        if (number <= 0xFF)
+        {
+            return write_typed(output, 0xCC, (cjson_uint64)number, 1);
+        }
+        if (number <= 0xFFFF)
+        {
+            return write_typed(output, 0xCD, (cjson_uint64)number, 2);
+        }
+        if (number <= 0xFFFFFFFFL)
+        {
+            return write_typed(output, 0xCE, (cjson_uint64)number, 4);
+        }
+        return write_typed(output, 0xCF, (cjson_uint64)number, 8);
+    }
+
+    if (number >= -32)
+    {
+        return write_typed(output, (unsigned char)(0xE0 | (number + 32)), 0, 0);
+    }
+    if (number >= -128)
+    {
+        return write_typed(output, 0xD0, (cjson_uint64)number & 0xFF, 1);
+    }
+    if (number >= -32768)
+    {
+        return write_typed(output, 0xD1, (cjson_uint64)number & 0xFFFF, 2);
+    }
+    if (number >= (-2147483647L - 1))
+    {
+        return write_typed(output, 0xD2, (cjson_uint64)number & 0xFFFFFFFFUL, 4);
+    }
+
+    return write_typed(output, 0xD3, (cjson_uint64)number, 8);
+}
+
+static cJSON_bool msgpack_encode(const cJSON * const item, binary_output * const output, const size_t depth)
+{
+    const cJSON *child = NULL;
+    cJSON number;
+    int index = 0;
+    cJSON_int64 integer = 0;
+    size_t length = 0;
+
+    switch (item->type & 0xFF)
+    {
+        case cJSON_NULL:
+            return write_typed(output, 0xC0, 0, 0);
+
+        case cJSON_False:
+            return write_typed(output, 0xC2, 0, 0);
+
+        case cJSON_True:
+            return write_typed(output, 0xC3, 0, 0);
+
+        case cJSON_Number:
+            if (integer_value(item, &integer))
+            {
+                return msgpack_write_integer(output, integer);
+            }
+            if (fits_float(item->valuedouble))
+            {
+                return write_typed(output, 0xCA, float_bits((float)item->valuedouble), 4);
+            }
+            return write_typed(output, 0xCB, double_bits(item->valuedouble), 8);
+
+        case cJSON_String:
+            return msgpack_write_string(output, item_string(item));
+
+        case cJSON_Raw:
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+            /* ext 8/16/32: length, type, data */
+            length = strlen(item->valuestring);
+            return msgpack_write_length(output, 0, 0, 0xC7, 0xC8, 0xC9, length)
+                && write_typed(output, CJSON_MSGPACK_RAW_TYPE, 0, 0)
+                && binary_write(output, (const unsigned char*)item->valuestring, length);
+
+        case cJSON_Array:
+        case cJSON_Object:
+            if (depth >= CJSON_NESTING_LIMIT)
+            {
+                return false;
+            }
+            length = (size_t)cJSON_GetArraySize(item);
+            if (((item->type & 0xFF) == cJSON_Array) ? !msgpack_write_length(output, 0x90, 16, 0, 0xDC, 0xDD, length)
+                                                     : !msgpack_write_length(output, 0x80, 16, 0, 0xDE, 0xDF, length))
+            {
+                return false;
+            }
+            for (index = 0; cJSON_GetPackedNumber(item, index, &number); index++)
+            {
+                if (!msgpack_encode(&number, output, depth + 1))
+                {
+                    return false;
+                }
+            }
+            for (child = item->child; child != NULL; child = child->next)
+            {
+                if (((item->type & 0xFF) == cJSON_Object) && !msgpack_write_string(output, (child->string != NULL) ? child->string : ""))
+                {
+                    return false;
+                }
+                if (!msgpack_encode(child, output, depth + 1))
+                {
+                    return false;
+                }
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+typedef cJSON_bool (*binary_encoder)(const cJSON * const item, binary_output * const output, const size_t depth);
+
+static unsigned char *encode(const cJSON * const item, size_t * const length, const binary_encoder encoder)
+{
+    binary_output output;
+
+    if ((item == NULL) || (length == NULL))
+    {
+        return NULL;
+    }
+
+    memset(&output, '\0', sizeof(output));
+    output.length = 256;
+    output.buffer = (unsigned char*)cJSON_malloc(output.length);
+    if (output.buffer == NULL)
+    {
+        return NULL;
+    }
+
+    if (!encoder(item, &output, 0))
+    {
+        cJSON_free(output.buffer);
+        return NULL;
+    }
+
+    *length = output.offset;
+    return output.buffer;
+}
+
+static cJSON_bool encode_to_writer(const cJSON * const item, const cJSON_Writer writer, void * const context, const binary_encoder encoder)
+{
+    binary_output output;
+    cJSON_bool success = false;
+
+    if ((item == NULL) || (writer == NULL))
+    {
+        return false;
+    }
+
+    memset(&output, '\0', sizeof(output));
+    output.length = CJSON_PRINT_CHUNK_SIZE;
+    output.buffer = (unsigned char*)cJSON_malloc(output.length);
+    if (output.buffer == NULL)
+    {
+        return false;
+    }
+    output.writer = writer;
+    output.context = context;
+
+    success = encoder(item, &output, 0) && ((output.offset == 0) || writer(context, (const char*)output.buffer, output.offset));
+    cJSON_free(output.buffer);
+
+    return success;
+}
+
+CJSON_PUBLIC(unsigned char *) cJSON_EncodeCBOR(const cJSON *item, size_t *length)
+{
+    return encode(item, length, cbor_encode);
+}
+
+CJSON_PUBLIC(unsigned char *) cJSON_EncodeMessagePack(const cJSON *item, size_t *length)
+{
+    return encode(item, length, msgpack_encode);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_EncodeCBORToWriter(const cJSON *item, cJSON_Writer writer, void *context)
+{
+    return encode_to_writer(item, writer, context, cbor_encode);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_EncodeMessagePackToWriter(const cJSON *item, cJSON_Writer writer, void *context)
+{
+    return encode_to_writer(item, writer, context, msgpack_encode);
+}
+
+typedef struct
+{
+    const unsigned char *content;
+    size_t length;
+    size_t offset;
+} binary_input;
+
+#define can_read(input, size) (((input)->length - (input)->offset) >= (size))
+
+static cJSON_bool read_big_endian(binary_input * const input, const size_t size, cjson_uint64 * const value)
+{
+    if (!can_read(input, size))
+    {
+        return false;
+    }
+    *value = load_big_endian(input->content + input->offset, size);
+    input->offset += size;
+
+    return true;
+}
+
+/* copy length bytes of the input into a new string */
+static char *read_text(binary_input * const input, const cjson_uint64 length)
+{
+    char *text = NULL;
+
+    if (!can_read(input, length))
+    {
+        return NULL;
+    }
+    text = (char*)cJSON_malloc((size_t)length + 1);
+    if (text == NULL)
+    {
+        return NULL;
+    }
+    memcpy(text, input->content + input->offset, (size_t)length);
+    text[length] = '\0';
+    input->offset += (size_t)length;
+
+    return text;
+}
+
+/* a string item that takes over text, text is freed if that fails */
+static cJSON *create_string(char * const text, const int type)
+{
+    cJSON *item = NULL;
+
+    if (text == NULL)
+    {
+        return NULL;
+    }
+    item = cJSON_CreateNull();
+    if (item == NULL)
+    {
+        cJSON_free(text);
+        return NULL;
+    }
+    item->type = type;
+    item->valuestring = text;
+
+    return item;
+}
+
+/* an integer from its magnitude, -1 - magnitude if negative */
+static cJSON *create_integer(const cjson_uint64 magnitude, const cJSON_bool negative)
+{
+    const cjson_uint64 int64_max = ((cjson_uint64)~(cjson_uint64)0) >> 1;
+
+    if (magnitude > int64_max)
+    {
+        /* beyond 64 bit signed, only approximately representable */
+        return cJSON_CreateNumber(negative ? (-1.0 - (double)magnitude) : (double)magnitude);
+    }
+
+    return cJSON_CreateInt64(negative ? (-1 - (cJSON_int64)magnitude) : (cJSON_int64)magnitude);
+}
+
+/* add child to a container built by a decoder, child is deleted if that fails */
+static cJSON_bool add_child(cJSON * const container, cJSON * const child)
+{
+    if (!cJSON_AddItemToArray(container, child))
+    {
+        cJSON_Delete(child);
+        return false;
+    }
+
+    return true;
+}
+
+/* CBOR decoding */
+
+/* read the head of a data item, the argument of indefinite lengths is CBOR_INDEFINITE */
+static cJSON_bool cbor_read_head(binary_input * const input, unsigned char * const major, unsigned char * const info, cjson_uint64 * const argument)
+{
+    if (!can_read(input, 1))
+    {
+        return false;
+    }
+    *major = (unsigned char)(input->content[input->offset] >> 5);
+    *info = (unsigned char)(input->content[input->offset] & 0x1F);
+    input->offset++;
+
+    if (*info < 24)
+    {
+        *argument = *info;
+        return true;
+    }
+    switch (*info)
+    {
+        case 24:
+            return read_big_endian(input, 1, argument);
+        case 25:
+            return read_big_endian(input, 2, argument);
+        case 26:
+            return read_big_endian(input, 4, argument);
+        case 27:
+            return read_big_endian(input, 8, argument);
+        case CBOR_INDEFINITE:
+            *argument = CBOR_INDEFINITE;
+            /* only strings and containers have an indefinite length, simple values use it for break */
+            return (*major == CBOR_BYTES) || (*major == CBOR_TEXT) || (*major == CBOR_ARRAY) || (*major == CBOR_MAP) || (*major == CBOR_SIMPLE);
+        default:
+            return false;
+    }
+}
+
+/* true and skips the break if the next byte ends an indefinite length item */
+static cJSON_bool cbor_at_break(binary_input * const input)
+{
+    if (can_read(input, 1) && (input->content[input->offset] == CBOR_BREAK))
+    {
+        input->offset++;
+        return true;
+    }
+
+    return false;
+}
+
+/* the contents of a text string with the given head */
+static char *cbor_read_text(binary_input * const input, const unsigned char info, const cjson_uint64 argument)
+{
+    size_t start = 0;
+    size_t length = 0;
+    char *text = NULL;
+    unsigned char major = 0;
+    unsigned char chunk_info = 0;
+    cjson_uint64 chunk = 0;
+
+    if (info != CBOR_INDEFINITE)
+    {
+        return read_text(input, argument);
+    }
+
+    /* definite length chunks until break: measure them, then copy them together */
+    start = input->offset;
+    while (!cbor_at_break(input))
+    {
+        if (!cbor_read_head(input, &major, &chunk_info, &chunk) || (major != CBOR_TEXT) || (chunk_info == CBOR_INDEFINITE) || !can_read(input, chunk))
+        {
+            return NULL;
+        }
+        input->offset += (size_t)chunk;
+        length += (size_t)chunk;
+    }
+
+    text = (char*)cJSON_malloc(length + 1);
+    if (text == NULL)
+    {
+        return NULL;
+    }
+    input->offset = start;
+    length = 0;
+    while (!cbor_at_break(input))
+    {
+        cbor_read_head(input, &major, &chunk_info, &chunk);
+        memcpy(text + length, input->content + input->offset, (size_t)chunk);
+        input->offset += (size_t)chunk;
+        length += (size_t)chunk;
+    }
+    text[length] = '\0';
+
+    return text;
+}
+
+static cJSON *cbor_decode(binary_input * const input, const size_t depth)
+{
+    unsigned char major = 0;
+    unsigned char info = 0;
+    cjson_uint64 argument = 0;
+    cJSON *item = NULL;
+    cJSON *child = NULL;
+    cjson_uint64 i = 0;
+
+    if (!cbor_read_head(input, &major, &info, &argument))
+    {
+        return NULL;
+    }
+
+    switch (major)
+    {
+        case CBOR_UNSIGNED:
+            return create_integer(argument, false);
+
+        case CBOR_NEGATIVE:
+            return create_integer(argument, true);
+
+        case CBOR_TEXT:
+            return create_string(cbor_read_text(input, info, argument), cJSON_String);
+
+        case CBOR_ARRAY:
+        case CBOR_MAP:
+            if (depth >= CJSON_NESTING_LIMIT)
+            {
+                return NULL;
+            }
+            item = (major == CBOR_ARRAY) ? cJSON_CreateArray() : cJSON_CreateObject();
+            if (item == NULL)
+            {
+                return NULL;
+            }
+            /* the count comes from the input, so nothing is allocated for it up front */
+            for (i = 0; (info == CBOR_INDEFINITE) ? !cbor_at_break(input) : (i < argument); i++)
+            {
+                char *key = NULL;
+                if (major == CBOR_MAP)
+                {
+                    unsigned char key_major = 0;
+                    unsigned char key_info = 0;
+                    cjson_uint64 key_argument = 0;
+                    if (!cbor_read_head(input, &key_major, &key_info, &key_argument) || (key_major != CBOR_TEXT))
+                    {
+                        goto fail; /* keys have to be text */
+                    }
+                    key = cbor_read_text(input, key_info, key_argument);
+                    if (key == NULL)
+                    {
+                        goto fail;
+                    }
+                }
+                child = cbor_decode(input, depth + 1);
+                if (child == NULL)
+                {
+                    cJSON_free(key);
+                    goto fail;
+                }
+                child->string = key;
+                if (!add_child(item, child))
+                {
+                    goto fail;
+                }
+            }
+            return item;
+
+        case CBOR_TAG:
+            /* tags count as a level of nesting, so chains of them are limited as well */
+            if (depth >= CJSON_NESTING_LIMIT)
+            {
+                return NULL;
+            }
+            if (argument == CBOR_TAG_EMBEDDED_JSON)
+            {
+                item = cbor_decode(input, depth + 1);
+                if ((item != NULL) && ((item->type & 0xFF) == cJSON_String))
+                {
+                    item->type = cJSON_Raw;
+                    return item;
+                }
+                goto fail;
+            }
+            /* other tags only add meaning JSON can't express, the value stays the same */
+            return cbor_decode(input, depth + 1);
+
+        case CBOR_SIMPLE:
+            switch (info)
+            {
+                case 20:
+                    return cJSON_CreateFalse();
+                case 21:
+                    return cJSON_CreateTrue();
+                case 22:
+                case 23: /* undefined */
+                    return cJSON_CreateNull();
+                case 25:
+                    return cJSON_CreateNumber(half_float((unsigned int)argument));
+                case 26:
+                    return cJSON_CreateNumber(bits_float(argument));
+                case 27:
+                    return cJSON_CreateNumber(bits_double(argument));
+                default:
+                    return NULL;
+            }
+
+        default:
+            /* byte strings */
+            return NULL;
+    }
+
+fail:
+    cJSON_Delete(item);
+    return NULL;
+}
+
+/* MessagePack decoding */
+
+static cJSON *msgpack_decode(binary_input * const input, const size_t depth);
+
+/* the contents of a string (fixstr or str 8/16/32), NULL for other types */
+static char *msgpack_read_text(binary_input * const input)
+{
+    unsigned char type = 0;
+    cjson_uint64 length = 0;
+
+    if (!can_read(input, 1))
+    {
+        return NULL;
+    }
+    type = input->content[input->offset++];
+
+    if ((type & 0xE0) == 0xA0)
+    {
+        length = type & 0x1F;
+    }
+    else if ((type < 0xD9) || (type > 0xDB) || !read_big_endian(input, (size_t)1 << (type - 0xD9), &length))
+    {
+        return NULL;
+    }
+
+    return read_text(input, length);
+}
+
+/* read count members into an array or object */
+static cJSON *msgpack_read_container(binary_input * const input, const size_t depth, const cJSON_bool object, const cjson_uint64 count)
+{
+    cJSON *item = NULL;
+    cJSON *child = NULL;
+    cjson_uint64 i = 0;
+
+    if (depth >= CJSON_NESTING_LIMIT)
+    {
+        return NULL;
+    }
+    item = object ? cJSON_CreateObject() : cJSON_CreateArray();
+    if (item == NULL)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        char *key = NULL;
+        if (object)
+        {
+            key = msgpack_read_text(input);
+            if (key == NULL)
+            {
+                goto fail; /* keys have to be strings */
+            }
+        }
+        child = msgpack_decode(input, depth + 1);
+        if (child == NULL)
+        {
+            cJSON_free(key);
+            goto fail;
+        }
+        child->string = key;
+        if (!add_child(item, child))
+        {
+            goto fail;
+        }
+    }
+
+    return item;
+
+fail:
+    cJSON_Delete(item);
+    return NULL;
+}
+
+/* the raw extension with a length of size bytes, or fixed_length if size is 0 */
+static cJSON *msgpack_read_extension(binary_input * const input, const size_t size, const cjson_uint64 fixed_length)
+{
+    cjson_uint64 length = fixed_length;
+
+    if ((size > 0) && !read_big_endian(input, size, &length))
+    {
+        return NULL;
+    }
+    if (!can_read(input, 1) || (input->content[input->offset] != CJSON_MSGPACK_RAW_TYPE))
+    {
+        return NULL; /* only raw JSON is known */
+    }
+    input->offset++;
+
+    return create_string(read_text(input, length), cJSON_Raw);
+}
+
+static cJSON *msgpack_decode(binary_input * const input, const size_t depth)
+{
+    unsigned char type = 0;
+    cjson_uint64 value = 0;
+
+    if (!can_read(input, 1))
+    {
+        return NULL;
+    }
+    type = input->content[input->offset++];
+
+    if (type <= 0x7F)
+    {
+        return cJSON_CreateInt64(type);
+    }
+    if (type >= 0xE0)
+    {
+        return cJSON_CreateInt64((cJSON_int64)type - 256);
+    }
+    if ((type & 0xF0) == 0x80)
+    {
+        return msgpack_read_container(input, depth, true, type & 0x0F);
+    }
+    if ((type & 0xF0) == 0x90)
+    {
+        return msgpack_read_container(input, depth, false, type & 0x0F);
+    }
+    if (((type & 0xE0) == 0xA0) || ((type >= 0xD9) && (type <= 0xDB)))
+    {
+        input->offset--;
+        return create_string(msgpack_read_text(input), cJSON_String);
+    }
+
+    switch (type)
+    {
+        case 0xC0:
+            return cJSON_CreateNull();
+        case 0xC2:
+            return cJSON_CreateFalse();
+        case 0xC3:
+            return cJSON_CreateTrue();
+
+        /* ext 8/16/32 and fixext 1/2/4/8/16 */
+        case 0xC7:
+            return msgpack_read_extension(input, 1, 0);
+        case 0xC8:
+            return msgpack_read_extension(input, 2, 0);
+        case 0xC9:
+            return msgpack_read_extension(input, 4, 0);
+        case 0xD4:
+        case 0xD5:
+        case 0xD6:
+        case 0xD7:
+        case 0xD8:
+            return msgpack_read_extension(input, 0, (cjson_uint64)1 << (type - 0xD4));
+
+        case 0xCA:
+            return read_big_endian(input, 4, &value) ? cJSON_CreateNumber(bits_float(value)) : NULL;
+        case 0xCB:
+            return read_big_endian(input, 8, &value) ? cJSON_CreateNumber(bits_double(value)) : NULL;
+
+        /* uint 8 .. 64 */
+        case 0xCC:
+        case 0xCD:
+        case 0xCE:
+        case 0xCF:
+            return read_big_endian(input, (size_t)1 << (type - 0xCC), &value) ? create_integer(value, false) : NULL;
+
+        /* int 8 .. 64: sign extend */
+        case 0xD0:
+        case 0xD1:
+        case 0xD2:
+        case 0xD3:
+        {
+            size_t size = (size_t)1 << (type - 0xD0);
+            if (!read_big_endian(input, size, &value))
+            {
+                return NULL;
+            }
+            if ((size < 8) && (value & ((cjson_uint64)1 << ((size * 8) - 1))))
+            {
+                value |= ~(cjson_uint64)0 << (size * 8);
+            }
+            if (value & ((cjson_uint64)1 << 63))
+            {
+                return create_integer(~value, true);
+            }
+            return create_integer(value, false);
+        }
+
+        /* array and map 16/32 */
+        case 0xDC:
+        case 0xDD:
+            return read_big_endian(input, (type == 0xDC) ? 2 : 4, &value) ? msgpack_read_container(input, depth, false, value) : NULL;
+        case 0xDE:
+        case 0xDF:
+            return read_big_endian(input, (type == 0xDE) ? 2 : 4, &value) ? msgpack_read_container(input, depth, true, value) : NULL;
+
+        default:
+            /* bin 8/16/32 and the unused 0xC1 */
+            return NULL;
+    }
+}
+
+typedef cJSON *(*binary_decoder)(binary_input * const input, const size_t depth);
+
+static cJSON *decode(const unsigned char * const data, const size_t length, size_t * const consumed, const binary_decoder decoder)
+{
+    binary_input input;
+    cJSON *item = NULL;
+
+    if (data == NULL)
+    {
+        return NULL;
+    }
+
+    input.content = data;
+    input.length = length;
+    input.offset = 0;
+
+    item = decoder(&input, 0);
+    if ((item != NULL) && (consumed != NULL))
+    {
+        *consumed = input.offset;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_DecodeCBOR(const unsigned char *data, size_t length, size_t *consumed)
+{
+    return decode(data, length, consumed, cbor_decode);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_DecodeMessagePack(const unsigned char *data, size_t length, size_t *consumed)
+{
+    return decode(data, length, consumed, msgpack_decode);
+}
@@ -0,0 +1,61 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#ifndef cJSON_Binary__h
+#define cJSON_Binary__h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "cJSON.h"
+
+/* Binary encodings of cJSON trees: CBOR (RFC 8949) and MessagePack.
+ * Integral numbers (cJSON_IsInt64) are encoded as integers, other numbers as floats (single precision where that
+ * is exact), strings with their length in front so they are copied without scanning or escaping.
+ * cJSON_Raw values are kept: in CBOR as a text string with tag 262 (embedded JSON), in MessagePack as an extension
+ * of type CJSON_MSGPACK_RAW_TYPE. Decoding fails on values JSON has no equivalent for (byte strings, non string keys
+ * and other extensions), unknown CBOR tags are skipped. Memory comes from the cJSON hooks.
+ * Arrays and objects can be nested up to CJSON_NESTING_LIMIT levels. */
+#ifndef CJSON_MSGPACK_RAW_TYPE
+#define CJSON_MSGPACK_RAW_TYPE 1
+#endif
+
+/* Encode into one allocation, free it with cJSON_free. length gets the number of bytes. */
+CJSON_PUBLIC(unsigned char *) cJSON_EncodeCBOR(const cJSON *item, size_t *length);
+CJSON_PUBLIC(unsigned char *) cJSON_EncodeMessagePack(const cJSON *item, size_t *length);
+/* Encode in chunks handed to writer, see cJSON_PrintToWriter. */
+CJSON_PUBLIC(cJSON_bool) cJSON_EncodeCBORToWriter(const cJSON *item, cJSON_Writer writer, void *context);
+CJSON_PUBLIC(cJSON_bool) cJSON_EncodeMessagePackToWriter(const cJSON *item, cJSON_Writer writer, void *context);
+
+/* Decode the first value in data, NULL if it is invalid or truncated. consumed (if not NULL) gets the number of
+ * bytes it took, so a stream of values (a CBOR sequence or MessagePack stream) can be decoded one after another. */
+CJSON_PUBLIC(cJSON *) cJSON_DecodeCBOR(const unsigned char *data, size_t length, size_t *consumed);
+CJSON_PUBLIC(cJSON *) cJSON_DecodeMessagePack(const unsigned char *data, size_t length, size_t *consumed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1491 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+/* disable warnings about old C89 functions in MSVC */
+#if !defined(_CRT_SECURE_NO_DEPRECATE) && defined(_MSC_VER)
+#define _CRT_SECURE_NO_DEPRECATE
+#endif
+
+#ifdef __GNUCC__
+#pragma GCC visibility push(default)
+#endif
+/* snapshots are mapped with mmap where POSIX is available, elsewhere they are read into memory */
+#if defined(__unix__) || defined(__APPLE__)
+#define CJSON_DOCUMENT_POSIX
+#if !defined(_POSIX_C_SOURCE) || (_POSIX_C_SOURCE < 200112L)
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#pragma warning (push)
+/* disable warning about single line comments in system headers */
+#pragma warning (disable : 4001)
+#endif
+
+#include <ctype.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+
+#ifdef CJSON_DOCUMENT_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined(_MSC_VER)
+#pragma warning (pop)
+#endif
+#ifdef __GNUCC__
+#pragma GCC visibility pop
+#endif
+
+#include "cJSON_Document.h"
+
+/* define our own boolean type */
+#ifdef true
+#undef true
+#endif
+#define true ((cJSON_bool)1)
+
+#ifdef false
+#undef false
+#endif
+#define false ((cJSON_bool)0)
+
+#ifndef NAN
+#ifdef _WIN32
+#define NAN sqrt(-1.0)
+#else
+#define NAN 0.0/0.0
+#endif
+#endif
+
+/* Tape entries are 16 bytes, so offsets and counts are 32 bit: a document can have up to UINT_MAX values
+ * and UINT_MAX bytes of strings. */
+typedef struct
+{
+    unsigned int type; /* cJSON_False ... cJSON_Object, cJSON_IsInt64 */
+    unsigned int key; /* offset of the key in the strings + 1, 0 if there is none */
+    union
+    {
+        double number;
+        cJSON_int64 integer; /* numbers with cJSON_IsInt64 */
+        struct
+        {
+            unsigned int end; /* index after the last value of the subtree */
+            unsigned int count;
+        } container;
+        struct
+        {
+            unsigned int offset;
+            unsigned int length;
+        } string;
+    } value;
+} document_entry;
+
+/* hash table of an object in a snapshot */
+typedef struct
+{
+    unsigned int object; /* index of the object in the tape */
+    unsigned int slots; /* offset of the table in the slots */
+    unsigned int mask; /* number of slots - 1 */
+} snapshot_index;
+
+struct cJSON_Document
+{
+    document_entry *tape;
+    size_t count;
+    size_t size;
+    char *strings; /* zero terminated strings one after the other */
+    size_t strings_length;
+    size_t strings_size;
+    /* snapshots: the hash tables sorted by object, their slots (tape indexes of the members, 0 if empty)
+     * and the file that tape, strings and tables point into */
+    const snapshot_index *indexes;
+    size_t indexes_count;
+    const unsigned int *slots;
+    void *mapping;
+    size_t mapping_size;
+};
+
+/* state while a document is built */
+typedef struct
+{
+    cJSON_Document *document;
+    /* hash set of the keys in the strings (offset + 1), every key is stored only once */
+    unsigned int *keys;
+    size_t keys_count;
+    size_t keys_mask;
+    /* event parsing: the open containers and the key of the next value */
+    size_t *stack;
+    size_t depth;
+    size_t stack_size;
+    unsigned int key;
+} document_builder;
+
+static void *grow(void * const memory, const size_t used, size_t * const size, const size_t needed, const size_t element_size)
+{
+    size_t new_size = (*size == 0) ? 64 : *size;
+    void *new_memory = NULL;
+
+    while (new_size < needed)
+    {
+        new_size *= 2;
+    }
+    if (new_size > (((size_t)-1) / element_size))
+    {
+        return NULL;
+    }
+
+    new_memory = cJSON_malloc(new_size * element_size);
+    if (new_memory == NULL)
+    {
+        return NULL;
+    }
+    if (memory != NULL)
+    {
+        memcpy(new_memory, memory, used * element_size);
+        cJSON_free(memory);
+    }
+    *size = new_size;
+
+    return new_memory;
+}
+
+static size_t add_entry(document_builder * const builder, const int type)
+{
+    cJSON_Document * const document = builder->document;
+
+    if (document->count >= UINT_MAX)
+    {
+        return CJSON_DOCUMENT_NONE;
+    }
+    if (document->count == document->size)
+    {
+        document_entry *tape = (document_entry*)grow(document->tape, document->count, &document->size, document->count + 1, sizeof(document_entry));
+        if (tape == NULL)
+        {
+            return CJSON_DOCUMENT_NONE;
+        }
+        document->tape = tape;
+    }
+
+    memset(&document->tape[document->count], '\0', sizeof(document_entry));
+    document->tape[document->count].type = (unsigned int)type;
+
+    return document->count++;
+}
+
+/* append a string to the strings, returns its offset + 1 or 0 on failure */
+static unsigned int add_string(document_builder * const builder, const char * const string, const size_t length)
+{
+    cJSON_Document * const document = builder->document;
+    size_t offset = document->strings_length;
+
+    if ((length >= UINT_MAX) || ((offset + length + 1) >= UINT_MAX))
+    {
+        return 0;
+    }
+    if ((document->strings_size - offset) < (length + 1))
+    {
+        char *strings = (char*)grow(document->strings, document->strings_length, &document->strings_size, offset + length + 1, 1);
+        if (strings == NULL)
+        {
+            return 0;
+        }
+        document->strings = strings;
+    }
+
+    memcpy(document->strings + offset, string, length);
+    document->strings[offset + length] = '\0';
+    document->strings_length += length + 1;
+
+    return (unsigned int)offset + 1;
+}
+
+static unsigned long hash_key(const unsigned char *key)
+{
+    /* FNV-1a */
+    unsigned long hash = 2166136261UL;
+    for (; *key != '\0'; key++)
+    {
+        hash ^= (unsigned long)*key;
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+    }
+
+    return hash;
+}
+
+/* store key once, returns its offset + 1 or 0 on failure */
+static unsigned int add_key(document_builder * const builder, const char * const key)
+{
+    size_t position = 0;
+    unsigned int offset = 0;
+
+    if (builder->keys_count >= (builder->keys_mask / 2))
+    {
+        /* rehash into a table twice as large */
+        size_t new_mask = (builder->keys_mask == 0) ? 63 : ((builder->keys_mask * 2) + 1);
+        unsigned int *new_keys = (unsigned int*)cJSON_malloc((new_mask + 1) * sizeof(unsigned int));
+        size_t i = 0;
+        if (new_keys == NULL)
+        {
+            return 0;
+        }
+        memset(new_keys, '\0', (new_mask + 1) * sizeof(unsigned int));
+        for (i = 0; (builder->keys != NULL) && (i <= builder->keys_mask); i++)
+        {
+            if (builder->keys[i] != 0)
+            {
+                position = hash_key((const unsigned char*)builder->document->strings + builder->keys[i] - 1) & new_mask;
+                while (new_keys[position] != 0)
+                {
+                    position = (position + 1) & new_mask;
+                }
+                new_keys[position] = builder->keys[i];
+            }
+        }
+        if (builder->keys != NULL)
+        {
+            cJSON_free(builder->keys);
+        }
+        builder->keys = new_keys;
+        builder->keys_mask = new_mask;
+    }
+
+    for (position = hash_key((const unsigned char*)key) & builder->keys_mask; builder->keys[position] != 0; position = (position + 1) & builder->keys_mask)
+    {
+        if (strcmp(builder->document->strings + builder->keys[position] - 1, key) == 0)
+        {
+            return builder->keys[position];
+        }
+    }
+
+    offset = add_string(builder, key, strlen(key));
+    if (offset != 0)
+    {
+        builder->keys[position] = offset;
+        builder->keys_count++;
+    }
+
+    return offset;
+}
+
+/* store a scalar value */
+static cJSON_bool set_value(document_builder * const builder, const size_t index, const cJSON * const item)
+{
+    document_entry *entry = &builder->document->tape[index];
+
+    switch (item->type & 0xFF)
+    {
+        case cJSON_Number:
+            entry->value.integer = cJSON_GetInt64Value(item);
+            /* valuedouble may have been written directly */
+            if ((item->type & cJSON_IsInt64) && ((double)entry->value.integer == item->valuedouble))
+            {
+                entry->type |= cJSON_IsInt64;
+            }
+            else
+            {
+                entry->value.number = item->valuedouble;
+            }
+            return true;
+
+        case cJSON_String:
+        case cJSON_Raw:
+        {
+            size_t length = (item->valuestring == NULL) ? 0 : strlen(item->valuestring);
+            unsigned int offset = add_string(builder, (item->valuestring == NULL) ? "" : item->valuestring, length);
+            if (offset == 0)
+            {
+                return false;
+            }
+            entry->value.string.offset = offset - 1;
+            entry->value.string.length = (unsigned int)length;
+            return true;
+        }
+
+        default:
+            return true;
+    }
+}
+
+static void builder_free(document_builder * const builder)
+{
+    if (builder->keys != NULL)
+    {
+        cJSON_free(builder->keys);
+    }
+    if (builder->stack != NULL)
+    {
+        cJSON_free(builder->stack);
+    }
+}
+
+/* map a snapshot file read-only, or read it where mmap isn't available */
+static void *map_file(const char * const path, size_t * const size)
+{
+#ifdef CJSON_DOCUMENT_POSIX
+    struct stat status;
+    void *mapping = NULL;
+    int file = open(path, O_RDONLY);
+
+    if (file < 0)
+    {
+        return NULL;
+    }
+    if ((fstat(file, &status) == 0) && (status.st_size > 0) && ((off_t)(size_t)status.st_size == status.st_size))
+    {
+        mapping = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping == MAP_FAILED)
+        {
+            mapping = NULL;
+        }
+        *size = (size_t)status.st_size;
+    }
+    close(file);
+
+    return mapping;
+#else
+    FILE *file = NULL;
+    char *content = NULL;
+    size_t length = 0;
+    size_t content_size = 64 * 1024;
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    /* read the whole file, growing the buffer as needed */
+    content = (char*)cJSON_malloc(content_size);
+    while (content != NULL)
+    {
+        char *new_content = NULL;
+
+        length += fread(content + length, 1, content_size - length, file);
+        if (length < content_size)
+        {
+            break;
+        }
+        new_content = (char*)cJSON_malloc(content_size * 2);
+        if (new_content != NULL)
+        {
+            memcpy(new_content, content, length);
+        }
+        cJSON_free(content);
+        content = new_content;
+        content_size *= 2;
+    }
+    if ((content != NULL) && ferror(file))
+    {
+        cJSON_free(content);
+        content = NULL;
+    }
+    fclose(file);
+    *size = length;
+
+    return content;
+#endif
+}
+
+static void unmap_file(void * const mapping, const size_t size)
+{
+#ifdef CJSON_DOCUMENT_POSIX
+    munmap(mapping, size);
+#else
+    (void)size;
+    cJSON_free(mapping);
+#endif
+}
+
+static cJSON_Document *document_new(void)
+{
+    cJSON_Document *document = (cJSON_Document*)cJSON_malloc(sizeof(cJSON_Document));
+    if (document != NULL)
+    {
+        memset(document, '\0', sizeof(cJSON_Document));
+    }
+
+    return document;
+}
+
+CJSON_PUBLIC(void) cJSON_DocumentDelete(cJSON_Document *document)
+{
+    if (document == NULL)
+    {
+        return;
+    }
+
+    if (document->mapping != NULL)
+    {
+        /* everything of a snapshot is in its file */
+        unmap_file(document->mapping, document->mapping_size);
+    }
+    else
+    {
+        if (document->tape != NULL)
+        {
+            cJSON_free(document->tape);
+        }
+        if (document->strings != NULL)
+        {
+            cJSON_free(document->strings);
+        }
+    }
+    cJSON_free(document);
+}
+
+static cJSON_bool add_tree(document_builder * const builder, const cJSON * const item, const unsigned int key)
+{
+    size_t index = add_entry(builder, item->type & 0xFF);
+    const cJSON *child = NULL;
+    cJSON number;
+    unsigned int count = 0;
+
+    if (index == CJSON_DOCUMENT_NONE)
+    {
+        return false;
+    }
+    builder->document->tape[index].key = key;
+
+    if (!cJSON_IsArray(item) && !cJSON_IsObject(item))
+    {
+        return set_value(builder, index, item);
+    }
+
+    /* packed arrays are read as they are, they have no children */
+    while (cJSON_GetPackedNumber(item, (int)count, &number))
+    {
+        if (!add_tree(builder, &number, 0))
+        {
+            return false;
+        }
+        count++;
+    }
+    for (child = item->child; child != NULL; child = child->next)
+    {
+        unsigned int child_key = 0;
+        if (cJSON_IsObject(item))
+        {
+            child_key = add_key(builder, (child->string == NULL) ? "" : child->string);
+            if (child_key == 0)
+            {
+                return false;
+            }
+        }
+        if (!add_tree(builder, child, child_key))
+        {
+            return false;
+        }
+        count++;
+    }
+
+    builder->document->tape[index].value.container.end = (unsigned int)builder->document->count;
+    builder->document->tape[index].value.container.count = count;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_Document *) cJSON_DocumentFromTree(const cJSON *item)
+{
+    document_builder builder;
+
+    if (item == NULL)
+    {
+        return NULL;
+    }
+
+    memset(&builder, '\0', sizeof(builder));
+    builder.document = document_new();
+    if (builder.document == NULL)
+    {
+        return NULL;
+    }
+
+    if (!add_tree(&builder, item, 0))
+    {
+        cJSON_DocumentDelete(builder.document);
+        builder.document = NULL;
+    }
+    builder_free(&builder);
+
+    return builder.document;
+}
+
+/* event parsing straight into the tape */
+static cJSON_bool event_add(document_builder * const builder, const int type, size_t * const index)
+{
+    *index = add_entry(builder, type);
+    if (*index == CJSON_DOCUMENT_NONE)
+    {
+        return false;
+    }
+
+    builder->document->tape[*index].key = builder->key;
+    builder->key = 0;
+    if (builder->depth > 0)
+    {
+        builder->document->tape[builder->stack[builder->depth - 1]].value.container.count++;
+    }
+
+    return true;
+}
+
+static cJSON_bool event_start(document_builder * const builder, const int type)
+{
+    size_t index = 0;
+
+    if (!event_add(builder, type, &index))
+    {
+        return false;
+    }
+    if (builder->depth == builder->stack_size)
+    {
+        size_t *stack = (size_t*)grow(builder->stack, builder->depth, &builder->stack_size, builder->depth + 1, sizeof(size_t));
+        if (stack == NULL)
+        {
+            return false;
+        }
+        builder->stack = stack;
+    }
+    builder->stack[builder->depth++] = index;
+
+    return true;
+}
+
+static cJSON_bool event_end(void *context)
+{
+    document_builder *builder = (document_builder*)context;
+
+    builder->depth--;
+    builder->document->tape[builder->stack[builder->depth]].value.container.end = (unsigned int)builder->document->count;
+
+    return true;
+}
+
+static cJSON_bool event_start_object(void *context)
+{
+    return event_start((document_builder*)context, cJSON_Object);
+}
+
+static cJSON_bool event_start_array(void *context)
+{
+    return event_start((document_builder*)context, cJSON_Array);
+}
+
+static cJSON_bool event_key(void *context, const char *key)
+{
+    document_builder *builder = (document_builder*)context;
+
+    builder->key = add_key(builder, key);
+
+    return builder->key != 0;
+}
+
+static cJSON_bool event_value(void *context, const cJSON *value)
+{
+    document_builder *builder = (document_builder*)context;
+    size_t index = 0;
+
+    return event_add(builder, value->type & 0xFF, &index) && set_value(builder, index, value);
+}
+
+CJSON_PUBLIC(cJSON_Document *) cJSON_DocumentParse(const char *value, size_t buffer_length)
+{
+    static const cJSON_EventHandler handler = { event_start_object, event_end, event_start_array, event_end, event_key, event_value };
+    document_builder builder;
+
+    memset(&builder, '\0', sizeof(builder));
+    builder.document = document_new();
+    if (builder.document == NULL)
+    {
+        return NULL;
+    }
+
+    if (!cJSON_ParseEvents(value, buffer_length, &handler, &builder))
+    {
+        cJSON_DocumentDelete(builder.document);
+        builder.document = NULL;
+    }
+    builder_free(&builder);
+
+    return builder.document;
+}
+
+static const document_entry *get_entry(const cJSON_Document * const document, const size_t value)
+{
+    if ((document == NULL) || (value >= document->count))
+    {
+        return NULL;
+    }
+
+    return &document->tape[value];
+}
+
+#define is_container(entry) ((((entry)->type & 0xFF) == cJSON_Array) || (((entry)->type & 0xFF) == cJSON_Object))
+
+static cJSON *entry_to_tree(const cJSON_Document * const document, const size_t index)
+{
+    const document_entry *entry = &document->tape[index];
+    cJSON *item = NULL;
+    size_t child = 0;
+
+    switch (entry->type & 0xFF)
+    {
+        case cJSON_False:
+            return cJSON_CreateFalse();
+        case cJSON_True:
+            return cJSON_CreateTrue();
+        case cJSON_NULL:
+            return cJSON_CreateNull();
+        case cJSON_Number:
+            return (entry->type & cJSON_IsInt64) ? cJSON_CreateInt64(entry->value.integer) : cJSON_CreateNumber(entry->value.number);
+        case cJSON_String:
+            return cJSON_CreateString(document->strings + entry->value.string.offset);
+        case cJSON_Raw:
+            return cJSON_CreateRaw(document->strings + entry->value.string.offset);
+        case cJSON_Array:
+            item = cJSON_CreateArray();
+            break;
+        case cJSON_Object:
+            item = cJSON_CreateObject();
+            break;
+        default:
+            item = cJSON_CreateNull();
+            if (item != NULL)
+            {
+                item->type = cJSON_Invalid;
+            }
+            return item;
+    }
+    if (item == NULL)
+    {
+        return NULL;
+    }
+
+    for (child = index + 1; child < entry->value.container.end; child = is_container(&document->tape[child]) ? document->tape[child].value.container.end : (child + 1))
+    {
+        cJSON *child_item = entry_to_tree(document, child);
+        cJSON_bool added = false;
+        if (child_item != NULL)
+        {
+            added = ((entry->type & 0xFF) == cJSON_Object)
+                ? cJSON_AddItemToObject(item, document->strings + document->tape[child].key - 1, child_item)
+                : cJSON_AddItemToArray(item, child_item);
+        }
+        if (!added)
+        {
+            cJSON_Delete(child_item);
+            cJSON_Delete(item);
+            return NULL;
+        }
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_DocumentToTree(const cJSON_Document *document, size_t value)
+{
+    if (get_entry(document, value) == NULL)
+    {
+        return NULL;
+    }
+
+    return entry_to_tree(document, value);
+}
+
+CJSON_PUBLIC(int) cJSON_DocumentGetType(const cJSON_Document *document, size_t value)
+{
+    const document_entry *entry = get_entry(document, value);
+    if (entry == NULL)
+    {
+        return cJSON_Invalid;
+    }
+
+    return (int)entry->type;
+}
+
+CJSON_PUBLIC(const char *) cJSON_DocumentGetKey(const cJSON_Document *document, size_t value)
+{
+    const document_entry *entry = get_entry(document, value);
+    if ((entry == NULL) || (entry->key == 0))
+    {
+        return NULL;
+    }
+
+    return document->strings + entry->key - 1;
+}
+
+CJSON_PUBLIC(const char *) cJSON_DocumentGetStringValue(const cJSON_Document *document, size_t value)
+{
+    const document_entry *entry = get_entry(document, value);
+    if ((entry == NULL) || (((entry->type & 0xFF) != cJSON_String) && ((entry->type & 0xFF) != cJSON_Raw)))
+    {
+        return NULL;
+    }
+
+    return document->strings + entry->value.string.offset;
+}
+
+CJSON_PUBLIC(size_t) cJSON_DocumentGetStringLength(const cJSON_Document *document, size_t value)
+{
+    const document_entry *entry = get_entry(document, value);
+    if ((entry == NULL) || (((entry->type & 0xFF) != cJSON_String) && ((entry->type & 0xFF) != cJSON_Raw)))
+    {
+        return 0;
+    }
+
+    return entry->value.string.length;
+}
+
+CJSON_PUBLIC(double) cJSON_DocumentGetNumberValue(const cJSON_Document *document, size_t value)
+{
+    const document_entry *entry = get_entry(document, value);
+    if ((entry == NULL) || ((entry->type & 0xFF) != cJSON_Number))
+    {
+        return (double) NAN;
+    }
+
+    return (entry->type & cJSON_IsInt64) ? (double)entry->value.integer : entry->value.number;
+}
+
+CJSON_PUBLIC(cJSON_int64) cJSON_DocumentGetInt64Value(const cJSON_Document *document, size_t value)
+{
+    const document_entry *entry = get_entry(document, value);
+    if ((entry == NULL) || !(entry->type & cJSON_IsInt64))
+    {
+        return 0;
+    }
+
+    return entry->value.integer;
+}
+
+CJSON_PUBLIC(int) cJSON_DocumentGetArraySize(const cJSON_Document *document, size_t value)
+{
+    const document_entry *entry = get_entry(document, value);
+    if ((entry == NULL) || !is_container(entry))
+    {
+        return 0;
+    }
+
+    return (int)entry->value.container.count;
+}
+
+CJSON_PUBLIC(size_t) cJSON_DocumentGetChild(const cJSON_Document *document, size_t value)
+{
+    const document_entry *entry = get_entry(document, value);
+    if ((entry == NULL) || !is_container(entry) || (entry->value.container.count == 0))
+    {
+        return CJSON_DOCUMENT_NONE;
+    }
+
+    return value + 1;
+}
+
+CJSON_PUBLIC(size_t) cJSON_DocumentGetNext(const cJSON_Document *document, size_t parent, size_t child)
+{
+    const document_entry *parent_entry = get_entry(document, parent);
+    const document_entry *entry = get_entry(document, child);
+    size_t next = 0;
+
+    if ((parent_entry == NULL) || (entry == NULL) || !is_container(parent_entry))
+    {
+        return CJSON_DOCUMENT_NONE;
+    }
+
+    /* skip the subtree of child */
+    next = is_container(entry) ? entry->value.container.end : (child + 1);
+    if (next >= parent_entry->value.container.end)
+    {
+        return CJSON_DOCUMENT_NONE;
+    }
+
+    return next;
+}
+
+CJSON_PUBLIC(size_t) cJSON_DocumentGetArrayItem(const cJSON_Document *document, size_t array, int index)
+{
+    size_t child = 0;
+
+    if ((index < 0) || (cJSON_DocumentGetType(document, array) != cJSON_Array))
+    {
+        return CJSON_DOCUMENT_NONE;
+    }
+
+    cJSON_DocumentArrayForEach(child, document, array)
+    {
+        if (index-- == 0)
+        {
+            return child;
+        }
+    }
+
+    return CJSON_DOCUMENT_NONE;
+}
+
+static int case_insensitive_strcmp(const unsigned char *string1, const unsigned char *string2)
+{
+    for(; tolower(*string1) == tolower(*string2); (void)string1++, string2++)
+    {
+        if (*string1 == '\0')
+        {
+            return 0;
+        }
+    }
+
+    return tolower(*string1) - tolower(*string2);
+}
+
+/* hash of the snapshot tables, FNV-1a of the key with ASCII letters in lower case so it works for both kinds of lookup */
+static unsigned long index_hash(const unsigned char *key)
+{
+    unsigned long hash = 2166136261UL;
+    for (; *key != '\0'; key++)
+    {
+        hash ^= (unsigned long)(((*key >= 'A') && (*key <= 'Z')) ? (*key + ('a' - 'A')) : *key);
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+    }
+
+    return hash;
+}
+
+static const snapshot_index *find_index(const cJSON_Document * const document, const size_t object)
+{
+    size_t low = 0;
+    size_t high = document->indexes_count;
+
+    while (low < high)
+    {
+        size_t middle = low + ((high - low) / 2);
+        if (document->indexes[middle].object == object)
+        {
+            return &document->indexes[middle];
+        }
+        if (document->indexes[middle].object < object)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return NULL;
+}
+
+static cJSON_bool key_matches(const char * const name, const char * const key, const cJSON_bool case_sensitive)
+{
+    return case_sensitive ? (strcmp(name, key) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)key) == 0);
+}
+
+static size_t get_object_item(const cJSON_Document * const document, const size_t object, const char * const name, const cJSON_bool case_sensitive)
+{
+    const snapshot_index *index = NULL;
+    size_t child = 0;
+
+    if ((name == NULL) || (cJSON_DocumentGetType(document, object) != cJSON_Object))
+    {
+        return CJSON_DOCUMENT_NONE;
+    }
+
+    index = find_index(document, object);
+    if (index != NULL)
+    {
+        /* members with the same key were added in document order, so the first match is the first member */
+        const unsigned int *slots = document->slots + index->slots;
+        size_t position = 0;
+        for (position = index_hash((const unsigned char*)name) & index->mask; slots[position] != 0; position = (position + 1) & index->mask)
+        {
+            if (key_matches(name, document->strings + document->tape[slots[position]].key - 1, case_sensitive))
+            {
+                return slots[position];
+            }
+        }
+
+        return CJSON_DOCUMENT_NONE;
+    }
+
+    cJSON_DocumentArrayForEach(child, document, object)
+    {
+        if (key_matches(name, document->strings + document->tape[child].key - 1, case_sensitive))
+        {
+            return child;
+        }
+    }
+
+    return CJSON_DOCUMENT_NONE;
+}
+
+CJSON_PUBLIC(size_t) cJSON_DocumentGetObjectItem(const cJSON_Document *document, size_t object, const char *string)
+{
+    return get_object_item(document, object, string, false);
+}
+
+CJSON_PUBLIC(size_t) cJSON_DocumentGetObjectItemCaseSensitive(const cJSON_Document *document, size_t object, const char *string)
+{
+    return get_object_item(document, object, string, true);
+}
+
+/* Snapshot files: a header, then the tape, the strings, the hash tables and their slots, each padded to 8 bytes.
+ * Everything is stored as it is in memory, so a snapshot is only read on machines with the same layout. */
+#define CJSON_SNAPSHOT_VERSION 1
+#define CJSON_SNAPSHOT_BYTE_ORDER 0x01020304U
+#ifndef CJSON_SNAPSHOT_INDEX_THRESHOLD
+#define CJSON_SNAPSHOT_INDEX_THRESHOLD 16 /* objects with this many members get a hash table, 0 disables them */
+#endif
+
+typedef struct
+{
+    char magic[8]; /* "cJSONsnp" */
+    unsigned int version;
+    unsigned int byte_order; /* CJSON_SNAPSHOT_BYTE_ORDER as written */
+    unsigned int entry_size;
+    unsigned int count;
+    unsigned int strings_length;
+    unsigned int indexes_count;
+    unsigned int slots_count;
+    unsigned int reserved;
+    unsigned int checksum[2]; /* Fletcher-64 of the 32 bit words after the header */
+} snapshot_header;
+
+typedef struct
+{
+    unsigned long sum1;
+    unsigned long sum2;
+} snapshot_checksum;
+
+/* length must be a multiple of 4 */
+static void checksum_add(snapshot_checksum * const checksum, const unsigned char *data, size_t length)
+{
+    unsigned long sum1 = checksum->sum1;
+    unsigned long sum2 = checksum->sum2;
+    unsigned int word = 0;
+
+    for (; length >= 4; data += 4, length -= 4)
+    {
+        memcpy(&word, data, sizeof(word));
+        sum1 = (sum1 + word) & 0xFFFFFFFFUL;
+        sum2 = (sum2 + sum1) & 0xFFFFFFFFUL;
+    }
+
+    checksum->sum1 = sum1;
+    checksum->sum2 = sum2;
+}
+
+#define padded_size(size) (((size) + 7) & ~(size_t)7)
+
+/* writes the file and its checksum, the bytes of an incomplete word wait for the next call */
+typedef struct
+{
+    FILE *file;
+    snapshot_checksum checksum;
+    unsigned char pending[4];
+    size_t pending_length;
+    size_t written;
+    cJSON_bool failed;
+} snapshot_writer;
+
+static void write_data(snapshot_writer * const writer, const void * const data, size_t length)
+{
+    const unsigned char *bytes = (const unsigned char*)data;
+
+    if (writer->failed || (length == 0))
+    {
+        return;
+    }
+    if (fwrite(data, 1, length, writer->file) != length)
+    {
+        writer->failed = true;
+        return;
+    }
+    writer->written += length;
+
+    if (writer->pending_length > 0)
+    {
+        /* complete the pending word first */
+        size_t fill = sizeof(writer->pending) - writer->pending_length;
+        if (fill > length)
+        {
+            fill = length;
+        }
+        memcpy(writer->pending + writer->pending_length, bytes, fill);
+        writer->pending_length += fill;
+        bytes += fill;
+        length -= fill;
+        if (writer->pending_length == sizeof(writer->pending))
+        {
+            checksum_add(&writer->checksum, writer->pending, 4);
+            writer->pending_length = 0;
+        }
+    }
+    checksum_add(&writer->checksum, bytes, length & ~(size_t)3);
+    bytes += length & ~(size_t)3;
+    length &= 3;
+    memcpy(writer->pending, bytes, length);
+    writer->pending_length += length;
+}
+
+static void write_section(snapshot_writer * const writer, const void * const data, const size_t length)
+{
+    static const unsigned char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    write_data(writer, data, length);
+    write_data(writer, padding, padded_size(writer->written) - writer->written);
+}
+
+/* number of slots for an object, at most half of them are used */
+static size_t table_size(const size_t count)
+{
+    size_t size = 2;
+    while ((size / 2) < count)
+    {
+        size *= 2;
+    }
+
+    return size;
+}
+
+/* hash tables for the objects with at least CJSON_SNAPSHOT_INDEX_THRESHOLD members */
+static cJSON_bool build_indexes(const cJSON_Document * const document, snapshot_index ** const indexes, size_t * const indexes_count, unsigned int ** const slots, size_t * const slots_count)
+{
+    size_t index = 0;
+    size_t table = 0;
+    size_t offset = 0;
+
+    for (index = 0; (CJSON_SNAPSHOT_INDEX_THRESHOLD > 0) && (index < document->count); index++)
+    {
+        const document_entry *entry = &document->tape[index];
+        if (((entry->type & 0xFF) == cJSON_Object) && (entry->value.container.count >= CJSON_SNAPSHOT_INDEX_THRESHOLD)
+            && (table_size(entry->value.container.count) < (UINT_MAX - *slots_count)))
+        {
+            (*indexes_count)++;
+            *slots_count += table_size(entry->value.container.count);
+        }
+    }
+    if (*indexes_count == 0)
+    {
+        return true;
+    }
+
+    *indexes = (snapshot_index*)cJSON_malloc(*indexes_count * sizeof(snapshot_index));
+    *slots = (unsigned int*)cJSON_malloc(*slots_count * sizeof(unsigned int));
+    if ((*indexes == NULL) || (*slots == NULL))
+    {
+        return false;
+    }
+    memset(*slots, '\0', *slots_count * sizeof(unsigned int));
+
+    for (index = 0; table < *indexes_count; index++)
+    {
+        const document_entry *entry = &document->tape[index];
+        size_t child = 0;
+        if (((entry->type & 0xFF) != cJSON_Object) || (entry->value.container.count < CJSON_SNAPSHOT_INDEX_THRESHOLD)
+            || (table_size(entry->value.container.count) >= (UINT_MAX - offset)))
+        {
+            continue;
+        }
+
+        (*indexes)[table].object = (unsigned int)index;
+        (*indexes)[table].slots = (unsigned int)offset;
+        (*indexes)[table].mask = (unsigned int)(table_size(entry->value.container.count) - 1);
+        cJSON_DocumentArrayForEach(child, document, index)
+        {
+            size_t position = index_hash((const unsigned char*)document->strings + document->tape[child].key - 1) & (*indexes)[table].mask;
+            while ((*slots)[offset + position] != 0)
+            {
+                position = (position + 1) & (*indexes)[table].mask;
+            }
+            (*slots)[offset + position] = (unsigned int)child;
+        }
+        offset += (*indexes)[table].mask + 1;
+        table++;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_DocumentSaveSnapshot(const cJSON_Document *document, const char *path)
+{
+    snapshot_header header;
+    snapshot_writer writer;
+    snapshot_index *indexes = NULL;
+    size_t indexes_count = 0;
+    unsigned int *slots = NULL;
+    size_t slots_count = 0;
+    char *temporary_path = NULL;
+    cJSON_bool success = false;
+
+    if ((document == NULL) || (path == NULL))
+    {
+        return false;
+    }
+
+    memset(&writer, '\0', sizeof(writer));
+    if (!build_indexes(document, &indexes, &indexes_count, &slots, &slots_count))
+    {
+        goto end;
+    }
+
+    /* written next to the file and renamed, so documents mapped from the old file stay intact */
+    temporary_path = (char*)cJSON_malloc(strlen(path) + sizeof(".tmp"));
+    if (temporary_path == NULL)
+    {
+        goto end;
+    }
+    sprintf(temporary_path, "%s.tmp", path);
+    writer.file = fopen(temporary_path, "wb");
+    if (writer.file == NULL)
+    {
+        goto end;
+    }
+
+    memset(&header, '\0', sizeof(header));
+    memcpy(header.magic, "cJSONsnp", sizeof(header.magic));
+    header.version = CJSON_SNAPSHOT_VERSION;
+    header.byte_order = CJSON_SNAPSHOT_BYTE_ORDER;
+    header.entry_size = (unsigned int)sizeof(document_entry);
+    header.count = (unsigned int)document->count;
+    header.strings_length = (unsigned int)document->strings_length;
+    header.indexes_count = (unsigned int)indexes_count;
+    header.slots_count = (unsigned int)slots_count;
+    /* the header is written again once the checksum is known */
+    if (fwrite(&header, sizeof(header), 1, writer.file) != 1)
+    {
+        writer.failed = true;
+    }
+    write_section(&writer, document->tape, document->count * sizeof(document_entry));
+    write_section(&writer, document->strings, document->strings_length);
+    write_section(&writer, indexes, indexes_count * sizeof(snapshot_index));
+    write_section(&writer, slots, slots_count * sizeof(unsigned int));
+
+    header.checksum[0] = (unsigned int)writer.checksum.sum1;
+    header.checksum[1] = (unsigned int)writer.checksum.sum2;
+    success = !writer.failed && (fseek(writer.file, 0, SEEK_SET) == 0) && (fwrite(&header, sizeof(header), 1, writer.file) == 1);
+    if (fclose(writer.file) != 0)
+    {
+        success = false;
+    }
+
+    if (success)
+    {
+#ifndef CJSON_DOCUMENT_POSIX
+        /* rename doesn't replace files everywhere */
+        remove(path);
+#endif
+        success = (rename(temporary_path, path) == 0);
+    }
+    if (!success)
+    {
+        remove(temporary_path);
+    }
+
+end:
+    if (temporary_path != NULL)
+    {
+        cJSON_free(temporary_path);
+    }
+    if (indexes != NULL)
+    {
+        cJSON_free(indexes);
+    }
+    if (slots != NULL)
+    {
+        cJSON_free(slots);
+    }
+
+    return success;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_SaveSnapshot(const cJSON *item, const char *path)
+{
+    cJSON_Document *document = cJSON_DocumentFromTree(item);
+    cJSON_bool success = cJSON_DocumentSaveSnapshot(document, path);
+
+    cJSON_DocumentDelete(document);
+
+    return success;
+}
+
+/* an open array or object while a snapshot is checked */
+typedef struct
+{
+    size_t end;
+    size_t count; /* members not seen yet */
+    cJSON_bool object;
+} snapshot_frame;
+
+/* check that the tape of a snapshot can be read without leaving it: every value is valid, the containers nest
+ * properly with the number of members they claim, and members of objects have keys */
+static cJSON_bool check_tape(const cJSON_Document * const document)
+{
+    snapshot_frame *frames = NULL;
+    size_t depth = 0;
+    size_t frames_size = 0;
+    size_t index = 0;
+    cJSON_bool success = false;
+
+    if ((document->strings_length > 0) && (document->strings[document->strings_length - 1] != '\0'))
+    {
+        return false;
+    }
+
+    for (index = 0; index < document->count; index++)
+    {
+        const document_entry *entry = &document->tape[index];
+
+        /* close the containers that end here */
+        while ((depth > 0) && (frames[depth - 1].end == index))
+        {
+            if (frames[--depth].count != 0)
+            {
+                goto end;
+            }
+        }
+        if ((depth == 0) && (index > 0))
+        {
+            /* more than one root */
+            goto end;
+        }
+        if (depth > 0)
+        {
+            if ((frames[depth - 1].count == 0) || (frames[depth - 1].object != (entry->key != 0)))
+            {
+                goto end;
+            }
+            frames[depth - 1].count--;
+        }
+        if ((entry->key != 0) && (entry->key > document->strings_length))
+        {
+            goto end;
+        }
+
+        switch (entry->type)
+        {
+            case cJSON_False:
+            case cJSON_True:
+            case cJSON_NULL:
+            case cJSON_Number:
+            case cJSON_Number | cJSON_IsInt64:
+                break;
+
+            case cJSON_String:
+            case cJSON_Raw:
+                if ((entry->value.string.offset >= document->strings_length)
+                    || (entry->value.string.length >= (document->strings_length - entry->value.string.offset))
+                    || (document->strings[entry->value.string.offset + entry->value.string.length] != '\0'))
+                {
+                    goto end;
+                }
+                break;
+
+            case cJSON_Array:
+            case cJSON_Object:
+                if ((entry->value.container.end <= index) || (entry->value.container.end > ((depth > 0) ? frames[depth - 1].end : document->count))
+                    || (entry->value.container.count > (entry->value.container.end - index - 1)))
+                {
+                    goto end;
+                }
+                if (depth == frames_size)
+                {
+                    snapshot_frame *new_frames = NULL;
+                    if (depth >= CJSON_NESTING_LIMIT)
+                    {
+                        goto end;
+                    }
+                    new_frames = (snapshot_frame*)grow(frames, depth, &frames_size, depth + 1, sizeof(snapshot_frame));
+                    if (new_frames == NULL)
+                    {
+                        goto end;
+                    }
+                    frames = new_frames;
+                }
+                frames[depth].end = entry->value.container.end;
+                frames[depth].count = entry->value.container.count;
+                frames[depth].object = (entry->type == cJSON_Object);
+                depth++;
+                break;
+
+            default:
+                goto end;
+        }
+    }
+
+    while (depth > 0)
+    {
+        if (frames[--depth].count != 0)
+        {
+            goto end;
+        }
+    }
+    success = (document->count > 0);
+
+end:
+    if (frames != NULL)
+    {
+        cJSON_free(frames);
+    }
+
+    return success;
+}
+
+/* the hash tables have to point at members of their objects and have empty slots to end the lookups */
+static cJSON_bool check_indexes(const cJSON_Document * const document, const size_t slots_count)
+{
+    size_t table = 0;
+
+    for (table = 0; table < document->indexes_count; table++)
+    {
+        const snapshot_index *index = &document->indexes[table];
+        const document_entry *object = NULL;
+        size_t position = 0;
+        size_t used = 0;
+
+        if ((index->object >= document->count) || ((table > 0) && (index->object <= document->indexes[table - 1].object))
+            || (index->slots > slots_count) || (index->mask >= (slots_count - index->slots)) || ((index->mask & (index->mask + 1)) != 0))
+        {
+            return false;
+        }
+        object = &document->tape[index->object];
+        if ((object->type != cJSON_Object) || (object->value.container.count > index->mask))
+        {
+            return false;
+        }
+        for (position = 0; position <= index->mask; position++)
+        {
+            unsigned int member = document->slots[index->slots + position];
+            if (member == 0)
+            {
+                continue;
+            }
+            if ((member <= index->object) || (member >= object->value.container.end) || (document->tape[member].key == 0) || (++used > object->value.container.count))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_Document *) cJSON_MapSnapshot(const char *path)
+{
+    cJSON_Document *document = NULL;
+    snapshot_header header;
+    snapshot_checksum checksum = { 0, 0 };
+    unsigned char *mapping = NULL;
+    size_t size = 0;
+    size_t remaining = 0;
+    size_t section = 0;
+
+    if (path == NULL)
+    {
+        return NULL;
+    }
+
+    mapping = (unsigned char*)map_file(path, &size);
+    if (mapping == NULL)
+    {
+        return NULL;
+    }
+    document = document_new();
+    if ((document == NULL) || (size < sizeof(header)))
+    {
+        goto fail;
+    }
+    document->mapping = mapping;
+    document->mapping_size = size;
+
+    memcpy(&header, mapping, sizeof(header));
+    if ((memcmp(header.magic, "cJSONsnp", sizeof(header.magic)) != 0) || (header.version != CJSON_SNAPSHOT_VERSION)
+        || (header.byte_order != CJSON_SNAPSHOT_BYTE_ORDER) || (header.entry_size != sizeof(document_entry)) || (header.reserved != 0))
+    {
+        goto fail;
+    }
+
+    /* the sections have to fill the file exactly */
+    remaining = size - sizeof(header);
+    if ((header.count > (remaining / sizeof(document_entry))) || (header.strings_length > remaining)
+        || (header.indexes_count > (remaining / sizeof(snapshot_index))) || (header.slots_count > (remaining / sizeof(unsigned int))))
+    {
+        goto fail;
+    }
+    checksum_add(&checksum, mapping + sizeof(header), remaining);
+    if (((remaining % 8) != 0) || (header.checksum[0] != (unsigned int)checksum.sum1) || (header.checksum[1] != (unsigned int)checksum.sum2))
+    {
+        goto fail;
+    }
+
+    document->tape = (document_entry*)(void*)(mapping + sizeof(header));
+    document->count = document->size = header.count;
+    section = header.count * sizeof(document_entry);
+    remaining -= section;
+
+    document->strings = (char*)(mapping + size - remaining);
+    document->strings_length = header.strings_length;
+    section = padded_size((size_t)header.strings_length);
+    if (section > remaining)
+    {
+        goto fail;
+    }
+    remaining -= section;
+
+    document->indexes = (const snapshot_index*)(void*)(mapping + size - remaining);
+    document->indexes_count = header.indexes_count;
+    section = padded_size(header.indexes_count * sizeof(snapshot_index));
+    if (section > remaining)
+    {
+        goto fail;
+    }
+    remaining -= section;
+
+    document->slots = (const unsigned int*)(void*)(mapping + size - remaining);
+    if (padded_size(header.slots_count * sizeof(unsigned int)) != remaining)
+    {
+        goto fail;
+    }
+
+    if (!check_tape(document) || !check_indexes(document, header.slots_count))
+    {
+        goto fail;
+    }
+
+    return document;
+
+fail:
+    if (document != NULL)
+    {
+        cJSON_free(document);
+    }
+    unmap_file(mapping, size);
+
+    return NULL;
+}
@@ -0,0 +1,86 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#ifndef cJSON_Document__h
+#define cJSON_Document__h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "cJSON.h"
+
+/* Read-only documents stored as a tape: every value is a 16 byte entry in document order, containers know where
+ * their subtree ends, and keys and strings live in a string pool (each distinct key once). Reading is cache
+ * friendly and the whole document is two allocations; use cJSON trees to modify data.
+ * Values are addressed by their index in the tape, the root is 0 and CJSON_DOCUMENT_NONE means no value. */
+typedef struct cJSON_Document cJSON_Document;
+#define CJSON_DOCUMENT_NONE ((size_t)-1)
+
+/* Parse text directly into a document, no tree is built. */
+CJSON_PUBLIC(cJSON_Document *) cJSON_DocumentParse(const char *value, size_t buffer_length);
+/* Conversion to and from trees. cJSON_DocumentToTree builds the subtree of value, delete it with cJSON_Delete. */
+CJSON_PUBLIC(cJSON_Document *) cJSON_DocumentFromTree(const cJSON *item);
+CJSON_PUBLIC(cJSON *) cJSON_DocumentToTree(const cJSON_Document *document, size_t value);
+CJSON_PUBLIC(void) cJSON_DocumentDelete(cJSON_Document *document);
+
+/* cJSON_Object, cJSON_String ... (with cJSON_IsInt64 for exact integers), cJSON_Invalid for CJSON_DOCUMENT_NONE */
+CJSON_PUBLIC(int) cJSON_DocumentGetType(const cJSON_Document *document, size_t value);
+/* NULL if value has no key */
+CJSON_PUBLIC(const char *) cJSON_DocumentGetKey(const cJSON_Document *document, size_t value);
+/* strings and raw values, NULL for other types */
+CJSON_PUBLIC(const char *) cJSON_DocumentGetStringValue(const cJSON_Document *document, size_t value);
+CJSON_PUBLIC(size_t) cJSON_DocumentGetStringLength(const cJSON_Document *document, size_t value);
+/* NAN if value isn't a number */
+CJSON_PUBLIC(double) cJSON_DocumentGetNumberValue(const cJSON_Document *document, size_t value);
+/* exact value of integral numbers, 0 otherwise */
+CJSON_PUBLIC(cJSON_int64) cJSON_DocumentGetInt64Value(const cJSON_Document *document, size_t value);
+
+/* number of children of an array or object, in constant time */
+CJSON_PUBLIC(int) cJSON_DocumentGetArraySize(const cJSON_Document *document, size_t value);
+CJSON_PUBLIC(size_t) cJSON_DocumentGetArrayItem(const cJSON_Document *document, size_t array, int index);
+CJSON_PUBLIC(size_t) cJSON_DocumentGetObjectItem(const cJSON_Document *document, size_t object, const char *string);
+CJSON_PUBLIC(size_t) cJSON_DocumentGetObjectItemCaseSensitive(const cJSON_Document *document, size_t object, const char *string);
+/* iteration: the first child of a container and the sibling after child */
+CJSON_PUBLIC(size_t) cJSON_DocumentGetChild(const cJSON_Document *document, size_t value);
+CJSON_PUBLIC(size_t) cJSON_DocumentGetNext(const cJSON_Document *document, size_t parent, size_t child);
+
+/* Snapshots: documents saved to a file that cJSON_MapSnapshot maps read-only instead of parsing it, so loading
+ * only pages the file in. Objects with many members get hash tables for their lookups. The file has a version and
+ * a checksum that are checked when it is mapped, and it can only be read on machines with the same byte order and
+ * type sizes. It is written under path.tmp and renamed, so documents mapped from an older file stay valid.
+ * Read a snapshot with the functions above and release it with cJSON_DocumentDelete. Where mmap isn't available
+ * the file is read into memory. */
+CJSON_PUBLIC(cJSON_bool) cJSON_SaveSnapshot(const cJSON *item, const char *path);
+CJSON_PUBLIC(cJSON_bool) cJSON_DocumentSaveSnapshot(const cJSON_Document *document, const char *path);
+CJSON_PUBLIC(cJSON_Document *) cJSON_MapSnapshot(const char *path);
+
+/* Macro for iterating over an array or object of a document */
+#define cJSON_DocumentArrayForEach(element, document, parent) for(element = cJSON_DocumentGetChild(document, parent); element != CJSON_DOCUMENT_NONE; element = cJSON_DocumentGetNext(document, parent, element))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
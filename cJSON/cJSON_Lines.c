@@ -0,0 +1,541 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+/* disable warnings about old C89 functions in MSVC */
+#if !defined(_CRT_SECURE_NO_DEPRECATE) && defined(_MSC_VER)
+#define _CRT_SECURE_NO_DEPRECATE
+#endif
+
+/* threads and mmap are used where POSIX is available, elsewhere the lines are parsed on the calling thread */
+#if !defined(CJSON_LINES_NO_THREADS) && (defined(__unix__) || defined(__APPLE__))
+#define CJSON_LINES_POSIX
+#if !defined(_POSIX_C_SOURCE) || (_POSIX_C_SOURCE < 200112L)
+#undef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+#endif
+
+#ifdef __GNUCC__
+#pragma GCC visibility push(default)
+#endif
+#if defined(_MSC_VER)
+#pragma warning (push)
+/* disable warning about single line comments in system headers */
+#pragma warning (disable : 4001)
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifdef CJSON_LINES_POSIX
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined(_MSC_VER)
+#pragma warning (pop)
+#endif
+#ifdef __GNUCC__
+#pragma GCC visibility pop
+#endif
+
+#include "cJSON_Lines.h"
+
+/* define our own boolean type */
+#ifdef true
+#undef true
+#endif
+#define true ((cJSON_bool)1)
+
+#ifdef false
+#undef false
+#endif
+#define false ((cJSON_bool)0)
+
+/* The input is handed out to the threads in blocks of whole lines, roughly this large. */
+#ifndef CJSON_LINES_BLOCK_SIZE
+#define CJSON_LINES_BLOCK_SIZE (256 * 1024)
+#endif
+
+#ifndef CJSON_LINES_MAX_THREADS
+#define CJSON_LINES_MAX_THREADS 256
+#endif
+
+typedef struct
+{
+    const char *content;
+    size_t length;
+    cJSON_bool unordered;
+    cJSON_bool arenas;
+    cJSON_LinesCallback callback;
+    void *context;
+
+    /* shared state, guarded by lock */
+    size_t next_offset; /* start of the first block nobody took yet */
+    size_t next_block; /* its number */
+    size_t next_delivery; /* ordered mode: the block whose lines are delivered next */
+    cJSON_bool stop;
+    cJSON_bool success;
+#ifdef CJSON_LINES_POSIX
+    pthread_mutex_t lock;
+    pthread_cond_t delivered;
+#endif
+} lines_job;
+
+#ifdef CJSON_LINES_POSIX
+#define lines_lock(job) pthread_mutex_lock(&(job)->lock)
+#define lines_unlock(job) pthread_mutex_unlock(&(job)->lock)
+#define lines_wait(job) pthread_cond_wait(&(job)->delivered, &(job)->lock)
+#define lines_wake(job) pthread_cond_broadcast(&(job)->delivered)
+#else
+/* a single thread never has to wait */
+#define lines_lock(job)
+#define lines_unlock(job)
+#define lines_wait(job)
+#define lines_wake(job)
+#endif
+
+typedef struct
+{
+    size_t offset;
+    cJSON *item;
+} parsed_line;
+
+/* ordered mode: the documents of a block, kept until it is the block's turn */
+typedef struct
+{
+    parsed_line *lines;
+    size_t count;
+    size_t size;
+} parsed_block;
+
+static void lines_abort(lines_job * const job, const cJSON_bool failure)
+{
+    lines_lock(job);
+    job->stop = true;
+    if (failure)
+    {
+        job->success = false;
+    }
+    lines_wake(job);
+    lines_unlock(job);
+}
+
+/* claim the next block, false once the input is exhausted or parsing was stopped */
+static cJSON_bool lines_next_block(lines_job * const job, size_t * const start, size_t * const end, size_t * const number)
+{
+    cJSON_bool found = false;
+
+    lines_lock(job);
+    if (!job->stop && (job->next_offset < job->length))
+    {
+        *start = job->next_offset;
+        *end = *start + CJSON_LINES_BLOCK_SIZE;
+        if (*end >= job->length)
+        {
+            *end = job->length;
+        }
+        else
+        {
+            /* extend the block to the end of its last line. JSON strings can't contain raw newlines,
+             * so every '\n' ends a line and no quotes have to be tracked (memchr is vectorized in libc) */
+            const char *newline = (const char*)memchr(job->content + *end, '\n', job->length - *end);
+            *end = (newline == NULL) ? job->length : (size_t)(newline - job->content) + 1;
+        }
+        *number = job->next_block++;
+        job->next_offset = *end;
+        found = true;
+    }
+    lines_unlock(job);
+
+    return found;
+}
+
+/* the parsed lines are released with cJSON_Delete, so they are allocated with the global hooks */
+static void * CJSON_CDECL lines_malloc(size_t size)
+{
+    return cJSON_malloc(size);
+}
+
+static void CJSON_CDECL lines_free(void *pointer)
+{
+    cJSON_free(pointer);
+}
+
+/* parse a single line, NULL if it isn't valid JSON */
+static cJSON *lines_parse(const char *line, const size_t length, cJSON_Arena * const arena)
+{
+    cJSON_Context context;
+    cJSON *item = NULL;
+
+    /* a context of its own keeps the threads from racing on the global error position */
+    cJSON_InitContext(&context);
+    context.hooks.malloc_fn = lines_malloc;
+    context.hooks.free_fn = lines_free;
+    context.arena = arena;
+    item = cJSON_ParseCtx(line, length, &context);
+
+    /* the whitespace around the line was already removed, so anything left over is garbage */
+    if ((item != NULL) && (context.end != (line + length)))
+    {
+        cJSON_DeleteCtx(item, &context);
+        item = NULL;
+    }
+
+    return item;
+}
+
+static cJSON_bool parsed_block_add(parsed_block * const block, const size_t offset, cJSON * const item)
+{
+    if (block->count == block->size)
+    {
+        size_t new_size = (block->size == 0) ? 64 : (block->size * 2);
+        parsed_line *new_lines = (parsed_line*)cJSON_malloc(new_size * sizeof(parsed_line));
+        if (new_lines == NULL)
+        {
+            return false;
+        }
+        if (block->lines != NULL)
+        {
+            memcpy(new_lines, block->lines, block->count * sizeof(parsed_line));
+            cJSON_free(block->lines);
+        }
+        block->lines = new_lines;
+        block->size = new_size;
+    }
+
+    block->lines[block->count].offset = offset;
+    block->lines[block->count].item = item;
+    block->count++;
+
+    return true;
+}
+
+/* ordered mode: wait for the turn of the block, then deliver its documents */
+static cJSON_bool lines_deliver_block(lines_job * const job, const parsed_block * const block, const size_t number)
+{
+    size_t i = 0;
+    cJSON_bool go_on = true;
+
+    lines_lock(job);
+    while ((job->next_delivery != number) && !job->stop)
+    {
+        lines_wait(job);
+    }
+    go_on = !job->stop;
+    lines_unlock(job);
+
+    for (i = 0; go_on && (i < block->count); i++)
+    {
+        go_on = job->callback(job->context, block->lines[i].offset, block->lines[i].item);
+    }
+    if (!go_on)
+    {
+        return false;
+    }
+
+    lines_lock(job);
+    job->next_delivery++;
+    lines_wake(job);
+    lines_unlock(job);
+
+    return true;
+}
+
+static void lines_worker(lines_job * const job)
+{
+    parsed_block block;
+    size_t start = 0;
+    size_t end = 0;
+    size_t number = 0;
+
+    memset(&block, '\0', sizeof(block));
+
+    while (lines_next_block(job, &start, &end, &number))
+    {
+        cJSON_Arena *arena = NULL;
+        const char *line = job->content + start;
+        const char * const block_end = job->content + end;
+        cJSON_bool go_on = true;
+        size_t i = 0;
+
+        if (job->arenas)
+        {
+            arena = cJSON_ArenaNew(0);
+            if (arena == NULL)
+            {
+                lines_abort(job, true);
+                break;
+            }
+        }
+
+        block.count = 0;
+        while (go_on && (line < block_end))
+        {
+            const char *newline = (const char*)memchr(line, '\n', (size_t)(block_end - line));
+            const char *line_end = (newline == NULL) ? block_end : newline;
+            const char *next = (newline == NULL) ? block_end : (newline + 1);
+            cJSON *item = NULL;
+
+            /* skip blank lines and strip whitespace, including the '\r' of CRLF line endings */
+            while ((line < line_end) && ((unsigned char)*line <= 32))
+            {
+                line++;
+            }
+            while ((line_end > line) && ((unsigned char)line_end[-1] <= 32))
+            {
+                line_end--;
+            }
+            if (line == line_end)
+            {
+                line = next;
+                continue;
+            }
+
+            item = lines_parse(line, (size_t)(line_end - line), arena);
+            if (job->unordered)
+            {
+                go_on = job->callback(job->context, (size_t)(line - job->content), item);
+                if (arena == NULL)
+                {
+                    cJSON_Delete(item);
+                }
+                if (!go_on)
+                {
+                    lines_abort(job, true);
+                }
+            }
+            else if (!parsed_block_add(&block, (size_t)(line - job->content), item))
+            {
+                if (arena == NULL)
+                {
+                    cJSON_Delete(item);
+                }
+                lines_abort(job, true);
+                go_on = false;
+            }
+
+            line = next;
+        }
+
+        if (go_on && !job->unordered && !lines_deliver_block(job, &block, number))
+        {
+            lines_abort(job, true);
+        }
+
+        if (arena != NULL)
+        {
+            cJSON_ArenaFree(arena);
+        }
+        else
+        {
+            for (i = 0; i < block.count; i++)
+            {
+                cJSON_Delete(block.lines[i].item);
+            }
+        }
+        block.count = 0;
+    }
+
+    if (block.lines != NULL)
+    {
+        cJSON_free(block.lines);
+    }
+}
+
+#ifdef CJSON_LINES_POSIX
+static void *lines_thread(void *job)
+{
+    lines_worker((lines_job*)job);
+    return NULL;
+}
+#endif
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseLines(const char *value, size_t buffer_length, const cJSON_LinesOptions *options, cJSON_LinesCallback callback, void *context)
+{
+    lines_job job;
+    size_t threads = 1;
+
+    if (((value == NULL) && (buffer_length > 0)) || (callback == NULL))
+    {
+        return false;
+    }
+
+    memset(&job, '\0', sizeof(job));
+    job.content = value;
+    job.length = buffer_length;
+    job.callback = callback;
+    job.context = context;
+    job.success = true;
+    if (options != NULL)
+    {
+        job.unordered = options->unordered;
+        job.arenas = options->arenas;
+        threads = options->threads;
+    }
+
+#ifdef CJSON_LINES_POSIX
+    if (threads == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (size_t)cpus : 1;
+    }
+    /* no more threads than blocks */
+    if (threads > ((buffer_length / CJSON_LINES_BLOCK_SIZE) + 1))
+    {
+        threads = (buffer_length / CJSON_LINES_BLOCK_SIZE) + 1;
+    }
+    if (threads > CJSON_LINES_MAX_THREADS)
+    {
+        threads = CJSON_LINES_MAX_THREADS;
+    }
+
+    if (pthread_mutex_init(&job.lock, NULL) != 0)
+    {
+        return false;
+    }
+    if (pthread_cond_init(&job.delivered, NULL) != 0)
+    {
+        pthread_mutex_destroy(&job.lock);
+        return false;
+    }
+
+    {
+        pthread_t workers[CJSON_LINES_MAX_THREADS];
+        size_t started = 0;
+
+        /* the calling thread is one of the workers, if starting the others fails it just does more of the work */
+        while ((started < (threads - 1)) && (pthread_create(&workers[started], NULL, lines_thread, &job) == 0))
+        {
+            started++;
+        }
+        lines_worker(&job);
+        while (started > 0)
+        {
+            pthread_join(workers[--started], NULL);
+        }
+    }
+
+    pthread_cond_destroy(&job.delivered);
+    pthread_mutex_destroy(&job.lock);
+#else
+    (void)threads;
+    lines_worker(&job);
+#endif
+
+    return job.success;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseLinesFile(const char *path, const cJSON_LinesOptions *options, cJSON_LinesCallback callback, void *context)
+{
+    cJSON_bool success = false;
+#ifdef CJSON_LINES_POSIX
+    struct stat status;
+    void *content = NULL;
+    int file = -1;
+
+    if (path == NULL)
+    {
+        return false;
+    }
+
+    file = open(path, O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+    if ((fstat(file, &status) != 0) || (status.st_size < 0))
+    {
+        goto end;
+    }
+    if (status.st_size == 0)
+    {
+        success = (callback != NULL);
+        goto end;
+    }
+
+    content = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (content == MAP_FAILED)
+    {
+        goto end;
+    }
+    success = cJSON_ParseLines((const char*)content, (size_t)status.st_size, options, callback, context);
+    munmap(content, (size_t)status.st_size);
+
+end:
+    close(file);
+#else
+    FILE *file = NULL;
+    char *content = NULL;
+    size_t length = 0;
+    size_t size = 64 * 1024;
+
+    if (path == NULL)
+    {
+        return false;
+    }
+
+    file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    /* read the whole file, growing the buffer as needed */
+    content = (char*)cJSON_malloc(size);
+    while (content != NULL)
+    {
+        char *new_content = NULL;
+
+        length += fread(content + length, 1, size - length, file);
+        if (length < size)
+        {
+            break;
+        }
+        new_content = (char*)cJSON_malloc(size * 2);
+        if (new_content != NULL)
+        {
+            memcpy(new_content, content, length);
+        }
+        cJSON_free(content);
+        content = new_content;
+        size *= 2;
+    }
+
+    if ((content != NULL) && !ferror(file))
+    {
+        success = cJSON_ParseLines(content, length, options, callback, context);
+    }
+    if (content != NULL)
+    {
+        cJSON_free(content);
+    }
+    fclose(file);
+#endif
+
+    return success;
+}
@@ -0,0 +1,61 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#ifndef cJSON_Lines__h
+#define cJSON_Lines__h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "cJSON.h"
+
+/* JSON Lines / NDJSON (one document per line) parsed on multiple threads.
+ * Zero-initialized options (or NULL) select the defaults. */
+typedef struct cJSON_LinesOptions
+{
+    /* number of parsing threads, 0 for one per online CPU */
+    size_t threads;
+    /* deliver documents as they are parsed instead of in input order */
+    cJSON_bool unordered;
+    /* parse the lines of every thread into a cJSON_Arena instead of using cJSON_Delete */
+    cJSON_bool arenas;
+} cJSON_LinesOptions;
+
+/* Called once for every non-empty line. offset is the position of the line in the input, item is NULL if the line
+ * isn't valid JSON. The document is released after the call returns, use cJSON_Duplicate to keep a copy.
+ * Returning false stops the parsing. In ordered mode the calls are made one at a time in input order,
+ * with unordered they come from all threads at once. Lines are parsed with cJSON_ParseCtx, so cJSON_GetErrorPtr is not touched. */
+typedef cJSON_bool (*cJSON_LinesCallback)(void *context, size_t offset, cJSON *item);
+
+/* Returns true if every line was delivered, false if the callback stopped or memory ran out. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseLines(const char *value, size_t buffer_length, const cJSON_LinesOptions *options, cJSON_LinesCallback callback, void *context);
+/* Same for a file, which is memory mapped where possible. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseLinesFile(const char *path, const cJSON_LinesOptions *options, cJSON_LinesCallback callback, void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -348,6 +348,51 @@ static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer,
     return current_element;
 }
 
+/* give the containers on the way to pointer their own children, see cJSON_DuplicateShared.
+ * The item pointer points to may still share its children. */
+static cJSON_bool unshare_path(cJSON * const object, const char * pointer, const cJSON_bool case_sensitive)
+{
+    cJSON *current_element = object;
+
+    while ((pointer[0] == '/') && (current_element != NULL))
+    {
+        if (!cJSON_Unshare(current_element))
+        {
+            return false;
+        }
+        pointer++;
+        if (cJSON_IsArray(current_element))
+        {
+            size_t index = 0;
+            if (!decode_array_index_from_pointer((const unsigned char*)pointer, &index))
+            {
+                break;
+            }
+            current_element = get_array_item(current_element, index);
+        }
+        else if (cJSON_IsObject(current_element))
+        {
+            current_element = current_element->child;
+            while ((current_element != NULL) && !compare_pointers((unsigned char*)current_element->string, (const unsigned char*)pointer, case_sensitive))
+            {
+                current_element = current_element->next;
+            }
+        }
+        else
+        {
+            break;
+        }
+
+        /* skip to the next path token or end of string */
+        while ((pointer[0] != '\0') && (pointer[0] != '/'))
+        {
+            pointer++;
+        }
+    }
+
+    return true;
+}
+
 CJSON_PUBLIC(cJSON *) cJSONUtils_GetPointer(cJSON * const object, const char *pointer)
 {
     return get_item_from_pointer(object, pointer, false);
@@ -425,6 +470,7 @@ static cJSON *detach_item_from_array(cJSON *array, size_t which)
     }
     /* make sure the detached item doesn't point anywhere anymore */
     c->prev = c->next = NULL;
+    cJSON_InvalidateIndex(array);
 
     return c;
 }
@@ -598,11 +644,12 @@ static cJSON *sort_list(cJSON *list, const cJSON_bool case_sensitive)
 
 static void sort_object(cJSON * const object, const cJSON_bool case_sensitive)
 {
-    if (object == NULL)
+    if ((object == NULL) || !cJSON_Unshare(object))
     {
         return;
     }
     object->child = sort_list(object->child, case_sensitive);
+    cJSON_InvalidateIndex(object);
 }
 
 static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensitive)
@@ -638,6 +685,11 @@ static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensiti
             }
 
         case cJSON_Array:
+            /* objects in the arrays get sorted */
+            if (!cJSON_Unshare(a) || !cJSON_Unshare(b))
+            {
+                return false;
+            }
             for ((void)(a = a->child), b = b->child; (a != NULL) && (b != NULL); (void)(a = a->next), b = b->next)
             {
                 cJSON_bool identical = compare_json(a, b, case_sensitive);
@@ -730,6 +782,7 @@ static cJSON_bool insert_item_in_array(cJSON *array, size_t which, cJSON *newite
     {
         newitem->prev->next = newitem;
     }
+    cJSON_InvalidateIndex(array);
 
     return 1;
 }
@@ -791,25 +844,28 @@ static enum patch_operation decode_patch_operation(const cJSON * const patch, co
 /* overwrite and existing item with another one and free resources on the way */
 static void overwrite_item(cJSON * const root, const cJSON replacement)
 {
+    int arena_flag = 0;
+
     if (root == NULL)
     {
         return;
     }
 
-    if (root->string != NULL)
-    {
-        cJSON_free(root->string);
-    }
-    if (root->valuestring != NULL)
+    arena_flag = root->type & cJSON_IsArenaItem;
+    cJSON_ReleaseKey(root);
+    if (!(root->type & (cJSON_IsReference | cJSON_IsArenaItem)) && (root->valuestring != NULL))
     {
         cJSON_free(root->valuestring);
     }
-    if (root->child != NULL)
+    if (!(root->type & cJSON_IsReference) && (root->child != NULL))
     {
         cJSON_Delete(root->child);
     }
+    cJSON_InvalidateIndex(root);
 
     memcpy(root, &replacement, sizeof(cJSON));
+    /* the memory of root itself still belongs to its arena */
+    root->type |= arena_flag;
 }
 
 static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_sensitive)
@@ -837,7 +893,15 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
         status = 3;
         goto cleanup;
     }
-    else if (opcode == TEST)
+
+    /* copies made by cJSON_DuplicateShared keep their children, even compare_json sorts them */
+    if (!unshare_path(object, path->valuestring, case_sensitive))
+    {
+        status = 14;
+        goto cleanup;
+    }
+
+    if (opcode == TEST)
     {
         /* compare value: {...} with the given path */
         // ~| nl=1
@@ -848,6 +912,12 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
     /* special case for replacing the root */
     if (path->valuestring[0] == '\0')
     {
+        if (!cJSON_Unshare(object))
+        {
+            status = 14;
+            goto cleanup;
+        }
+
         if (opcode == REMOVE)
         {
             static const cJSON invalid = { NULL, NULL, NULL, cJSON_Invalid, NULL, 0, 0, NULL};
@@ -884,11 +954,7 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
             value = NULL;
 
             /* the string "value" isn't needed */
-            if (object->string != NULL)
-            {
-                cJSON_free(object->string);
-                object->string = NULL;
-            }
+            cJSON_ReleaseKey(object);
 
             status = 0;
             goto cleanup;
@@ -927,6 +993,11 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
 
         if (opcode == MOVE)
         {
+            if (!unshare_path(object, from->valuestring, case_sensitive))
+            {
+                status = 14;
+                goto cleanup;
+            }
             value = detach_path(object, (unsigned char*)from->valuestring, case_sensitive);
         }
         if (opcode == COPY)
@@ -1186,9 +1257,18 @@ static void create_patches(cJSON * const patches, const unsigned char * const pa
         case cJSON_Array:
         {
             size_t index = 0;
-            cJSON *from_child = from->child;
-            cJSON *to_child = to->child;
-            unsigned char *new_path = (unsigned char*)cJSON_malloc(strlen((const char*)path) + 20 + sizeof("/")); /* Allow space for 64bit int. log10(2^64) = 20 */
+            cJSON *from_child = NULL;
+            cJSON *to_child = NULL;
+            unsigned char *new_path = NULL;
+
+            /* objects in the arrays get sorted */
+            if (!cJSON_Unshare(from) || !cJSON_Unshare(to))
+            {
+                return;
+            }
+            from_child = from->child;
+            to_child = to->child;
+            new_path = (unsigned char*)cJSON_malloc(strlen((const char*)path) + 20 + sizeof("/")); /* Allow space for 64bit int. log10(2^64) = 20 */
 
             /* generate patches for all array elements that exist in both "from" and "to" */
             for (index = 0; (from_child != NULL) && (to_child != NULL); (void)(from_child = from_child->next), (void)(to_child = to_child->next), index++)
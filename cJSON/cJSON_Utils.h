@@ -48,7 +48,7 @@ CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, con
 // Note that ApplyPatches is NOT atomic on failure. To implement an atomic ApplyPatches, use:
 //int cJSONUtils_AtomicApplyPatches(cJSON **object, cJSON *patches)
 //{
-//    cJSON *modme = cJSON_Duplicate(*object, 1);
+//    cJSON *modme = cJSON_DuplicateShared(*object);
 //    int error = cJSONUtils_ApplyPatches(modme, patches);
 //    if (!error)
 //    {
@@ -62,7 +62,8 @@ CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, con
 //
 //    return error;
 //}
-// Code not added to library since this strategy is a LOT slower.
+// cJSON_DuplicateShared only copies the containers on the paths the patches change,
+// cJSON_Duplicate(*object, 1) would copy the whole document.
 */
 
 /* Implement RFC7386 (https://tools.ietf.org/html/rfc7396) JSON Merge Patch spec. */
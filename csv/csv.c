@@ -40,6 +40,14 @@ typedef off_t file_off_t;
  * @delim: delimeter - ','
  * @quote: quote '"'
  * @escape: escape char
+ * @validateUtf8: check rows for well-formed utf-8 while searching for LF
+ * @utf8Need: continuation bytes still expected by the utf-8 validator
+ * @utf8Lo: lowest allowed value of the next continuation byte
+ * @utf8Hi: highest allowed value of the next continuation byte
+ * @utf8Error: set when invalid utf-8 was found
+ * @utf8ErrorOffset: file offset of the first invalid byte
+ * @utf8ErrorRow: row (zero based) containing the first invalid byte
+ * @rows: number of rows returned so far
  */
 struct CsvHandle_
 {
@@ -67,6 +75,15 @@ struct CsvHandle_
     char delim;
     char quote;
     char escape;
+
+    int validateUtf8;
+    unsigned utf8Need;
+    unsigned char utf8Lo;
+    unsigned char utf8Hi;
+    int utf8Error;
+    file_off_t utf8ErrorOffset;
+    size_t utf8ErrorRow;
+    size_t rows;
 };
 
 CsvHandle CsvOpen(const char* filename)
@@ -328,36 +345,126 @@ char* handle_quote_and_newline(char c, int n, char quote, CsvHandle handle, char
     return NULL;
 }
 
+/* SWAR helpers, test 8 bytes of a 64bit word at once */
+#define CSV_ONES64  0x0101010101010101ULL
+#define CSV_HIGHS64 0x8080808080808080ULL
+#define CSV_HAS_ZERO64(x) (((x) - CSV_ONES64) & ~(x) & CSV_HIGHS64)
+#define CSV_HAS_BYTE64(x, c) CSV_HAS_ZERO64((x) ^ (CSV_ONES64 * (unsigned char)(c)))
+
+/* feed one byte to the utf-8 validator:
+ * @return: 0 if the byte is valid at this position, -1 otherwise
+ * @notes: rejects overlong forms, surrogates and code points above U+10FFFF
+ */
+static int CsvUtf8Step(CsvHandle handle, unsigned char c)
+{
+    if (handle->utf8Need)
+    {
+        if (c < handle->utf8Lo || c > handle->utf8Hi)
+            return -1;
+
+        handle->utf8Need--;
+        handle->utf8Lo = 0x80;
+        handle->utf8Hi = 0xBF;
+        return 0;
+    }
+
+    if (c < 0x80)
+        return 0;
+
+    handle->utf8Lo = 0x80;
+    handle->utf8Hi = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF)
+        handle->utf8Need = 1;
+    else if (c == 0xE0)
+    {
+        handle->utf8Need = 2;
+        handle->utf8Lo = 0xA0;
+    }
+    else if (c == 0xED)
+    {
+        handle->utf8Need = 2;
+        handle->utf8Hi = 0x9F;
+    }
+    else if (c >= 0xE1 && c <= 0xEF)
+        handle->utf8Need = 2;
+    else if (c == 0xF0)
+    {
+        handle->utf8Need = 3;
+        handle->utf8Lo = 0x90;
+    }
+    else if (c == 0xF4)
+    {
+        handle->utf8Need = 3;
+        handle->utf8Hi = 0x8F;
+    }
+    else if (c >= 0xF1 && c <= 0xF3)
+        handle->utf8Need = 3;
+    else
+        return -1;
+
+    return 0;
+}
+
+static void CsvSetUtf8Error(CsvHandle handle, file_off_t offset)
+{
+    handle->utf8Error = 1;
+    handle->utf8ErrorOffset = offset;
+    handle->utf8ErrorRow = handle->rows;
+}
+
+/* validate byte at @p, recording the error position on failure */
+static int CsvValidateByte(CsvHandle handle, char* p)
+{
+    if (CsvUtf8Step(handle, (unsigned char)*p))
+    {
+        /* the mapped window starts at mapSize - blockSize */
+        CsvSetUtf8Error(handle, handle->mapSize - (file_off_t)handle->blockSize
+                                + (file_off_t)(p - (char*)handle->mem));
+        return -1;
+    }
+    return 0;
+}
+
 char* CsvSearchLf(char* p, size_t size, CsvHandle handle)
 {
-    /* TODO: this can be greatly optimized by
-     * using modern SIMD instructions, but for now
-     * we only fetch 8Bytes "at once"
+    /* 8 bytes are tested "at once" (SWAR), only words containing
+     * LF, quote or (when validating) non-ascii bytes are unpacked
      */
     char* res;
     char* end = p + size;
     char quote = handle->quote;
+    int validate = handle->validateUtf8;
 
 #ifdef CSV_UNPACK_64_SEARCH
-    uint64_t* pd = (uint64_t*)p;
-    uint64_t* pde = pd + (size / sizeof(uint64_t));
+    /* p need not be aligned, words are copied out instead of loaded through a uint64_t pointer */
+    char* pe = p + (size - size % sizeof(uint64_t));
 
-    for (; pd < pde; pd++)
+    for (; p < pe; p += sizeof(uint64_t))
     {
+        uint64_t word;
+        memcpy(&word, p, sizeof word);
+        if (!CSV_HAS_BYTE64(word, '\n') && !CSV_HAS_BYTE64(word, quote)
+            && (!validate || (!(word & CSV_HIGHS64) && !handle->utf8Need)))
+            continue;
+
         /* unpack 64bits to 8x8bits */
-        p = (char*)pd;
         for (int i = 0; i < 8; i++)
         {
+            if (validate && CsvValidateByte(handle, p + i))
+                return NULL;
+
             res = handle_quote_and_newline(p[i], i, quote, handle, p);
             if (res != NULL) {
                 return res;
             }
         }
     }
-    p = (char*)pde;
 #endif
     for (; p < end; p++)
     {
+        if (validate && CsvValidateByte(handle, p))
+            return NULL;
+
         res = handle_quote_and_newline(*p, 0, quote, handle, p);
         if (res != NULL) {
             return res;
@@ -367,6 +474,23 @@ char* CsvSearchLf(char* p, size_t size, CsvHandle handle)
     return NULL;
 }
 
+void CsvValidateUtf8(CsvHandle handle, int enable)
+{
+    handle->validateUtf8 = enable != 0;
+}
+
+int CsvGetUtf8Error(CsvHandle handle, unsigned long long* offset, size_t* row)
+{
+    if (!handle->utf8Error)
+        return 0;
+
+    if (offset)
+        *offset = (unsigned long long)handle->utf8ErrorOffset;
+    if (row)
+        *row = handle->utf8ErrorRow;
+    return 1;
+}
+
 char* CsvReadNextRow(CsvHandle handle)
 {
     int err;
@@ -374,6 +498,10 @@ char* CsvReadNextRow(CsvHandle handle)
     char* found = NULL;
     size_t size;
 
+    /* stop reading after invalid utf-8 */
+    if (handle->utf8Error)
+        return NULL;
+
     do
     {
         err = CsvEnsureMapped(handle);
@@ -381,17 +509,34 @@ char* CsvReadNextRow(CsvHandle handle)
         
         if (err == -EINVAL)
         {
+            /* file ends in the middle of utf-8 sequence */
+            if (handle->validateUtf8 && handle->utf8Need)
+            {
+                CsvSetUtf8Error(handle, handle->fileSize);
+                break;
+            }
+
             /* if this is n-th iteration
              * return auxbuf (remaining bytes of the file) */
             if (p == NULL)
                 break;
 
+            handle->rows++;
             return handle->auxbuf;
         }
         else if (err == -ENOMEM)
         {
             break;
         }
+
+        /* skip utf-8 BOM at the beginning of the first window */
+        if (handle->validateUtf8 && handle->pos == 0
+            && handle->mapSize == (file_off_t)handle->blockSize
+            && handle->size >= 3
+            && memcmp(handle->mem, "\xEF\xBB\xBF", 3) == 0)
+        {
+            handle->pos = 3;
+        }
         
         size = handle->size - handle->pos;
         if (!size)
@@ -400,6 +545,8 @@ char* CsvReadNextRow(CsvHandle handle)
         /* search this chunk for NL */
         p = (char*)handle->mem + handle->pos;
         found = CsvSearchLf(p, size, handle);
+        if (handle->utf8Error)
+            break;
 
         if (found)
         {
@@ -407,6 +554,7 @@ char* CsvReadNextRow(CsvHandle handle)
             size = (size_t)(found - p) + 1;
             handle->pos += size;
             handle->quotes = 0;
+            handle->rows++;
             
             if (handle->auxbufPos)
             {
@@ -43,6 +43,24 @@ void CsvClose(CsvHandle handle);
  */
 char* CsvReadNextRow(CsvHandle handle);
 
+/**
+ * enables utf-8 validation of the rows read by CsvReadNextRow()
+ * @handle: csv handle
+ * @enable: non-zero enables validation
+ * @notes: call before the first CsvReadNextRow(), a leading BOM is skipped
+ *         and reading stops (returns NULL) at the first invalid byte
+ */
+void CsvValidateUtf8(CsvHandle handle, int enable);
+
+/**
+ * gets position of the first invalid utf-8 byte
+ * @handle: csv handle
+ * @offset: receives byte offset in the file (can be NULL)
+ * @row: receives zero based row number (can be NULL)
+ * @return: 1 if invalid utf-8 was found, 0 otherwise
+ */
+int CsvGetUtf8Error(CsvHandle handle, unsigned long long* offset, size_t* row);
+
 /**
  * get column of file
  * @row: csv row (you can use CsvReadNextRow() to parse next line)
@@ -3,6 +3,27 @@
 #include "test/test_create_patches.h"
 #include "test/test_find_pointer.h"
 #include "test/test_csv_parser.h"
+#include "test/test_index.h"
+#include "test/test_int64.h"
+#include "test/test_key_pool.h"
+#include "test/test_cow.h"
+#include "test/test_packed.h"
+#include "test/test_print_number.h"
+#include "test/test_stream.h"
+#include "test/test_events.h"
+#include "test/test_lazy.h"
+#include "test/test_validate.h"
+#include "test/test_arena.h"
+#include "test/test_insitu.h"
+#include "test/test_document.h"
+#include "test/test_binary.h"
+#include "test/test_parse_file.h"
+#include "test/test_minify.h"
+#include "test/test_lines.h"
+#include "test/test_writer.h"
+#include "test/test_printed_length.h"
+#include "test/test_context.h"
+#include "test/test_deep.h"
 
 // Include headers for other test suites here when they are added
 // #include "test_another_function.h"
@@ -13,6 +34,29 @@ int main() {
 
     printf("Running all test suites...\n\n");
 
+    // cJSON core tests
+    run_all_index_tests(&total_tests, &passed_tests);
+    run_all_int64_tests(&total_tests, &passed_tests);
+    run_all_key_pool_tests(&total_tests, &passed_tests);
+    run_all_cow_tests(&total_tests, &passed_tests);
+    run_all_packed_tests(&total_tests, &passed_tests);
+    run_all_print_number_tests(&total_tests, &passed_tests);
+    run_all_stream_tests(&total_tests, &passed_tests);
+    run_all_events_tests(&total_tests, &passed_tests);
+    run_all_lazy_tests(&total_tests, &passed_tests);
+    run_all_validate_tests(&total_tests, &passed_tests);
+    run_all_arena_tests(&total_tests, &passed_tests);
+    run_all_insitu_tests(&total_tests, &passed_tests);
+    run_all_document_tests(&total_tests, &passed_tests);
+    run_all_binary_tests(&total_tests, &passed_tests);
+    run_all_parse_file_tests(&total_tests, &passed_tests);
+    run_all_minify_tests(&total_tests, &passed_tests);
+    run_all_lines_tests(&total_tests, &passed_tests);
+    run_all_writer_tests(&total_tests, &passed_tests);
+    run_all_printed_length_tests(&total_tests, &passed_tests);
+    run_all_context_tests(&total_tests, &passed_tests);
+    run_all_deep_tests(&total_tests, &passed_tests);
+
     // Run the test suite for cJSONUtils_FindPointerFromObjectTo
     run_all_find_pointer_tests(&total_tests, &passed_tests);
 
@@ -0,0 +1,117 @@
+#include "test_arena.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// --- cJSON_ParseWithArena のテスト ---
+// 要素と文字列をアリーナから確保し、cJSON_ArenaFree でまとめて解放する。
+
+static const char* sample = "{\"a\":[1,2,{\"x\":\"hello\"}],\"b\":\"str\",\"c\":null,\"d\":-2.5e10,\"e\":\"\\u00e9\\n\"}";
+
+// 木を出力して期待する文字列と比べる
+static int prints_as(const cJSON* item, const char* expected) {
+    char* printed = cJSON_PrintUnformatted(item);
+    int ok = printed != NULL && strcmp(printed, expected) == 0;
+    if (!ok) {
+        printf("    expected %s\n    got      %s\n", expected, printed != NULL ? printed : "NULL");
+    }
+    cJSON_free(printed);
+    return ok;
+}
+
+static int test_same_tree_as_parse(void) {
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    cJSON* expected = cJSON_Parse(sample);
+    cJSON* root = cJSON_ParseWithArena(sample, strlen(sample) + 1, arena);
+    int ok = root != NULL && cJSON_Compare(expected, root, 1)
+        && (root->type & cJSON_IsArenaItem) && (root->child->type & cJSON_IsArenaItem);
+    // cJSON_Delete は不要
+    cJSON_Delete(expected);
+    cJSON_ArenaFree(arena);
+    return ok;
+}
+
+static int test_small_chunks(void) {
+    char json[3000];
+    size_t length = 0;
+    // チャンクより大きい文字列と、多数の要素
+    cJSON_Arena* arena = cJSON_ArenaNew(64);
+    length += (size_t)sprintf(json, "[\"");
+    memset(json + length, 'x', 1000);
+    length += 1000;
+    length += (size_t)sprintf(json + length, "\"");
+    for (int i = 0; i < 100; i++) {
+        length += (size_t)sprintf(json + length, ",{\"k%d\":%d}", i, i);
+    }
+    length += (size_t)sprintf(json + length, "]");
+    cJSON* root = cJSON_ParseWithArena(json, length, arena);
+    cJSON* expected = cJSON_ParseWithLength(json, length);
+    int ok = root != NULL && cJSON_GetArraySize(root) == 101 && cJSON_Compare(expected, root, 1);
+    cJSON_Delete(expected);
+    cJSON_ArenaFree(arena);
+    return ok;
+}
+
+static int test_modify_arena_tree(void) {
+    cJSON_Arena* arena = cJSON_ArenaNew(128);
+    cJSON* root = cJSON_ParseWithArena(sample, strlen(sample), arena);
+    int ok = root != NULL;
+    // アリーナの文字列を置き換え、通常の確保の要素を加える
+    ok = ok && cJSON_SetValuestring(cJSON_GetObjectItem(root, "b"), "a much longer string than before") != NULL;
+    ok = ok && cJSON_AddStringToObject(root, "f", "heap") != NULL;
+    ok = ok && cJSON_ReplaceItemInObject(root, "c", cJSON_CreateNumber(5));
+    cJSON* detached = cJSON_DetachItemFromObject(root, "a");
+    cJSON* copy = cJSON_Duplicate(detached, 1);
+    // アリーナの要素を削除しても、アリーナの外のものだけが解放される
+    cJSON_Delete(detached);
+    cJSON_DeleteItemFromObject(root, "d");
+    ok = ok && prints_as(root, "{\"b\":\"a much longer string than before\",\"c\":5,\"e\":\"\xC3\xA9\\n\",\"f\":\"heap\"}")
+        && prints_as(copy, "[1,2,{\"x\":\"hello\"}]") && !(copy->type & cJSON_IsArenaItem);
+    cJSON_Delete(copy);
+    // 通常の確保で加えた要素があるので、先に cJSON_Delete する
+    cJSON_Delete(root);
+    cJSON_ArenaFree(arena);
+    return ok;
+}
+
+static int test_arena_errors(void) {
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    const char* end = NULL;
+    int ok = cJSON_ParseWithArena("[1,2,", 5, arena) == NULL
+        && cJSON_ParseWithArena(NULL, 0, arena) == NULL
+        && cJSON_ParseWithArena("[1]", 3, NULL) == NULL
+        // require_null_terminated は値の後ろの文字を拒否する
+        && cJSON_ParseWithArenaOpts("[1] x", 6, &end, 1, arena) == NULL && end != NULL && *end == 'x'
+        && cJSON_ParseWithArenaOpts("[1] ", 5, &end, 1, arena) != NULL;
+    // 失敗した解析の分も含めてまとめて解放される
+    cJSON_ArenaFree(arena);
+    cJSON_ArenaFree(NULL);
+    return ok;
+}
+
+static int test_several_documents(void) {
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    cJSON* first = cJSON_ParseWithArena("{\"a\":1}", 7, arena);
+    cJSON* second = cJSON_ParseWithArena("[\"b\",2]", 7, arena);
+    int ok = prints_as(first, "{\"a\":1}") && prints_as(second, "[\"b\",2]");
+    // 別の文書へ移すこともできる
+    ok = ok && cJSON_AddItemToArray(second, cJSON_DetachItemFromObject(first, "a")) && prints_as(second, "[\"b\",2,1]");
+    cJSON_ArenaFree(arena);
+    return ok;
+}
+
+static const TestCase arena_tests[] = {
+    { "AR 1: The same tree as cJSON_Parse", test_same_tree_as_parse },
+    { "AR 2: Small chunks and strings larger than a chunk", test_small_chunks },
+    { "AR 3: Modifying, detaching and duplicating arena items", test_modify_arena_tree },
+    { "AR 4: Failed parses and require_null_terminated", test_arena_errors },
+    { "AR 5: Several documents in one arena", test_several_documents },
+};
+
+void run_all_arena_tests(int* total, int* passed) {
+    printf("--- Running cJSON_ParseWithArena Tests ---\n");
+    run_test_cases(arena_tests, (int)(sizeof(arena_tests) / sizeof(arena_tests[0])), total, passed);
+    printf("--- Finished cJSON_ParseWithArena Tests ---\n\n");
+}
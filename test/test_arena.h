@@ -0,0 +1,7 @@
+#ifndef TEST_ARENA_H_
+#define TEST_ARENA_H_
+
+// アリーナ解析 (cJSON_ParseWithArena) のテストスイート宣言
+void run_all_arena_tests(int* total, int* passed);
+
+#endif // TEST_ARENA_H_
@@ -0,0 +1,250 @@
+#include "test_binary.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON_Binary.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// --- CBOR と MessagePack のテスト ---
+// 符号化と復号、RFC 8949 付録 A などの例、壊れた入力の拒否。
+
+#define CBOR 1
+#define MSGPACK 0
+
+typedef struct {
+    const char* hex;
+    const char* json;
+    int canonical; // 復号した値を符号化すると同じバイト列になるか
+} Vector;
+
+static size_t from_hex(const char* hex, unsigned char* bytes) {
+    size_t length = 0;
+    unsigned int byte = 0;
+    for (; hex[0] != '\0' && hex[1] != '\0'; hex += 2) {
+        sscanf(hex, "%2x", &byte);
+        bytes[length++] = (unsigned char)byte;
+    }
+    return length;
+}
+
+static cJSON* decode(int cbor, const unsigned char* data, size_t length, size_t* consumed) {
+    return cbor ? cJSON_DecodeCBOR(data, length, consumed) : cJSON_DecodeMessagePack(data, length, consumed);
+}
+
+static unsigned char* encode(int cbor, const cJSON* item, size_t* length) {
+    return cbor ? cJSON_EncodeCBOR(item, length) : cJSON_EncodeMessagePack(item, length);
+}
+
+static int check_vectors(int cbor, const Vector* vectors, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        unsigned char bytes[64];
+        size_t length = from_hex(vectors[i].hex, bytes);
+        size_t consumed = 0;
+        size_t encoded_length = 0;
+        cJSON* item = decode(cbor, bytes, length, &consumed);
+        char* printed = cJSON_PrintUnformatted(item);
+        int ok = printed != NULL && strcmp(printed, vectors[i].json) == 0 && consumed == length;
+        if (ok && vectors[i].canonical) {
+            unsigned char* encoded = encode(cbor, item, &encoded_length);
+            ok = encoded != NULL && encoded_length == length && memcmp(encoded, bytes, length) == 0;
+            cJSON_free(encoded);
+        }
+        if (!ok) {
+            printf("    %s: %s, expected %s\n", vectors[i].hex, printed != NULL ? printed : "NULL", vectors[i].json);
+        }
+        cJSON_free(printed);
+        cJSON_Delete(item);
+        if (!ok) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int test_cbor_vectors(void) {
+    static const Vector vectors[] = {
+        // RFC 8949 付録 A
+        { "00", "0", 1 }, { "17", "23", 1 }, { "1818", "24", 1 }, { "1903e8", "1000", 1 }, { "1a000f4240", "1000000", 1 },
+        { "1b000000e8d4a51000", "1000000000000", 1 }, { "1bffffffffffffffff", "1.8446744073709552e+19", 0 },
+        { "3bffffffffffffffff", "-1.8446744073709552e+19", 0 }, { "20", "-1", 1 }, { "3863", "-100", 1 },
+        { "3903e7", "-1000", 1 }, { "f90000", "0", 0 }, { "f93c00", "1", 0 }, { "f93e00", "1.5", 0 },
+        { "f97bff", "65504", 0 }, { "fa47c35000", "100000", 0 }, { "fb3ff199999999999a", "1.1", 1 },
+        { "fbc010666666666666", "-4.1", 1 }, { "f90001", "5.960464477539063e-08", 0 }, { "f9c400", "-4", 0 },
+        { "fa3fc00000", "1.5", 1 }, { "f4", "false", 1 }, { "f5", "true", 1 }, { "f6", "null", 1 },
+        { "f7", "null", 0 }, { "60", "\"\"", 1 }, { "6161", "\"a\"", 1 }, { "6449455446", "\"IETF\"", 1 },
+        { "62225c", "\"\\\"\\\\\"", 1 }, { "80", "[]", 1 }, { "83010203", "[1,2,3]", 1 },
+        { "8301820203820405", "[1,[2,3],[4,5]]", 1 }, { "a0", "{}", 1 },
+        { "a26161016162820203", "{\"a\":1,\"b\":[2,3]}", 1 },
+        // 長さ不定の文字列とコンテナ
+        { "7f657374726561646d696e67ff", "\"streaming\"", 0 }, { "9fff", "[]", 0 },
+        { "9f018202039f0405ffff", "[1,[2,3],[4,5]]", 0 }, { "bf61610161629f0203ffff", "{\"a\":1,\"b\":[2,3]}", 0 },
+        // 未知のタグは読み飛ばし、タグ 262 は埋め込み JSON
+        { "c074323031332d30332d32315432303a30343a30305a", "\"2013-03-21T20:04:00Z\"", 0 },
+        { "d90106635b315d", "[1]", 1 },
+    };
+    return check_vectors(CBOR, vectors, sizeof(vectors) / sizeof(vectors[0]));
+}
+
+static int test_msgpack_vectors(void) {
+    static const Vector vectors[] = {
+        { "00", "0", 1 }, { "7f", "127", 1 }, { "cc80", "128", 1 }, { "cd0100", "256", 1 }, { "ce00010000", "65536", 1 },
+        { "cf0000000100000000", "4294967296", 1 }, { "ff", "-1", 1 }, { "e0", "-32", 1 }, { "d0df", "-33", 1 },
+        { "d1ff7f", "-129", 1 }, { "d2ffff7fff", "-32769", 1 }, { "d3ffffffff7fffffff", "-2147483649", 1 },
+        { "d38000000000000000", "-9223372036854775808", 1 }, { "cfffffffffffffffff", "1.8446744073709552e+19", 0 },
+        { "ca3fc00000", "1.5", 1 }, { "cb3ff199999999999a", "1.1", 1 }, { "c0", "null", 1 }, { "c2", "false", 1 },
+        { "c3", "true", 1 }, { "a0", "\"\"", 1 }, { "a3616263", "\"abc\"", 1 }, { "d903616263", "\"abc\"", 0 },
+        { "da0003616263", "\"abc\"", 0 }, { "90", "[]", 1 }, { "93010203", "[1,2,3]", 1 }, { "dc0001c0", "[null]", 0 },
+        { "80", "{}", 1 }, { "82a16101a16292c3c2", "{\"a\":1,\"b\":[true,false]}", 1 },
+        // 拡張型 CJSON_MSGPACK_RAW_TYPE は埋め込み JSON
+        { "c703015b315d", "[1]", 0 }, { "d40121", "!", 0 },
+    };
+    return check_vectors(MSGPACK, vectors, sizeof(vectors) / sizeof(vectors[0]));
+}
+
+static int rejects(int cbor, const char* hex) {
+    unsigned char bytes[16];
+    size_t length = from_hex(hex, bytes);
+    cJSON* item = decode(cbor, bytes, length, NULL);
+    cJSON_Delete(item);
+    if (item != NULL) {
+        printf("    decoded %s\n", hex);
+    }
+    return item == NULL;
+}
+
+static int test_invalid_input(void) {
+    unsigned char deep[2001];
+    int ok = rejects(CBOR, "4100") // バイト列
+        && rejects(CBOR, "a10102") // 文字列でないキー
+        && rejects(CBOR, "ff") && rejects(CBOR, "1c") && rejects(CBOR, "7f4100ff")
+        && rejects(MSGPACK, "c1") && rejects(MSGPACK, "c40100") && rejects(MSGPACK, "810101")
+        && rejects(MSGPACK, "d40200") && rejects(MSGPACK, "dd7fffffff") && rejects(CBOR, "");
+    // 入れ子の深さの上限 (CBOR はタグの連続も)
+    memset(deep, 0x81, 2000);
+    deep[2000] = 0;
+    ok = ok && cJSON_DecodeCBOR(deep, sizeof(deep), NULL) == NULL;
+    memset(deep, 0xc6, 2000);
+    ok = ok && cJSON_DecodeCBOR(deep, sizeof(deep), NULL) == NULL;
+    memset(deep, 0x91, 2000);
+    return ok && cJSON_DecodeMessagePack(deep, sizeof(deep), NULL) == NULL;
+}
+
+typedef struct {
+    unsigned char data[256];
+    size_t length;
+} Collected;
+
+static cJSON_bool collect(void* context, const char* data, size_t length) {
+    Collected* collected = (Collected*)context;
+    if (collected->length + length > sizeof(collected->data)) {
+        return 0;
+    }
+    memcpy(collected->data + collected->length, data, length);
+    collected->length += length;
+    return 1;
+}
+
+static int test_round_trips(void) {
+    const char* json = "{\"id\":123,\"name\":\"x\\u00e9\\n\",\"n\":[-1,-200,70000,-70000,5000000000,-5000000000,1.5,0.1,"
+        "-1e300,1e-310,9223372036854775807,-9223372036854775808],\"t\":true,\"f\":false,\"z\":null,\"o\":{},\"a\":[]}";
+    cJSON* item = cJSON_Parse(json);
+    int ok = item != NULL;
+    for (int cbor = 0; ok && cbor <= 1; cbor++) {
+        size_t length = 0;
+        size_t consumed = 0;
+        unsigned char* encoded = encode(cbor, item, &length);
+        cJSON* decoded = decode(cbor, encoded, length, &consumed);
+        Collected collected;
+        ok = encoded != NULL && decoded != NULL && consumed == length && cJSON_Compare(item, decoded, 1);
+        cJSON_Delete(decoded);
+        // writer への出力は一度に符号化したものと同じ
+        collected.length = 0;
+        ok = ok && (cbor ? cJSON_EncodeCBORToWriter(item, collect, &collected) : cJSON_EncodeMessagePackToWriter(item, collect, &collected))
+            && collected.length == length && memcmp(collected.data, encoded, length) == 0;
+        // 途中で切れた入力はすべて拒否される
+        for (size_t i = 0; ok && i < length; i++) {
+            decoded = decode(cbor, encoded, i, NULL);
+            ok = decoded == NULL;
+            cJSON_Delete(decoded);
+        }
+        cJSON_free(encoded);
+    }
+    cJSON_Delete(item);
+    return ok;
+}
+
+static int test_large_values_and_raw(void) {
+    char key[3000];
+    cJSON* object = cJSON_CreateObject();
+    cJSON* array = cJSON_CreateArray();
+    int ok = 1;
+    // 長い文字列と 65536 要素を超える配列で、長さの表現が切り替わる
+    memset(key, 'a', sizeof(key) - 1);
+    key[sizeof(key) - 1] = '\0';
+    cJSON_AddStringToObject(object, key, key);
+    cJSON_AddRawToObject(object, "raw", "[1, {\"x\":2}]");
+    cJSON_AddItemToObject(object, "arr", array);
+    for (int i = 0; i < 70000; i++) {
+        cJSON_AddItemToArray(array, cJSON_CreateNumber(i % 3));
+    }
+    for (int cbor = 0; ok && cbor <= 1; cbor++) {
+        size_t length = 0;
+        unsigned char* encoded = encode(cbor, object, &length);
+        cJSON* decoded = decode(cbor, encoded, length, NULL);
+        ok = decoded != NULL && cJSON_IsRaw(cJSON_GetObjectItem(decoded, "raw")) && cJSON_Compare(object, decoded, 1);
+        cJSON_Delete(decoded);
+        cJSON_free(encoded);
+    }
+    cJSON_Delete(object);
+    return ok;
+}
+
+static int test_sequences(void) {
+    unsigned char bytes[16];
+    size_t length = from_hex("0183010203f6", bytes);
+    size_t offset = 0;
+    size_t consumed = 0;
+    int count = 0;
+    // CBOR シーケンスを consumed で順に読む
+    while (offset < length) {
+        cJSON* item = cJSON_DecodeCBOR(bytes + offset, length - offset, &consumed);
+        if (item == NULL) {
+            return 0;
+        }
+        cJSON_Delete(item);
+        offset += consumed;
+        count++;
+    }
+    return count == 3;
+}
+
+static int test_random_bytes(void) {
+    unsigned long seed = 1;
+    // でたらめな入力でも落ちない (ASan で検出する)
+    for (int i = 0; i < 20000; i++) {
+        unsigned char bytes[24];
+        for (size_t j = 0; j < sizeof(bytes); j++) {
+            seed = seed * 6364136223846793005UL + 1;
+            bytes[j] = (unsigned char)(seed >> 56);
+        }
+        cJSON_Delete(cJSON_DecodeCBOR(bytes, sizeof(bytes), NULL));
+        cJSON_Delete(cJSON_DecodeMessagePack(bytes, sizeof(bytes), NULL));
+    }
+    return 1;
+}
+
+static const TestCase binary_tests[] = {
+    { "BIN 1: CBOR examples of RFC 8949", test_cbor_vectors },
+    { "BIN 2: MessagePack examples", test_msgpack_vectors },
+    { "BIN 3: Invalid input and the nesting limit", test_invalid_input },
+    { "BIN 4: Round trips, writers and truncated input", test_round_trips },
+    { "BIN 5: Long strings, large arrays and raw values", test_large_values_and_raw },
+    { "BIN 6: CBOR sequences", test_sequences },
+    { "BIN 7: Random bytes", test_random_bytes },
+};
+
+void run_all_binary_tests(int* total, int* passed) {
+    printf("--- Running CBOR and MessagePack Tests ---\n");
+    run_test_cases(binary_tests, (int)(sizeof(binary_tests) / sizeof(binary_tests[0])), total, passed);
+    printf("--- Finished CBOR and MessagePack Tests ---\n\n");
+}
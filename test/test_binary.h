@@ -0,0 +1,7 @@
+#ifndef TEST_BINARY_H_
+#define TEST_BINARY_H_
+
+// CBOR と MessagePack (cJSON_Binary) のテストスイート宣言
+void run_all_binary_tests(int* total, int* passed);
+
+#endif // TEST_BINARY_H_
@@ -0,0 +1,157 @@
+#include "test_context.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_ParseCtx / cJSON_PrintCtx / cJSON_DeleteCtx のテスト ---
+// 文脈ごとのアロケータだけを使い、エラーは cJSON_GetErrorPtr ではなく文脈に報告する。
+
+static const char* document = "{\"name\":\"x\\u00e9\",\"list\":[1,2.5,true,null,{\"k\":[]}],\"big\":9223372036854775807}";
+
+// 確保と解放を数えるアロケータ。スレッドごとに別の組を使うので、カウンタは共有されない
+typedef struct {
+    size_t allocations;
+    size_t frees;
+} allocation_count;
+
+#define COUNTING_HOOKS(name) \
+    static allocation_count name##_count; \
+    static void* name##_malloc(size_t size) { \
+        name##_count.allocations++; \
+        return malloc(size); \
+    } \
+    static void name##_free(void* pointer) { \
+        if (pointer != NULL) { \
+            name##_count.frees++; \
+        } \
+        free(pointer); \
+    }
+
+COUNTING_HOOKS(global)
+COUNTING_HOOKS(first)
+COUNTING_HOOKS(second)
+COUNTING_HOOKS(third)
+COUNTING_HOOKS(fourth)
+
+static int test_context_hooks(void) {
+    cJSON_Hooks global_hooks = { global_malloc, global_free };
+    cJSON_Context context;
+    cJSON* root = NULL;
+    char* printed = NULL;
+    char* expected = NULL;
+    int ok = 1;
+    cJSON_InitContext(&context);
+    context.hooks.malloc_fn = first_malloc;
+    context.hooks.free_fn = first_free;
+    memset(&first_count, 0, sizeof(first_count));
+    // 大域のフックは使われない
+    cJSON_InitHooks(&global_hooks);
+    memset(&global_count, 0, sizeof(global_count));
+    root = cJSON_ParseCtx(document, strlen(document) + 1, &context);
+    ok = root != NULL && first_count.allocations > 0 && first_count.frees == 0;
+    printed = cJSON_PrintCtx(root, 1, &context);
+    ok = ok && printed != NULL && global_count.allocations == 0;
+    cJSON_InitHooks(NULL);
+    // 結果は cJSON_Print と同じ
+    expected = cJSON_Print(root);
+    ok = ok && expected != NULL && strcmp(expected, printed) == 0;
+    cJSON_free(expected);
+    first_free(printed);
+    cJSON_DeleteCtx(root, &context);
+    // 確保したものはすべて同じフックで解放される
+    ok = ok && first_count.allocations == first_count.frees;
+    // NULL の文脈は失敗する
+    ok = ok && cJSON_ParseCtx(document, strlen(document) + 1, NULL) == NULL && cJSON_PrintCtx(root, 0, NULL) == NULL;
+    cJSON_DeleteCtx(NULL, &context);
+    return ok;
+}
+
+static int test_context_errors(void) {
+    const char* invalid = "{\"a\":[1,2,}";
+    cJSON_Context context;
+    const char* global_error = NULL;
+    cJSON* root = NULL;
+    int ok = cJSON_Parse("[1,]") == NULL;
+    global_error = cJSON_GetErrorPtr();
+    cJSON_InitContext(&context);
+    // エラーは文脈に入り、cJSON_GetErrorPtr は変わらない
+    ok = ok && cJSON_ParseCtx(invalid, strlen(invalid) + 1, &context) == NULL
+        && context.error == invalid + 10 && context.error_offset == 10
+        && cJSON_GetErrorPtr() == global_error;
+    // 成功すればエラーは消える
+    root = cJSON_ParseCtx("[]", 3, &context);
+    ok = ok && root != NULL && context.error == NULL;
+    cJSON_DeleteCtx(root, &context);
+    return ok;
+}
+
+// 各スレッドの仕事
+typedef struct {
+    cJSON_Hooks hooks;
+    allocation_count* count;
+    const char* invalid; // スレッドごとにエラー位置の違う入力
+    size_t error_offset;
+    int ok;
+} context_job;
+
+static void* run_context_job(void* argument) {
+    context_job* job = (context_job*)argument;
+    cJSON_Context context;
+    job->ok = 1;
+    memset(job->count, 0, sizeof(*job->count));
+    cJSON_InitContext(&context);
+    context.hooks = job->hooks;
+    for (int i = 0; job->ok && i < 300; ++i) {
+        cJSON* root = cJSON_ParseCtx(document, strlen(document) + 1, &context);
+        char* printed = cJSON_PrintCtx(root, 0, &context);
+        cJSON* again = (printed == NULL) ? NULL : cJSON_ParseCtx(printed, strlen(printed) + 1, &context);
+        job->ok = root != NULL && again != NULL && cJSON_Compare(root, again, 1) && context.error == NULL;
+        job->hooks.free_fn(printed);
+        cJSON_DeleteCtx(root, &context);
+        cJSON_DeleteCtx(again, &context);
+        // 他のスレッドのエラーは混ざらない
+        job->ok = job->ok && cJSON_ParseCtx(job->invalid, strlen(job->invalid) + 1, &context) == NULL
+            && context.error_offset == job->error_offset && context.error == job->invalid + job->error_offset;
+    }
+    job->ok = job->ok && job->count->allocations > 0 && job->count->allocations == job->count->frees;
+    return NULL;
+}
+
+static int test_concurrent_contexts(void) {
+    context_job jobs[4] = {
+        { { first_malloc, first_free }, &first_count, "[1,2,x]", 5, 0 },
+        { { second_malloc, second_free }, &second_count, "{\"a\" 1}", 5, 0 },
+        { { third_malloc, third_free }, &third_count, "[[[[]]]", 7, 0 },
+        { { fourth_malloc, fourth_free }, &fourth_count, "tru", 0, 0 },
+    };
+    pthread_t threads[4];
+    int started = 0;
+    int ok = 1;
+    for (started = 0; started < 4; ++started) {
+        if (pthread_create(&threads[started], NULL, run_context_job, &jobs[started]) != 0) {
+            ok = 0;
+            break;
+        }
+    }
+    for (int i = 0; i < started; ++i) {
+        pthread_join(threads[i], NULL);
+        ok = ok && jobs[i].ok;
+    }
+    return ok;
+}
+
+static const TestCase context_tests[] = {
+    { "CTX 1: Context hooks allocate and free everything", test_context_hooks },
+    { "CTX 2: Errors are reported to the context", test_context_errors },
+    { "CTX 3: Threads with their own contexts and hooks", test_concurrent_contexts },
+};
+
+void run_all_context_tests(int* total, int* passed) {
+    printf("--- Running cJSON_Context Tests ---\n");
+    run_test_cases(context_tests, (int)(sizeof(context_tests) / sizeof(context_tests[0])), total, passed);
+    printf("--- Finished cJSON_Context Tests ---\n\n");
+}
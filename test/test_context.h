@@ -0,0 +1,7 @@
+#ifndef TEST_CONTEXT_H_
+#define TEST_CONTEXT_H_
+
+// cJSON_ParseCtx / cJSON_PrintCtx / cJSON_DeleteCtx のテストスイート宣言
+void run_all_context_tests(int* total, int* passed);
+
+#endif // TEST_CONTEXT_H_
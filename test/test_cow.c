@@ -0,0 +1,181 @@
+#include "test_cow.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_DuplicateShared のテスト ---
+// コピーは子を共有し、子を取り出すか変更した配列・オブジェクトだけが自分の子を持つ。どちらの木も変更できる。
+
+static const char* document = "{\"a\":{\"x\":1},\"b\":2,\"s\":\"text\",\"l\":[1,{\"y\":true}]}";
+
+// item を印刷して expected と比べる
+static int prints_as(const cJSON* item, const char* expected) {
+    char* printed = cJSON_PrintUnformatted(item);
+    int ok = printed != NULL && strcmp(printed, expected) == 0;
+    cJSON_free(printed);
+    return ok;
+}
+
+static int test_copy_is_equal(void) {
+    cJSON* root = cJSON_Parse(document);
+    cJSON* snap = cJSON_DuplicateShared(root);
+    int ok = root != NULL && snap != NULL && snap != root
+        && (snap->type & cJSON_IsShared) && snap->child == root->child && cJSON_Compare(root, snap, 1);
+    // 元を先に削除しても、コピーは子を保持する
+    cJSON_Delete(root);
+    ok = ok && prints_as(snap, "{\"a\":{\"x\":1},\"b\":2,\"s\":\"text\",\"l\":[1,{\"y\":true}]}");
+    cJSON_Delete(snap);
+    return ok;
+}
+
+static int test_changes_copy_the_path(void) {
+    cJSON* root = cJSON_Parse(document);
+    cJSON* snap = cJSON_DuplicateShared(root);
+    cJSON* a = NULL;
+    int ok = root != NULL && snap != NULL && cJSON_AddNumberToObject(root, "c", 3) != NULL;
+    // 変更の前に取り直した子は変更できる
+    a = cJSON_GetObjectItem(root, "a");
+    ok = ok && a != NULL && cJSON_AddNumberToObject(a, "y", 1) != NULL
+        && prints_as(root, "{\"a\":{\"x\":1,\"y\":1},\"b\":2,\"s\":\"text\",\"l\":[1,{\"y\":true}],\"c\":3}")
+        && prints_as(snap, "{\"a\":{\"x\":1},\"b\":2,\"s\":\"text\",\"l\":[1,{\"y\":true}]}")
+        // 変更されていない部分は共有されたまま
+        && cJSON_GetObjectItem(root, "l")->child == cJSON_GetObjectItem(snap, "l")->child;
+    cJSON_Delete(root);
+    cJSON_Delete(snap);
+    return ok;
+}
+
+static int test_both_trees_can_change(void) {
+    cJSON* root = cJSON_Parse(document);
+    cJSON* snap = cJSON_DuplicateShared(root);
+    cJSON* mine = NULL;
+    cJSON* theirs = NULL;
+    int ok = root != NULL && snap != NULL;
+    // 取り出した子はそれぞれの木のもので、どの変更も他方に現れない
+    mine = cJSON_GetObjectItem(cJSON_GetObjectItem(root, "a"), "x");
+    theirs = cJSON_GetObjectItem(cJSON_GetObjectItem(snap, "a"), "x");
+    ok = ok && mine != NULL && theirs != NULL && mine != theirs
+        && cJSON_SetNumberValue(mine, 5) == 5
+        && cJSON_SetIntValue(theirs, 6) == 6
+        && cJSON_SetValuestring(cJSON_GetObjectItem(root, "s"), "other") != NULL
+        && cJSON_SetBoolValue(cJSON_GetObjectItem(cJSON_GetArrayItem(cJSON_GetObjectItem(snap, "l"), 1), "y"), 0) == cJSON_False
+        && cJSON_AddNumberToObject(cJSON_GetObjectItem(root, "a"), "y", 1) != NULL
+        && cJSON_ReplaceItemViaPointer(cJSON_GetObjectItem(snap, "l"), cJSON_GetArrayItem(cJSON_GetObjectItem(snap, "l"), 0), cJSON_CreateNull())
+        && cJSON_InsertItemInArray(cJSON_GetObjectItem(root, "l"), 0, cJSON_CreateString("first"))
+        && cJSON_ReplaceItemInObject(snap, "b", cJSON_CreateTrue())
+        && prints_as(root, "{\"a\":{\"x\":5,\"y\":1},\"b\":2,\"s\":\"other\",\"l\":[\"first\",1,{\"y\":true}]}")
+        && prints_as(snap, "{\"a\":{\"x\":6},\"b\":true,\"s\":\"text\",\"l\":[null,{\"y\":false}]}");
+    cJSON_Delete(root);
+    cJSON_Delete(snap);
+    return ok;
+}
+
+static int test_iteration_copies_children(void) {
+    cJSON* root = cJSON_Parse("[1,2,3,[4,5]]");
+    cJSON* snap = cJSON_DuplicateShared(root);
+    cJSON* element = NULL;
+    int ok = snap != NULL;
+    // cJSON_ArrayForEach で取った要素も変更できる
+    cJSON_ArrayForEach(element, root) {
+        if (cJSON_IsNumber(element)) {
+            cJSON_SetNumberValue(element, element->valuedouble * 10);
+        } else {
+            ok = ok && cJSON_AddItemToArray(element, cJSON_CreateNumber(6));
+        }
+    }
+    ok = ok && cJSON_GetChild(snap) != NULL && cJSON_GetChild(snap) != cJSON_GetChild(root)
+        && prints_as(root, "[10,20,30,[4,5,6]]")
+        && prints_as(snap, "[1,2,3,[4,5]]")
+        // 比較と複製は共有された子をそのまま読む
+        && !cJSON_Compare(root, snap, 1);
+    cJSON_Delete(root);
+    cJSON_Delete(snap);
+    return ok;
+}
+
+static int test_copy_inside_the_same_tree(void) {
+    cJSON* doc = cJSON_Parse("{\"src\":{\"k\":{\"n\":1}}}");
+    cJSON* copy = cJSON_DuplicateShared(cJSON_GetObjectItem(doc, "src"));
+    cJSON* k = NULL;
+    // 同じ木の中にコピーを置いても、元とコピーの両方を変更できる
+    int ok = copy != NULL && cJSON_AddItemToObject(doc, "dst", copy)
+        && (k = cJSON_GetObjectItem(cJSON_GetObjectItem(doc, "src"), "k")) != NULL
+        && cJSON_AddNumberToObject(k, "m", 2) != NULL
+        && cJSON_SetNumberValue(cJSON_GetObjectItem(k, "n"), 3) == 3
+        && cJSON_AddNumberToObject(cJSON_GetObjectItem(cJSON_GetObjectItem(doc, "dst"), "k"), "d", 4) != NULL
+        && prints_as(doc, "{\"src\":{\"k\":{\"n\":3,\"m\":2}},\"dst\":{\"k\":{\"n\":1,\"d\":4}}}");
+    // 元を削除してもコピーは残る
+    cJSON_DeleteItemFromObject(doc, "src");
+    ok = ok && prints_as(doc, "{\"dst\":{\"k\":{\"n\":1,\"d\":4}}}");
+    cJSON_Delete(doc);
+    return ok;
+}
+
+static int test_references_to_shared_items(void) {
+    cJSON* root = cJSON_Parse(document);
+    cJSON* snap = cJSON_DuplicateShared(root);
+    cJSON* other = cJSON_CreateArray();
+    // 参照は元の子を見る。元に加えた変更は参照から見え、コピーには現れない
+    int ok = snap != NULL && cJSON_AddItemReferenceToArray(other, root)
+        && cJSON_AddNumberToObject(cJSON_GetObjectItem(root, "a"), "y", 1) != NULL
+        && prints_as(other, "[{\"a\":{\"x\":1,\"y\":1},\"b\":2,\"s\":\"text\",\"l\":[1,{\"y\":true}]}]")
+        && prints_as(snap, "{\"a\":{\"x\":1},\"b\":2,\"s\":\"text\",\"l\":[1,{\"y\":true}]}");
+    cJSON_Delete(other);
+    cJSON_Delete(root);
+    cJSON_Delete(snap);
+    return ok;
+}
+
+static int test_copies_of_copies(void) {
+    cJSON* root = cJSON_Parse(document);
+    cJSON* first = cJSON_DuplicateShared(root);
+    cJSON* second = NULL;
+    cJSON* a = NULL;
+    int ok = first != NULL && cJSON_AddNumberToObject(root, "c", 3) != NULL;
+    second = cJSON_DuplicateShared(root);
+    // コピーされなかった子は前のコピーからも共有されている
+    ok = ok && second != NULL && (a = cJSON_GetObjectItem(root, "a")) != NULL
+        && cJSON_AddNumberToObject(a, "y", 1) != NULL
+        && prints_as(first, "{\"a\":{\"x\":1},\"b\":2,\"s\":\"text\",\"l\":[1,{\"y\":true}]}")
+        && prints_as(second, "{\"a\":{\"x\":1},\"b\":2,\"s\":\"text\",\"l\":[1,{\"y\":true}],\"c\":3}");
+    // 他のコピーがすべて削除されれば、子はそのまま自分のものになる
+    cJSON_Delete(first);
+    cJSON_Delete(second);
+    a = root->child;
+    ok = ok && cJSON_Unshare(root) && !(root->type & cJSON_IsShared) && root->child == a
+        && (a = cJSON_GetObjectItem(root, "l")) != NULL;
+    cJSON_DeleteItemFromArray(a, 0);
+    cJSON_DeleteItemFromArray(a, 0);
+    ok = ok && prints_as(root, "{\"a\":{\"x\":1,\"y\":1},\"b\":2,\"s\":\"text\",\"l\":[],\"c\":3}");
+    // 子のコピーも共有し、元の木はそのまま変更できる
+    first = cJSON_DuplicateShared(root);
+    second = cJSON_DuplicateShared(cJSON_GetObjectItem(root, "a"));
+    ok = ok && second != NULL && (second->type & cJSON_IsShared) && cJSON_AddNumberToObject(second, "z", 2) != NULL
+        && cJSON_AddNumberToObject(cJSON_GetObjectItem(root, "a"), "w", 0) != NULL
+        && prints_as(second, "{\"x\":1,\"y\":1,\"z\":2}")
+        && prints_as(root, "{\"a\":{\"x\":1,\"y\":1,\"w\":0},\"b\":2,\"s\":\"text\",\"l\":[],\"c\":3}")
+        && prints_as(first, "{\"a\":{\"x\":1,\"y\":1},\"b\":2,\"s\":\"text\",\"l\":[],\"c\":3}");
+    cJSON_Delete(first);
+    cJSON_Delete(second);
+    cJSON_Delete(root);
+    return ok;
+}
+
+static const TestCase cow_tests[] = {
+    { "COW 1: Copy shares children and outlives the original", test_copy_is_equal },
+    { "COW 2: Changes copy only the path to them", test_changes_copy_the_path },
+    { "COW 3: Both trees can be changed through the accessors", test_both_trees_can_change },
+    { "COW 4: cJSON_ArrayForEach gives items of their own", test_iteration_copies_children },
+    { "COW 5: Copy placed in the same tree as its original", test_copy_inside_the_same_tree },
+    { "COW 6: References see the children of their original", test_references_to_shared_items },
+    { "COW 7: Copies of copies and the last owner", test_copies_of_copies },
+};
+
+void run_all_cow_tests(int* total, int* passed) {
+    printf("--- Running cJSON_DuplicateShared Tests ---\n");
+    run_test_cases(cow_tests, (int)(sizeof(cow_tests) / sizeof(cow_tests[0])), total, passed);
+    printf("--- Finished cJSON_DuplicateShared Tests ---\n\n");
+}
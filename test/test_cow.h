@@ -0,0 +1,7 @@
+#ifndef TEST_COW_H_
+#define TEST_COW_H_
+
+// 子の共有によるコピー (cJSON_DuplicateShared, cJSON_Unshare) のテストスイート宣言
+void run_all_cow_tests(int* total, int* passed);
+
+#endif // TEST_COW_H_
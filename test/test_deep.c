@@ -0,0 +1,156 @@
+#include "test_deep.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- 深い入れ子のテスト ---
+// 解析・印刷・複製・削除は明示的なスタックを使うので、10 万段の入れ子でも C のスタックを使い切らない。
+
+#define DEEP_LEVELS 100000
+
+// [[[...]]] または {"a":{"a":...}} を levels 段
+static char* nested_text(int levels, int objects) {
+    const char* open = objects ? "{\"a\":" : "[";
+    const size_t open_length = strlen(open);
+    char* text = (char*)malloc((size_t)levels * (open_length + 1) + 3);
+    size_t used = 0;
+    if (text == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < levels; ++i) {
+        memcpy(text + used, open, open_length);
+        used += open_length;
+    }
+    if (objects) {
+        text[used++] = '1';
+    }
+    for (int i = 0; i < levels; ++i) {
+        text[used++] = objects ? '}' : ']';
+    }
+    text[used] = '\0';
+    return text;
+}
+
+// 解析して印刷し、複製して削除する
+static int round_trip(int objects) {
+    char* text = nested_text(DEEP_LEVELS, objects);
+    cJSON_Context context;
+    cJSON* root = NULL;
+    cJSON* copy = NULL;
+    char* printed = NULL;
+    int ok = text != NULL;
+    cJSON_InitContext(&context);
+    context.nesting_limit = DEEP_LEVELS;
+    root = (text == NULL) ? NULL : cJSON_ParseCtx(text, strlen(text) + 1, &context);
+    printed = cJSON_PrintUnformatted(root);
+    ok = ok && root != NULL && printed != NULL && strcmp(printed, text) == 0;
+    cJSON_free(printed);
+    copy = cJSON_Duplicate(root, 1);
+    printed = cJSON_PrintUnformatted(copy);
+    ok = ok && copy != NULL && printed != NULL && strcmp(printed, text) == 0;
+    cJSON_free(printed);
+    cJSON_Delete(copy);
+    cJSON_DeleteCtx(root, &context);
+    free(text);
+    return ok;
+}
+
+static int test_deep_arrays(void) {
+    return round_trip(0);
+}
+
+static int test_deep_objects(void) {
+    return round_trip(1);
+}
+
+static int test_nesting_limit(void) {
+    char* text = nested_text(CJSON_NESTING_LIMIT + 1, 0);
+    cJSON_Context context;
+    // 既定の上限を超える入れ子は、文脈で上限を上げなければ拒否される
+    int ok = text != NULL && cJSON_Parse(text) == NULL;
+    cJSON_InitContext(&context);
+    ok = ok && cJSON_ParseCtx(text, strlen(text) + 1, &context) == NULL;
+    context.nesting_limit = CJSON_NESTING_LIMIT + 1;
+    {
+        cJSON* root = cJSON_ParseCtx(text, strlen(text) + 1, &context);
+        ok = ok && root != NULL;
+        cJSON_DeleteCtx(root, &context);
+    }
+    free(text);
+    return ok;
+}
+
+static void* deep_in_thread(void* argument) {
+    int* ok = (int*)argument;
+    cJSON* root = cJSON_CreateArray();
+    cJSON* current = root;
+    cJSON* copy = NULL;
+    char* printed = NULL;
+    char* copy_printed = NULL;
+    // 解析を通さずに組み立てた木も同じように扱える: [{"b":[{"b":...}]}]
+    for (int i = 1; current != NULL && i < DEEP_LEVELS; i += 2) {
+        cJSON* object = cJSON_CreateObject();
+        if (!cJSON_AddItemToArray(current, object)) {
+            cJSON_Delete(object);
+            object = NULL;
+        }
+        current = cJSON_AddArrayToObject(object, "b");
+    }
+    printed = cJSON_PrintUnformatted(root);
+    copy = cJSON_Duplicate(root, 1);
+    copy_printed = cJSON_PrintUnformatted(copy);
+    *ok = current != NULL && printed != NULL && strncmp(printed, "[{\"b\":[{\"b\":", 12) == 0
+        && copy_printed != NULL && strcmp(printed, copy_printed) == 0;
+    cJSON_free(printed);
+    cJSON_free(copy_printed);
+    cJSON_Delete(copy);
+    cJSON_Delete(root);
+    return NULL;
+}
+
+static int test_small_stack(void) {
+    // スタックの小さいスレッドでも削除まで終わる
+    pthread_attr_t attributes;
+    pthread_t thread;
+    int ok = 0;
+    if (pthread_attr_init(&attributes) != 0) {
+        return 0;
+    }
+    if (pthread_attr_setstacksize(&attributes, 512 * 1024) == 0
+        && pthread_create(&thread, &attributes, deep_in_thread, &ok) == 0) {
+        pthread_join(thread, NULL);
+    }
+    pthread_attr_destroy(&attributes);
+    return ok;
+}
+
+static int test_circular_reference(void) {
+    // 自分自身への参照を含む配列は無限に深いので、複製は CJSON_CIRCULAR_LIMIT で諦める
+    cJSON* array = cJSON_CreateArray();
+    cJSON* copy = NULL;
+    int ok = array != NULL && cJSON_AddItemToArray(array, cJSON_CreateNumber(1))
+        && cJSON_AddItemReferenceToArray(array, array);
+    copy = cJSON_Duplicate(array, 1);
+    ok = ok && copy == NULL;
+    cJSON_Delete(copy);
+    cJSON_Delete(array);
+    return ok;
+}
+
+static const TestCase deep_tests[] = {
+    { "DP 1: 100000 nested arrays are parsed, printed, duplicated and deleted", test_deep_arrays },
+    { "DP 2: 100000 nested objects are parsed, printed, duplicated and deleted", test_deep_objects },
+    { "DP 3: CJSON_NESTING_LIMIT and the nesting_limit of the context", test_nesting_limit },
+    { "DP 4: Deep trees on a thread with a small stack", test_small_stack },
+    { "DP 5: Duplicating a circular reference fails", test_circular_reference },
+};
+
+void run_all_deep_tests(int* total, int* passed) {
+    printf("--- Running Deep Nesting Tests ---\n");
+    run_test_cases(deep_tests, (int)(sizeof(deep_tests) / sizeof(deep_tests[0])), total, passed);
+    printf("--- Finished Deep Nesting Tests ---\n\n");
+}
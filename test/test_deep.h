@@ -0,0 +1,7 @@
+#ifndef TEST_DEEP_H_
+#define TEST_DEEP_H_
+
+// 深く入れ子になった文書 (解析・印刷・複製・削除が再帰しないこと) のテストスイート宣言
+void run_all_deep_tests(int* total, int* passed);
+
+#endif // TEST_DEEP_H_
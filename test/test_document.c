@@ -0,0 +1,202 @@
+#include "test_document.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON_Document.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_Document のテスト ---
+// 読み取り専用のテープ表現と、それを mmap で読み込むスナップショット。
+
+static const char* sample = "{\"a\":[1,2.5,-3e2,true,false,null,\"x\\u00e9y\\n\"],\"b\":{},\"c\":[],"
+    "\"d\":{\"e\":{\"f\":[[[]]]}},\"A\":9223372036854775807,\"z\":\"tab\\tin\"}";
+
+// テスト中に作るスナップショットのファイル
+static const char* snapshot_path = "test_document_snapshot.tmp";
+
+// 文書を木に戻して、期待する木と比べる
+static int document_equals(const cJSON_Document* document, const cJSON* expected) {
+    cJSON* tree = cJSON_DocumentToTree(document, 0);
+    int ok = tree != NULL && cJSON_Compare(expected, tree, 1);
+    cJSON_Delete(tree);
+    return ok;
+}
+
+static int test_parse_and_convert(void) {
+    static const char* documents[] = { "123", "\"s\"", "[]", "{}", "null", "[[1,[2]],{\"k\":{}}]" };
+    cJSON* expected = cJSON_Parse(sample);
+    cJSON_Document* parsed = cJSON_DocumentParse(sample, strlen(sample));
+    cJSON_Document* converted = cJSON_DocumentFromTree(expected);
+    int ok = parsed != NULL && converted != NULL && document_equals(parsed, expected) && document_equals(converted, expected);
+    cJSON_DocumentDelete(parsed);
+    cJSON_DocumentDelete(converted);
+    cJSON_Delete(expected);
+    for (size_t i = 0; ok && i < sizeof(documents) / sizeof(documents[0]); i++) {
+        expected = cJSON_Parse(documents[i]);
+        parsed = cJSON_DocumentParse(documents[i], strlen(documents[i]));
+        ok = parsed != NULL && document_equals(parsed, expected);
+        cJSON_DocumentDelete(parsed);
+        cJSON_Delete(expected);
+    }
+    return ok;
+}
+
+static int test_invalid_documents(void) {
+    return cJSON_DocumentParse("[1,]", 4) == NULL && cJSON_DocumentParse("{\"a\" 1}", 7) == NULL
+        && cJSON_DocumentParse("[1,2", 4) == NULL && cJSON_DocumentParse(NULL, 0) == NULL
+        && cJSON_DocumentFromTree(NULL) == NULL;
+}
+
+static int test_accessors(void) {
+    cJSON_Document* document = cJSON_DocumentParse(sample, strlen(sample));
+    size_t array = cJSON_DocumentGetObjectItem(document, 0, "a");
+    size_t string = cJSON_DocumentGetObjectItemCaseSensitive(document, 0, "z");
+    size_t big = cJSON_DocumentGetObjectItemCaseSensitive(document, 0, "A");
+    int ok = document != NULL
+        && cJSON_DocumentGetType(document, 0) == cJSON_Object
+        && cJSON_DocumentGetArraySize(document, 0) == 6
+        && cJSON_DocumentGetArraySize(document, array) == 7
+        && strcmp(cJSON_DocumentGetKey(document, array), "a") == 0
+        && cJSON_DocumentGetKey(document, 0) == NULL
+        && cJSON_DocumentGetNumberValue(document, cJSON_DocumentGetArrayItem(document, array, 1)) == 2.5
+        && cJSON_DocumentGetType(document, cJSON_DocumentGetArrayItem(document, array, 3)) == cJSON_True
+        && cJSON_DocumentGetArrayItem(document, array, 7) == CJSON_DOCUMENT_NONE
+        && cJSON_DocumentGetType(document, CJSON_DOCUMENT_NONE) == cJSON_Invalid
+        && isnan(cJSON_DocumentGetNumberValue(document, array))
+        && strcmp(cJSON_DocumentGetStringValue(document, cJSON_DocumentGetArrayItem(document, array, 6)), "x\xC3\xA9y\n") == 0
+        // 復号した後の長さ
+        && cJSON_DocumentGetStringLength(document, string) == 6
+        && strcmp(cJSON_DocumentGetStringValue(document, string), "tab\tin") == 0
+        // 大文字小文字を区別しない検索では、最初に一致したメンバー
+        && cJSON_DocumentGetObjectItem(document, 0, "A") == array
+        && cJSON_DocumentGetObjectItem(document, 0, "missing") == CJSON_DOCUMENT_NONE
+        && (cJSON_DocumentGetType(document, big) & cJSON_IsInt64)
+        && cJSON_DocumentGetInt64Value(document, big) == 9223372036854775807LL
+        && cJSON_DocumentGetInt64Value(document, cJSON_DocumentGetArrayItem(document, array, 1)) == 0;
+    cJSON_DocumentDelete(document);
+    return ok;
+}
+
+static int test_iteration(void) {
+    const char* json = "{\"x\":[1,[2,3],{\"y\":4}],\"w\":5}";
+    cJSON_Document* document = cJSON_DocumentParse(json, strlen(json));
+    size_t array = cJSON_DocumentGetObjectItem(document, 0, "x");
+    size_t element = 0;
+    double sum = 0;
+    int count = 0;
+    // 入れ子の部分木を飛ばして兄弟をたどる
+    cJSON_DocumentArrayForEach(element, document, array) {
+        count++;
+        sum += cJSON_DocumentGetArraySize(document, element);
+    }
+    int ok = count == 3 && sum == 3;
+    count = 0;
+    cJSON_DocumentArrayForEach(element, document, 0) {
+        count++;
+    }
+    ok = ok && count == 2
+        && cJSON_DocumentGetChild(document, cJSON_DocumentGetObjectItem(document, 0, "w")) == CJSON_DOCUMENT_NONE;
+    cJSON_DocumentDelete(document);
+    return ok;
+}
+
+static int test_snapshots(void) {
+    cJSON* tree = cJSON_Parse(sample);
+    cJSON_Document* document = NULL;
+    cJSON_Document* again = NULL;
+    char key[32];
+    int ok = cJSON_SaveSnapshot(tree, snapshot_path);
+    document = cJSON_MapSnapshot(snapshot_path);
+    ok = ok && document != NULL && document_equals(document, tree)
+        && cJSON_DocumentGetStringLength(document, cJSON_DocumentGetObjectItem(document, 0, "z")) == 6;
+    cJSON_DocumentDelete(document);
+    cJSON_Delete(tree);
+
+    // ハッシュ表を持つ大きなオブジェクト
+    tree = cJSON_CreateObject();
+    for (int i = 0; i < 200; i++) {
+        sprintf(key, "Key%d", i);
+        cJSON_AddNumberToObject(tree, key, i);
+    }
+    document = cJSON_DocumentFromTree(tree);
+    ok = ok && cJSON_DocumentSaveSnapshot(document, snapshot_path);
+    cJSON_DocumentDelete(document);
+    document = cJSON_MapSnapshot(snapshot_path);
+    ok = ok && document != NULL && document_equals(document, tree)
+        && cJSON_DocumentGetNumberValue(document, cJSON_DocumentGetObjectItemCaseSensitive(document, 0, "Key150")) == 150
+        && cJSON_DocumentGetNumberValue(document, cJSON_DocumentGetObjectItem(document, 0, "key77")) == 77
+        && cJSON_DocumentGetObjectItemCaseSensitive(document, 0, "key77") == CJSON_DOCUMENT_NONE
+        && cJSON_DocumentGetObjectItem(document, 0, "Key200") == CJSON_DOCUMENT_NONE;
+
+    // 読み込んだスナップショットを上書きしても、読み込み済みの文書は有効なまま
+    ok = ok && cJSON_DocumentSaveSnapshot(document, snapshot_path);
+    again = cJSON_MapSnapshot(snapshot_path);
+    ok = ok && again != NULL && document_equals(document, tree) && document_equals(again, tree);
+    cJSON_DocumentDelete(again);
+    cJSON_DocumentDelete(document);
+    cJSON_Delete(tree);
+    remove(snapshot_path);
+    return ok;
+}
+
+// ファイルの offset のバイトを書き換える (offset が負ならファイルを切り詰める)
+static int damage_file(const char* path, long offset) {
+    FILE* file = fopen(path, "rb");
+    long length = 0;
+    char* content = NULL;
+    if (file == NULL) {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    content = (char*)malloc((size_t)length);
+    if (fread(content, 1, (size_t)length, file) != (size_t)length) {
+        length = 0;
+    }
+    fclose(file);
+    if (offset >= 0) {
+        content[offset % length] ^= 0x10;
+    } else {
+        length += offset;
+    }
+    file = fopen(path, "wb");
+    fwrite(content, 1, (size_t)length, file);
+    fclose(file);
+    free(content);
+    return length > 0;
+}
+
+static int test_damaged_snapshots(void) {
+    cJSON* tree = cJSON_Parse(sample);
+    // 壊れたファイルはチェックサムや長さの検査で拒否される
+    int ok = cJSON_SaveSnapshot(tree, snapshot_path) && damage_file(snapshot_path, 100)
+        && cJSON_MapSnapshot(snapshot_path) == NULL;
+    ok = ok && cJSON_SaveSnapshot(tree, snapshot_path) && damage_file(snapshot_path, -8)
+        && cJSON_MapSnapshot(snapshot_path) == NULL;
+    // ヘッダ (版) の破損
+    ok = ok && cJSON_SaveSnapshot(tree, snapshot_path) && damage_file(snapshot_path, 8)
+        && cJSON_MapSnapshot(snapshot_path) == NULL;
+    remove(snapshot_path);
+    ok = ok && cJSON_MapSnapshot(snapshot_path) == NULL
+        && !cJSON_SaveSnapshot(tree, "no_such_directory/snapshot");
+    cJSON_Delete(tree);
+    return ok;
+}
+
+static const TestCase document_tests[] = {
+    { "DOC 1: Parsing and converting trees", test_parse_and_convert },
+    { "DOC 2: Invalid documents", test_invalid_documents },
+    { "DOC 3: Accessors", test_accessors },
+    { "DOC 4: Iterating over containers", test_iteration },
+    { "DOC 5: Saving and mapping snapshots", test_snapshots },
+    { "DOC 6: Damaged and missing snapshots", test_damaged_snapshots },
+};
+
+void run_all_document_tests(int* total, int* passed) {
+    printf("--- Running cJSON_Document Tests ---\n");
+    run_test_cases(document_tests, (int)(sizeof(document_tests) / sizeof(document_tests[0])), total, passed);
+    printf("--- Finished cJSON_Document Tests ---\n\n");
+}
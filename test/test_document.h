@@ -0,0 +1,7 @@
+#ifndef TEST_DOCUMENT_H_
+#define TEST_DOCUMENT_H_
+
+// cJSON_Document とスナップショットのテストスイート宣言
+void run_all_document_tests(int* total, int* passed);
+
+#endif // TEST_DOCUMENT_H_
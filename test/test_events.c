@@ -0,0 +1,162 @@
+#include "test_events.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_ParseEvents のテスト ---
+// 木を作らずに、文書をコールバックへ順に報告する。
+
+// イベントから JSON テキストを組み立て直すハンドラの状態
+typedef struct {
+    char text[4096];
+    size_t length;
+    int needs_comma[64]; // 深さごとに、次の要素の前に ',' が要るか
+    int depth;
+    int after_key;
+    int abort_at; // この数のイベントで中断する (0 なら中断しない)
+    int events;
+} Rebuilder;
+
+static void append(Rebuilder* r, const char* text) {
+    size_t length = strlen(text);
+    if (r->length + length < sizeof(r->text)) {
+        memcpy(r->text + r->length, text, length + 1);
+        r->length += length;
+    }
+}
+
+// 値やキーの前の ','
+static void separate(Rebuilder* r) {
+    if (r->after_key) {
+        r->after_key = 0;
+        return;
+    }
+    if (r->depth > 0 && r->needs_comma[r->depth]) {
+        append(r, ",");
+    }
+    r->needs_comma[r->depth] = 1;
+}
+
+static cJSON_bool event(Rebuilder* r) {
+    r->events++;
+    return r->events != r->abort_at;
+}
+
+static cJSON_bool open_container(Rebuilder* r, const char* bracket) {
+    separate(r);
+    append(r, bracket);
+    r->needs_comma[++r->depth] = 0;
+    return event(r);
+}
+
+static cJSON_bool close_container(Rebuilder* r, const char* bracket) {
+    append(r, bracket);
+    r->depth--;
+    return event(r);
+}
+
+static cJSON_bool on_start_object(void* context) { return open_container((Rebuilder*)context, "{"); }
+static cJSON_bool on_end_object(void* context) { return close_container((Rebuilder*)context, "}"); }
+static cJSON_bool on_start_array(void* context) { return open_container((Rebuilder*)context, "["); }
+static cJSON_bool on_end_array(void* context) { return close_container((Rebuilder*)context, "]"); }
+
+static cJSON_bool on_key(void* context, const char* key) {
+    Rebuilder* r = (Rebuilder*)context;
+    cJSON* string = cJSON_CreateString(key);
+    char* printed = cJSON_PrintUnformatted(string);
+    separate(r);
+    append(r, printed);
+    append(r, ":");
+    r->after_key = 1;
+    cJSON_free(printed);
+    cJSON_Delete(string);
+    return event(r);
+}
+
+static cJSON_bool on_value(void* context, const cJSON* value) {
+    Rebuilder* r = (Rebuilder*)context;
+    char* printed = cJSON_PrintUnformatted(value);
+    // 値は一時的な要素で、キーを持たない
+    int ok = printed != NULL && value->string == NULL;
+    separate(r);
+    append(r, printed != NULL ? printed : "?");
+    cJSON_free(printed);
+    return ok && event(r);
+}
+
+static const cJSON_EventHandler rebuilding_handler = { on_start_object, on_end_object, on_start_array, on_end_array, on_key, on_value };
+
+// イベントから組み立て直したテキストが cJSON_PrintUnformatted と一致するか
+static int rebuilds(const char* json) {
+    Rebuilder r;
+    cJSON* tree = cJSON_Parse(json);
+    char* expected = cJSON_PrintUnformatted(tree);
+    int ok = 0;
+    memset(&r, 0, sizeof(r));
+    ok = expected != NULL && cJSON_ParseEvents(json, strlen(json), &rebuilding_handler, &r) && strcmp(expected, r.text) == 0;
+    if (!ok) {
+        printf("    %s\n    %s\n", expected != NULL ? expected : "NULL", r.text);
+    }
+    cJSON_free(expected);
+    cJSON_Delete(tree);
+    return ok;
+}
+
+static int test_events_rebuild_the_document(void) {
+    return rebuilds("{\"a\":[1,2,{\"x\":\"hello\\n\",\"y\":null}],\"b\":true,\"c\":-1.5e-3,\"d\":{},\"e\":[]}")
+        && rebuilds("[[[],[{}]],\"s\",false]") && rebuilds("\"top\"") && rebuilds("42")
+        && rebuilds("{\"\\u00e9\":\"\\ud83d\\ude00\",\"n\":9223372036854775807}");
+}
+
+static int test_long_strings(void) {
+    char json[1200];
+    size_t length = 0;
+    // 一時領域より長い文字列
+    memcpy(json, "{\"k\":\"", 6);
+    length = 6;
+    for (int i = 0; i < 1000; i++) {
+        json[length++] = (char)('a' + i % 26);
+    }
+    memcpy(json + length, "\",\"k2\":\"x\"}", sizeof("\",\"k2\":\"x\"}"));
+    return rebuilds(json);
+}
+
+static int test_callback_aborts(void) {
+    Rebuilder r;
+    const char* json = "{\"a\":[1,2],\"b\":3}";
+    memset(&r, 0, sizeof(r));
+    r.abort_at = 3;
+    // false を返したコールバックで解析は止まり、それ以降のイベントは来ない
+    return !cJSON_ParseEvents(json, strlen(json), &rebuilding_handler, &r) && r.events == 3 && cJSON_GetErrorPtr() != NULL;
+}
+
+static int test_null_callbacks_and_errors(void) {
+    cJSON_EventHandler none;
+    char deep[2001];
+    memset(&none, 0, sizeof(none));
+    memset(deep, '[', 2000);
+    deep[2000] = '\0';
+    return cJSON_ParseEvents("{\"a\":[1,{}]}", 12, &none, NULL)
+        && !cJSON_ParseEvents("[1,2", 4, &none, NULL)
+        && !cJSON_ParseEvents("{\"a\" 1}", 7, &none, NULL)
+        // cJSON_Parse と同じく、値の後ろの文字は読まない
+        && cJSON_ParseEvents("[1]x", 4, &none, NULL)
+        // 入れ子の深さの上限
+        && !cJSON_ParseEvents(deep, 2000, &none, NULL);
+}
+
+static const TestCase events_tests[] = {
+    { "EV 1: Events rebuild the document", test_events_rebuild_the_document },
+    { "EV 2: Strings longer than the scratch space", test_long_strings },
+    { "EV 3: A callback returning false aborts parsing", test_callback_aborts },
+    { "EV 4: NULL callbacks and invalid documents", test_null_callbacks_and_errors },
+};
+
+void run_all_events_tests(int* total, int* passed) {
+    printf("--- Running cJSON_ParseEvents Tests ---\n");
+    run_test_cases(events_tests, (int)(sizeof(events_tests) / sizeof(events_tests[0])), total, passed);
+    printf("--- Finished cJSON_ParseEvents Tests ---\n\n");
+}
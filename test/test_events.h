@@ -0,0 +1,7 @@
+#ifndef TEST_EVENTS_H_
+#define TEST_EVENTS_H_
+
+// イベント解析 (cJSON_ParseEvents) のテストスイート宣言
+void run_all_events_tests(int* total, int* passed);
+
+#endif // TEST_EVENTS_H_
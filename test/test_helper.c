@@ -244,3 +244,17 @@ cJSON_bool compare_patch_arrays(cJSON* actual, cJSON* expected) {
     return cJSON_True;
 }
 
+// --- テーブル駆動テスト用ヘルパー ---
+
+void run_test_cases(const TestCase* cases, int count, int* total, int* passed) {
+    for (int i = 0; i < count; ++i) {
+        printf("Running test: %s\n", cases[i].description);
+        (*total)++;
+        int success = cases[i].run();
+        if (success) {
+            (*passed)++;
+        }
+        printf("  Result: %s\n", success ? "PASS" : "FAIL");
+        printf("---\n");
+    }
+}
@@ -35,5 +35,15 @@ cJSON* create_expected_patch(const char* op, const char* final_patch_path, const
 // 実際のパッチ配列と期待されるパッチ配列を比較する (Deep Comparison)
 cJSON_bool compare_patch_arrays(cJSON* actual, cJSON* expected);
 
+// --- テーブル駆動テスト用ヘルパー ---
+// 1 件のテストケース: 説明と、成功なら 1 を返す実行関数
+typedef struct {
+    const char* description;
+    int (*run)(void);
+} TestCase;
+
+// テーブルの全テストケースを実行し、total/passed を更新する
+void run_test_cases(const TestCase* cases, int count, int* total, int* passed);
+
 
 #endif // TEST_HELPER_H_
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include "test_index.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// --- cJSON_BuildIndex のテスト ---
+// 子を CJSON_INDEX_THRESHOLD 個以上たどった検索が索引を作る。索引は各オブジェクト・配列が自分で持つ。
+// 追加/削除/挿入/置換は索引を更新し、手で繋ぎ替えた子は検索側で検出して線形探索に戻る。
+
+#define INDEX_TEST_COUNT 1000
+
+static cJSON* create_numbered_object(const char* prefix, int count) {
+    cJSON* object = cJSON_CreateObject();
+    char key[32];
+    for (int i = 0; i < count; ++i) {
+        sprintf(key, "%s%d", prefix, i);
+        cJSON_AddNumberToObject(object, key, i);
+    }
+    return object;
+}
+
+static cJSON* create_numbered_array(int count) {
+    cJSON* array = cJSON_CreateArray();
+    for (int i = 0; i < count; ++i) {
+        cJSON_AddItemToArray(array, cJSON_CreateNumber(i));
+    }
+    return array;
+}
+
+static int test_lookup_builds_index(void) {
+    cJSON* small = create_numbered_object("k", CJSON_INDEX_THRESHOLD);
+    cJSON* object = create_numbered_object("k", INDEX_TEST_COUNT);
+    cJSON* array = create_numbered_array(INDEX_TEST_COUNT);
+    cJSON* sized = create_numbered_array(INDEX_TEST_COUNT);
+    int ok = cJSON_GetObjectItem(small, "k0") != NULL && !(small->type & cJSON_IsIndexed)
+        // 短い検索では索引を作らない
+        && cJSON_GetObjectItem(object, "k1") != NULL && !(object->type & cJSON_IsIndexed)
+        && cJSON_GetArrayItem(array, 1) != NULL && !(array->type & cJSON_IsIndexed)
+        // 長い検索の後は索引がある
+        && cJSON_GetObjectItem(object, "K999")->valueint == 999 && (object->type & cJSON_IsIndexed)
+        && cJSON_GetArrayItem(array, INDEX_TEST_COUNT - 1)->valueint == INDEX_TEST_COUNT - 1
+        && (array->type & cJSON_IsIndexed)
+        && cJSON_GetArraySize(sized) == INDEX_TEST_COUNT && (sized->type & cJSON_IsIndexed);
+    // 索引を使った検索も同じ結果を返す
+    for (int i = 0; ok && i < cJSON_GetArraySize(sized); ++i) {
+        char key[32];
+        sprintf(key, "k%d", i);
+        ok = cJSON_GetArrayItem(sized, i)->valueint == i && cJSON_GetArrayItem(array, i)->valueint == i
+            && cJSON_GetObjectItemCaseSensitive(object, key)->valueint == i;
+    }
+    ok = ok && cJSON_GetObjectItem(object, "missing") == NULL && cJSON_GetArrayItem(array, INDEX_TEST_COUNT) == NULL;
+    cJSON_Delete(small);
+    cJSON_Delete(object);
+    cJSON_Delete(array);
+    cJSON_Delete(sized);
+    return ok;
+}
+
+static int test_object_lookup(void) {
+    cJSON* object = create_numbered_object("Key", INDEX_TEST_COUNT);
+    char key[32];
+    int ok = cJSON_BuildIndex(object) && (object->type & cJSON_IsIndexed);
+    for (int i = 0; ok && i < INDEX_TEST_COUNT; ++i) {
+        sprintf(key, "key%d", i);
+        cJSON* item = cJSON_GetObjectItem(object, key);
+        ok = item != NULL && item->valueint == i
+            && cJSON_GetObjectItemCaseSensitive(object, key) == NULL;
+    }
+    ok = ok && cJSON_GetObjectItem(object, "missing") == NULL;
+    cJSON_Delete(object);
+    return ok;
+}
+
+static int test_object_mutations(void) {
+    cJSON* object = create_numbered_object("k", INDEX_TEST_COUNT);
+    char key[32];
+    int ok = cJSON_BuildIndex(object);
+    for (int i = 0; i < INDEX_TEST_COUNT; i += 2) {
+        sprintf(key, "k%d", i);
+        cJSON_DeleteItemFromObjectCaseSensitive(object, key);
+    }
+    for (int i = 0; ok && i < INDEX_TEST_COUNT; ++i) {
+        sprintf(key, "k%d", i);
+        cJSON* item = cJSON_GetObjectItem(object, key);
+        ok = (i % 2) ? (item != NULL && item->valueint == i) : (item == NULL);
+    }
+    cJSON_ReplaceItemInObject(object, "k9", cJSON_CreateString("nine"));
+    cJSON_AddNumberToObject(object, "added", -1);
+    ok = ok && cJSON_IsString(cJSON_GetObjectItem(object, "k9"))
+        && cJSON_GetObjectItem(object, "added")->valueint == -1
+        && (object->type & cJSON_IsIndexed);
+    cJSON_Delete(object);
+    return ok;
+}
+
+static int test_object_duplicate_names(void) {
+    cJSON* object = create_numbered_object("k", INDEX_TEST_COUNT);
+    int ok = cJSON_BuildIndex(object);
+    // 大文字小文字違いの重複は後ろに追加される。大文字小文字を無視する検索は先頭の子を返す
+    cJSON_AddNumberToObject(object, "K11", -1);
+    ok = ok && cJSON_GetObjectItem(object, "k11")->valueint == 11
+        && cJSON_GetObjectItemCaseSensitive(object, "K11")->valueint == -1;
+    cJSON_Delete(object);
+    return ok;
+}
+
+static int test_object_relinked_by_hand(void) {
+    cJSON* object = create_numbered_object("k", INDEX_TEST_COUNT);
+    int ok = cJSON_BuildIndex(object);
+    // 索引を通さずに子を外す: 両端は変わらないが、検索は外れた子を返してはならない
+    cJSON* item = cJSON_GetObjectItem(object, "k13");
+    item->prev->next = item->next;
+    item->next->prev = item->prev;
+    ok = ok && cJSON_GetObjectItem(object, "k13") == NULL
+        && cJSON_GetObjectItem(object, "k14")->valueint == 14;
+    cJSON_InvalidateIndex(object);
+    ok = ok && !(object->type & cJSON_IsIndexed);
+    item->next = item->prev = NULL;
+    cJSON_Delete(item);
+    cJSON_Delete(object);
+    return ok;
+}
+
+static int test_array_mutations(void) {
+    cJSON* array = create_numbered_array(INDEX_TEST_COUNT);
+    int ok = cJSON_BuildIndex(array) && (array->type & cJSON_IsIndexed);
+    cJSON_InsertItemInArray(array, 5, cJSON_CreateNumber(-5));
+    ok = ok && cJSON_GetArrayItem(array, 5)->valueint == -5
+        && cJSON_GetArrayItem(array, 6)->valueint == 5
+        && cJSON_GetArraySize(array) == INDEX_TEST_COUNT + 1;
+    cJSON_DeleteItemFromArray(array, 0);
+    cJSON_ReplaceItemInArray(array, 100, cJSON_CreateString("x"));
+    ok = ok && cJSON_GetArrayItem(array, 0)->valueint == 1
+        && cJSON_IsString(cJSON_GetArrayItem(array, 100))
+        && cJSON_GetArrayItem(array, INDEX_TEST_COUNT) == NULL;
+    // 索引の結果は子の連結と一致する
+    int i = 0;
+    for (cJSON* child = array->child; ok && child != NULL; child = child->next) {
+        ok = cJSON_GetArrayItem(array, i++) == child;
+    }
+    ok = ok && i == cJSON_GetArraySize(array);
+    cJSON_Delete(array);
+    return ok;
+}
+
+static int test_array_relinked_by_hand(void) {
+    cJSON* array = create_numbered_array(INDEX_TEST_COUNT);
+    int ok = cJSON_BuildIndex(array);
+    cJSON* item = cJSON_GetArrayItem(array, 10);
+    item->prev->next = item->next;
+    item->next->prev = item->prev;
+    // 古い索引の 10 番目は外れた子。検索は線形探索に戻る
+    ok = ok && cJSON_GetArrayItem(array, 10)->valueint == 11;
+    item->next = item->prev = NULL;
+    cJSON_Delete(item);
+    cJSON_Delete(array);
+    return ok;
+}
+
+static int test_build_index_rejects(void) {
+    cJSON* empty = cJSON_CreateObject();
+    cJSON* number = cJSON_CreateNumber(1);
+    cJSON* unnamed = cJSON_CreateObject();
+    cJSON_AddItemToArray(unnamed, cJSON_CreateNumber(1));
+    int ok = !cJSON_BuildIndex(NULL) && !cJSON_BuildIndex(empty)
+        && !cJSON_BuildIndex(number) && !cJSON_BuildIndex(unnamed);
+    cJSON_Delete(empty);
+    cJSON_Delete(number);
+    cJSON_Delete(unnamed);
+    return ok;
+}
+
+static int test_arena_index(void) {
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    const char* json = "{\"a\":1,\"b\":[1,2,3],\"c\":3}";
+    cJSON* object = cJSON_ParseWithArena(json, strlen(json), arena);
+    cJSON* array = cJSON_GetObjectItem(object, "b");
+    int ok = cJSON_BuildIndex(object) && cJSON_BuildIndex(array)
+        && cJSON_GetObjectItem(object, "c")->valueint == 3
+        && cJSON_GetArrayItem(array, 2)->valueint == 3;
+    // 索引はアリーナと一緒に解放される
+    cJSON_ArenaFree(arena);
+    return ok;
+}
+
+static int test_duplicate_is_not_indexed(void) {
+    cJSON* object = create_numbered_object("k", 100);
+    int ok = cJSON_BuildIndex(object);
+    cJSON* copy = cJSON_Duplicate(object, 1);
+    ok = ok && copy != NULL && !(copy->type & cJSON_IsIndexed)
+        && cJSON_Compare(object, copy, 1);
+    cJSON_Delete(copy);
+    cJSON_Delete(object);
+    return ok;
+}
+
+static int test_shared_copies(void) {
+    cJSON* object = create_numbered_object("k", INDEX_TEST_COUNT);
+    cJSON* copy = NULL;
+    int ok = cJSON_BuildIndex(object);
+    // 共有コピーを作ると索引は捨てられ、それぞれの木が検索で自分の索引を作る
+    copy = cJSON_DuplicateShared(object);
+    ok = ok && copy != NULL && !(object->type & cJSON_IsIndexed)
+        && cJSON_GetObjectItem(object, "k999")->valueint == 999 && (object->type & cJSON_IsIndexed)
+        && cJSON_GetObjectItem(copy, "k999")->valueint == 999 && (copy->type & cJSON_IsIndexed)
+        && cJSON_GetObjectItem(object, "k999") != cJSON_GetObjectItem(copy, "k999");
+    cJSON_DeleteItemFromObject(object, "k999");
+    ok = ok && cJSON_GetObjectItem(object, "k999") == NULL && cJSON_GetObjectItem(copy, "k999") != NULL;
+    cJSON_Delete(object);
+    ok = ok && cJSON_GetObjectItem(copy, "k500")->valueint == 500;
+    cJSON_Delete(copy);
+    return ok;
+}
+
+static const TestCase index_tests[] = {
+    { "IX 1: Long lookups build an index", test_lookup_builds_index },
+    { "IX 2: Indexed object lookup, case insensitive and sensitive", test_object_lookup },
+    { "IX 3: Indexed object after delete/replace/add", test_object_mutations },
+    { "IX 4: Duplicate names fall back to list order", test_object_duplicate_names },
+    { "IX 5: Object child unlinked by hand is not returned", test_object_relinked_by_hand },
+    { "IX 6: Indexed array after insert/delete/replace", test_array_mutations },
+    { "IX 7: Array child unlinked by hand is not returned", test_array_relinked_by_hand },
+    { "IX 8: cJSON_BuildIndex rejects what it cannot index", test_build_index_rejects },
+    { "IX 9: Index of arena items is freed with the arena", test_arena_index },
+    { "IX 10: Duplicates do not inherit the index", test_duplicate_is_not_indexed },
+    { "IX 11: Shared copies index their own children", test_shared_copies },
+};
+
+void run_all_index_tests(int* total, int* passed) {
+    printf("--- Running cJSON_BuildIndex Tests ---\n");
+    run_test_cases(index_tests, (int)(sizeof(index_tests) / sizeof(index_tests[0])), total, passed);
+    printf("--- Finished cJSON_BuildIndex Tests ---\n\n");
+}
@@ -0,0 +1,7 @@
+#ifndef TEST_INDEX_H_
+#define TEST_INDEX_H_
+
+// cJSON_BuildIndex (オブジェクトのハッシュ索引と配列の子ベクタ) のテストスイート宣言
+void run_all_index_tests(int* total, int* passed);
+
+#endif // TEST_INDEX_H_
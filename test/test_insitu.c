@@ -0,0 +1,107 @@
+#include "test_insitu.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// --- cJSON_ParseInSitu のテスト ---
+// 文字列とキーを入力バッファの中で復号し、バッファはアリーナが引き取る。
+
+// cJSON_malloc で確保した終端なしのコピー
+static char* copy_of(const char* json, size_t* length) {
+    *length = strlen(json);
+    char* copy = (char*)cJSON_malloc(*length);
+    memcpy(copy, json, *length);
+    return copy;
+}
+
+// その場解析と cJSON_Parse の結果が一致するか
+static int same_as_parse(const char* json) {
+    size_t length = 0;
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    cJSON* expected = cJSON_Parse(json);
+    char* buffer = copy_of(json, &length);
+    cJSON* root = cJSON_ParseInSitu(buffer, length, arena);
+    int ok = (expected == NULL) == (root == NULL);
+    if (ok && expected != NULL) {
+        ok = cJSON_Compare(expected, root, 1);
+    }
+    if (!ok) {
+        printf("    mismatch: %s\n", json);
+    }
+    cJSON_Delete(expected);
+    cJSON_ArenaFree(arena);
+    return ok;
+}
+
+static int test_same_as_parse(void) {
+    return same_as_parse("{\"a\":[1,2.5,-3e2,true,false,null,\"x\\u00e9\\ud83d\\ude00y\\n\"],\"b\":{},\"c\":[],"
+                         "\"d\":{\"e\":{\"f\":[[[]]]}},\"k\\\"q\":\"\\\\\\/\\b\\f\\r\\t\",\"\":\"\"}")
+        // 復号すると長さが変わるエスケープ
+        && same_as_parse("\"\\ud83d\\ude00\\ud83d\\ude00\\u0041\"")
+        && same_as_parse("\"plain\"") && same_as_parse("[\"a\",\"bb\",\"\\\"\"]") && same_as_parse("  {\"k\" : \"v\"}  ")
+        && same_as_parse("[1,\"x\"") && same_as_parse("{\"a\":\"\\u12\"}") && same_as_parse("\"abc");
+}
+
+static int test_strings_point_into_buffer(void) {
+    size_t length = 0;
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    char* buffer = copy_of("{\"key\":\"value\",\"esc\\n\":[\"a\\tb\"]}", &length);
+    cJSON* root = cJSON_ParseInSitu(buffer, length, arena);
+    cJSON* escaped = cJSON_GetObjectItem(root, "esc\n");
+    int ok = root != NULL && escaped != NULL
+        && root->child->string >= buffer && root->child->string < buffer + length
+        && root->child->valuestring >= buffer && root->child->valuestring < buffer + length
+        && strcmp(root->child->valuestring, "value") == 0
+        && escaped->string >= buffer && escaped->string < buffer + length
+        && strcmp(escaped->child->valuestring, "a\tb") == 0;
+    cJSON* copy = cJSON_Duplicate(root, 1);
+    cJSON_ArenaFree(arena);
+    // 複製はバッファを参照しない
+    char* printed = cJSON_PrintUnformatted(copy);
+    ok = ok && printed != NULL && strcmp(printed, "{\"key\":\"value\",\"esc\\n\":[\"a\\tb\"]}") == 0;
+    cJSON_free(printed);
+    cJSON_Delete(copy);
+    return ok;
+}
+
+static int test_set_valuestring(void) {
+    size_t length = 0;
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    char* buffer = copy_of("[\"abc\",\"de\"]", &length);
+    cJSON* root = cJSON_ParseInSitu(buffer, length, arena);
+    // 短い文字列はその場で、長い文字列は新しく確保して置き換える
+    int ok = root != NULL && cJSON_SetValuestring(root->child, "xy") != NULL && strcmp(root->child->valuestring, "xy") == 0
+        && cJSON_SetValuestring(root->child, "longer string") != NULL;
+    char* printed = cJSON_PrintUnformatted(root);
+    ok = ok && printed != NULL && strcmp(printed, "[\"longer string\",\"de\"]") == 0;
+    cJSON_free(printed);
+    cJSON_ArenaFree(arena);
+    return ok;
+}
+
+static int test_buffer_ownership(void) {
+    size_t length = 0;
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    char* truncated = copy_of("[1,2", &length);
+    // 失敗しても、アリーナがなくても、バッファは解放される (リークは ASan で検出する)
+    int ok = cJSON_ParseInSitu(truncated, length, arena) == NULL;
+    char* without_arena = copy_of("[1]", &length);
+    ok = ok && cJSON_ParseInSitu(without_arena, length, NULL) == NULL && cJSON_ParseInSitu(NULL, 0, arena) == NULL;
+    cJSON_ArenaFree(arena);
+    return ok;
+}
+
+static const TestCase insitu_tests[] = {
+    { "IS 1: The same tree as cJSON_Parse", test_same_as_parse },
+    { "IS 2: Strings and keys point into the buffer", test_strings_point_into_buffer },
+    { "IS 3: Replacing an in-situ string", test_set_valuestring },
+    { "IS 4: The arena owns the buffer, also on failure", test_buffer_ownership },
+};
+
+void run_all_insitu_tests(int* total, int* passed) {
+    printf("--- Running cJSON_ParseInSitu Tests ---\n");
+    run_test_cases(insitu_tests, (int)(sizeof(insitu_tests) / sizeof(insitu_tests[0])), total, passed);
+    printf("--- Finished cJSON_ParseInSitu Tests ---\n\n");
+}
@@ -0,0 +1,7 @@
+#ifndef TEST_INSITU_H_
+#define TEST_INSITU_H_
+
+// その場解析 (cJSON_ParseInSitu) のテストスイート宣言
+void run_all_insitu_tests(int* total, int* passed);
+
+#endif // TEST_INSITU_H_
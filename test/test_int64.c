@@ -0,0 +1,150 @@
+#include "test_int64.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- 64 ビット整数のテスト ---
+// 2^53 を超える整数は valuedouble では丸められる。正確な値は cJSON 構造体を大きくせずに保持される。
+
+// 元の cJSON 構造体と同じメンバ
+typedef struct baseline_cJSON {
+    struct baseline_cJSON *next;
+    struct baseline_cJSON *prev;
+    struct baseline_cJSON *child;
+    int type;
+    char *valuestring;
+    int valueint;
+    double valuedouble;
+    char *string;
+} baseline_cJSON;
+
+// json を解析し、GetInt64Value と出力が期待値と一致するか
+static int parses_exactly(const char* json, cJSON_int64 expected) {
+    cJSON* item = cJSON_Parse(json);
+    char* printed = cJSON_PrintUnformatted(item);
+    int ok = item != NULL && (item->type & cJSON_IsInt64)
+        && cJSON_GetInt64Value(item) == expected
+        && printed != NULL && strcmp(printed, json) == 0;
+    free(printed);
+    cJSON_Delete(item);
+    return ok;
+}
+
+static int test_struct_size(void) {
+    return sizeof(cJSON) == sizeof(baseline_cJSON);
+}
+
+static int test_parse_beyond_2_53(void) {
+    return parses_exactly("9007199254740993", 9007199254740993LL)
+        && parses_exactly("-9007199254740993", -9007199254740993LL)
+        && parses_exactly("1234567890123456789", 1234567890123456789LL);
+}
+
+static int test_parse_limits(void) {
+    return parses_exactly("9223372036854775807", 9223372036854775807LL)
+        && parses_exactly("-9223372036854775808", -9223372036854775807LL - 1)
+        && parses_exactly("0", 0)
+        && parses_exactly("-1", -1);
+}
+
+static int test_not_integral(void) {
+    cJSON* fraction = cJSON_Parse("1.5");
+    cJSON* too_big = cJSON_Parse("9223372036854775808");
+    int ok = fraction != NULL && !(fraction->type & cJSON_IsInt64)
+        && cJSON_GetInt64Value(fraction) == 1
+        && too_big != NULL && !(too_big->type & cJSON_IsInt64);
+    cJSON_Delete(fraction);
+    cJSON_Delete(too_big);
+    return ok;
+}
+
+static int test_create_duplicate_compare(void) {
+    cJSON* big = cJSON_CreateInt64(9007199254740993LL);
+    cJSON* copy = cJSON_Duplicate(big, 1);
+    cJSON* neighbour = cJSON_CreateInt64(9007199254740992LL);
+    // double としては等しいが、整数としては異なる
+    int ok = big != NULL && copy != NULL && neighbour != NULL
+        && cJSON_GetInt64Value(copy) == 9007199254740993LL
+        && cJSON_Compare(big, copy, 1)
+        && big->valuedouble == neighbour->valuedouble
+        && !cJSON_Compare(big, neighbour, 1);
+    cJSON_Delete(big);
+    cJSON_Delete(copy);
+    cJSON_Delete(neighbour);
+    return ok;
+}
+
+static int test_set_number_drops_exact_value(void) {
+    cJSON* item = cJSON_CreateInt64(9007199254740993LL);
+    cJSON_SetNumberValue(item, 42);
+    char* printed = cJSON_PrintUnformatted(item);
+    int ok = cJSON_GetInt64Value(item) == 42 && printed != NULL && strcmp(printed, "42") == 0;
+    free(printed);
+    cJSON_Delete(item);
+    return ok;
+}
+
+static int test_arena_parse(void) {
+    const char* json = "[9007199254740993,-9007199254740995]";
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    cJSON* array = cJSON_ParseWithArena(json, strlen(json), arena);
+    char* printed = cJSON_PrintUnformatted(array);
+    int ok = array != NULL && cJSON_GetInt64Value(cJSON_GetArrayItem(array, 1)) == -9007199254740995LL
+        && printed != NULL && strcmp(printed, json) == 0;
+    free(printed);
+    cJSON_ArenaFree(arena);
+    return ok;
+}
+
+static int test_packed_array(void) {
+    const cJSON_int64 numbers[] = { 1, 9007199254740993LL, -9223372036854775807LL - 1 };
+    cJSON* array = cJSON_CreatePackedInt64Array(numbers, 3);
+    char* packed = cJSON_PrintUnformatted(array);
+    // 展開した要素も正確な値を持つ
+    int ok = array != NULL && cJSON_Unshare(array)
+        && cJSON_GetInt64Value(array->child->next) == 9007199254740993LL;
+    char* expanded = cJSON_PrintUnformatted(array);
+    ok = ok && packed != NULL && expanded != NULL && strcmp(packed, expanded) == 0
+        && strcmp(packed, "[1,9007199254740993,-9223372036854775808]") == 0;
+    free(packed);
+    free(expanded);
+    cJSON_Delete(array);
+    return ok;
+}
+
+static cJSON_int64 event_value;
+
+static cJSON_bool record_value(void* context, const cJSON* value) {
+    (void)context;
+    event_value = cJSON_GetInt64Value(value);
+    return 1;
+}
+
+static int test_events(void) {
+    cJSON_EventHandler handler;
+    memset(&handler, 0, sizeof(handler));
+    handler.value = record_value;
+    const char* json = "[18014398509481985]";
+    return cJSON_ParseEvents(json, strlen(json), &handler, NULL) && event_value == 18014398509481985LL;
+}
+
+static const TestCase int64_tests[] = {
+    { "I64 1: sizeof(cJSON) is unchanged", test_struct_size },
+    { "I64 2: Integers beyond 2^53 parse and print exactly", test_parse_beyond_2_53 },
+    { "I64 3: INT64_MIN and INT64_MAX", test_parse_limits },
+    { "I64 4: Fractions and overflow are not cJSON_IsInt64", test_not_integral },
+    { "I64 5: CreateInt64, Duplicate and Compare keep the exact value", test_create_duplicate_compare },
+    { "I64 6: cJSON_SetNumberValue replaces the exact value", test_set_number_drops_exact_value },
+    { "I64 7: Exact values in arena documents", test_arena_parse },
+    { "I64 8: Packed int64 arrays keep exact values when expanded", test_packed_array },
+    { "I64 9: Event parsing reports the exact value", test_events },
+};
+
+void run_all_int64_tests(int* total, int* passed) {
+    printf("--- Running Int64 Tests ---\n");
+    run_test_cases(int64_tests, (int)(sizeof(int64_tests) / sizeof(int64_tests[0])), total, passed);
+    printf("--- Finished Int64 Tests ---\n\n");
+}
@@ -0,0 +1,7 @@
+#ifndef TEST_INT64_H_
+#define TEST_INT64_H_
+
+// 64 ビット整数 (cJSON_IsInt64, cJSON_GetInt64Value, cJSON_CreateInt64) のテストスイート宣言
+void run_all_int64_tests(int* total, int* passed);
+
+#endif // TEST_INT64_H_
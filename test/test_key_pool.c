@@ -0,0 +1,117 @@
+#include "test_key_pool.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_ParseWithKeyPool のテスト ---
+// 同じキーは一度だけ保存され、参照カウントで共有される。
+
+static const char* records = "[{\"id\":1,\"name\":\"a\"},{\"id\":2,\"name\":\"b\"},{\"n\\u00e9\":3}]";
+
+// json を通常の解析と同じ結果に解析できるか
+static int parses_like_cJSON_Parse(const char* json, cJSON_KeyPool* pool) {
+    cJSON* expected = cJSON_Parse(json);
+    cJSON* actual = cJSON_ParseWithKeyPool(json, strlen(json), pool);
+    int ok = expected != NULL && actual != NULL && cJSON_Compare(expected, actual, 1);
+    cJSON_Delete(expected);
+    cJSON_Delete(actual);
+    return ok;
+}
+
+static int test_same_result(void) {
+    cJSON_KeyPool* pool = cJSON_KeyPoolNew();
+    int ok = pool != NULL && parses_like_cJSON_Parse(records, NULL) && parses_like_cJSON_Parse(records, pool)
+        && parses_like_cJSON_Parse("{\"a\":{\"a\":{\"a\":[]}}}", pool);
+    cJSON_KeyPoolFree(pool);
+    return ok;
+}
+
+static int test_keys_are_shared(void) {
+    cJSON_KeyPool* pool = cJSON_KeyPoolNew();
+    cJSON* first = cJSON_ParseWithKeyPool(records, strlen(records), pool);
+    cJSON* second = cJSON_ParseWithKeyPool(records, strlen(records), pool);
+    cJSON* id = cJSON_GetArrayItem(first, 0)->child;
+    int ok = first != NULL && second != NULL && (id->type & cJSON_StringIsInterned)
+        // 文書内でも文書間でも同じキーを指す
+        && id->string == cJSON_GetArrayItem(first, 1)->child->string
+        && id->string == cJSON_GetArrayItem(second, 0)->child->string;
+    cJSON_Delete(first);
+    cJSON_Delete(second);
+    cJSON_KeyPoolFree(pool);
+    return ok;
+}
+
+static int test_keys_outlive_pool(void) {
+    cJSON_KeyPool* pool = cJSON_KeyPoolNew();
+    cJSON* document = cJSON_ParseWithKeyPool(records, strlen(records), pool);
+    // プールを先に解放しても、キーは最後の要素と一緒に解放される
+    cJSON_KeyPoolFree(pool);
+    cJSON* copy = cJSON_Duplicate(document, 1);
+    int ok = document != NULL && copy != NULL && cJSON_Compare(document, copy, 1)
+        && cJSON_GetObjectItem(cJSON_GetArrayItem(copy, 1), "name") != NULL;
+    cJSON_Delete(document);
+    cJSON_Delete(copy);
+    return ok;
+}
+
+static int test_rename_interned_key(void) {
+    cJSON* document = cJSON_ParseWithKeyPool(records, strlen(records), NULL);
+    cJSON* object = cJSON_GetArrayItem(document, 0);
+    cJSON* id = cJSON_DetachItemFromObject(object, "id");
+    cJSON_AddItemToObject(object, "moved", id);
+    char* printed = cJSON_PrintUnformatted(object);
+    int ok = printed != NULL && strcmp(printed, "{\"name\":\"a\",\"moved\":1}") == 0
+        && cJSON_GetObjectItem(cJSON_GetArrayItem(document, 1), "id") != NULL;
+    free(printed);
+    cJSON_Delete(document);
+    return ok;
+}
+
+// 不正なエスケープを含むキーは拒否され、スクラッチメモリを二重に解放しない
+static int test_invalid_escapes_in_keys(void) {
+    const char* invalid[] = {
+        "{\"a\\x\":1}",
+        "{\"a\":1,\"b\\u12\":2}",
+        "{\"a\\uD800\\u0041\":1}",
+        "{\"k\\",
+        "{\"a\":{\"b\\q\":[]}}",
+        "{\"a\":\"\\q\"}",
+    };
+    cJSON_KeyPool* pool = cJSON_KeyPoolNew();
+    int ok = pool != NULL;
+    for (size_t i = 0; ok && i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        ok = cJSON_ParseWithKeyPool(invalid[i], strlen(invalid[i]), pool) == NULL
+            && cJSON_ParseWithKeyPool(invalid[i], strlen(invalid[i]), NULL) == NULL;
+    }
+    // 失敗の後もプールは使える
+    ok = ok && parses_like_cJSON_Parse(records, pool);
+    cJSON_KeyPoolFree(pool);
+    return ok;
+}
+
+static int test_invalid_documents(void) {
+    const char* invalid[] = { "{\"a\":1,\"b\":[1,}", "{\"a\":1,\"b\":tru}", "{\"a\":1,\"b\":{\"c\":x}}", "{\"a\" 1}" };
+    int ok = 1;
+    for (size_t i = 0; ok && i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        ok = cJSON_ParseWithKeyPool(invalid[i], strlen(invalid[i]), NULL) == NULL;
+    }
+    return ok;
+}
+
+static const TestCase key_pool_tests[] = {
+    { "KP 1: Same tree as cJSON_Parse", test_same_result },
+    { "KP 2: Equal keys are shared within and across documents", test_keys_are_shared },
+    { "KP 3: Keys outlive the pool", test_keys_outlive_pool },
+    { "KP 4: Detaching and renaming items with interned keys", test_rename_interned_key },
+    { "KP 5: Invalid escapes in keys are rejected without double free", test_invalid_escapes_in_keys },
+    { "KP 6: Invalid documents are rejected", test_invalid_documents },
+};
+
+void run_all_key_pool_tests(int* total, int* passed) {
+    printf("--- Running cJSON_ParseWithKeyPool Tests ---\n");
+    run_test_cases(key_pool_tests, (int)(sizeof(key_pool_tests) / sizeof(key_pool_tests[0])), total, passed);
+    printf("--- Finished cJSON_ParseWithKeyPool Tests ---\n\n");
+}
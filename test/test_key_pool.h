@@ -0,0 +1,7 @@
+#ifndef TEST_KEY_POOL_H_
+#define TEST_KEY_POOL_H_
+
+// キーの共有 (cJSON_ParseWithKeyPool, cJSON_KeyPool) のテストスイート宣言
+void run_all_key_pool_tests(int* total, int* passed);
+
+#endif // TEST_KEY_POOL_H_
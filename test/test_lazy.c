@@ -0,0 +1,127 @@
+#include "test_lazy.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_ParseLazy のテスト ---
+// 構造だけを検査し、値はカーソルでアクセスしたときに復号する。
+
+static const char* sample = "{\"a\":[1,2.5,-3e2,true,false,null,\"x\\u00e9\\ud83d\\ude00y\\n\"],\"b\":{},\"c\":[],"
+    "\"d\":{\"e\":{\"f\":[[[]]]}},\"k\\\"q\":7,\"a/b\":1,\"m~n\":2}";
+
+// 遅延解析と復号の結果が cJSON_ParseWithOpts (末尾検査あり) と同じか
+static int same_as_parse(const char* json) {
+    size_t length = strlen(json);
+    cJSON* expected = cJSON_ParseWithOpts(json, NULL, 1);
+    cJSON_Lazy* lazy = cJSON_ParseLazy(json, length);
+    cJSON* decoded = (lazy != NULL) ? cJSON_CursorDecode(cJSON_LazyGetRoot(lazy)) : NULL;
+    int ok = (expected == NULL) == (decoded == NULL);
+    if (ok && expected != NULL) {
+        char* a = cJSON_PrintUnformatted(expected);
+        char* b = cJSON_PrintUnformatted(decoded);
+        ok = strcmp(a, b) == 0;
+        cJSON_free(a);
+        cJSON_free(b);
+    }
+    if (!ok) {
+        printf("    mismatch: %s\n", json);
+    }
+    cJSON_Delete(expected);
+    cJSON_Delete(decoded);
+    cJSON_LazyDelete(lazy);
+    return ok;
+}
+
+static int test_decode_matches_parse(void) {
+    return same_as_parse(sample) && same_as_parse("  123  ") && same_as_parse("\"str\\\"ing\"")
+        && same_as_parse("[1, 2 , 3 ]") && same_as_parse("{\"k\" : \"v\"}") && same_as_parse("true")
+        && same_as_parse("-0.000001234")
+        && same_as_parse("[9223372036854775807,-9223372036854775808,18446744073709551616]");
+}
+
+static int test_invalid_documents(void) {
+    static const char* invalid[] = {
+        "[1,]", "{\"a\" 1}", "[1 2]", "tru", "\"abc", "[", "{\"a\":1}}", "1 2", "[}", "{,}", "\"\\u12\"",
+        "[1-2]", "[1]x", "{\"a\":}", "[truex]", "[01]", "[1e]", "[-]", "{\"\\q\":1}", ""
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        // 数値は復号時に検査されるので、解析か復号のどちらかで失敗すればよい
+        if (!same_as_parse(invalid[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int test_cursor_accessors(void) {
+    cJSON_Lazy* lazy = cJSON_ParseLazy(sample, strlen(sample));
+    cJSON_Cursor root = cJSON_LazyGetRoot(lazy);
+    cJSON_Cursor array = cJSON_CursorGetObjectItemCaseSensitive(root, "a");
+    int ok = lazy != NULL
+        && cJSON_CursorGetType(root) == cJSON_Object
+        && cJSON_CursorGetArraySize(array) == 7
+        && cJSON_CursorGetArraySize(cJSON_CursorGetObjectItem(root, "c")) == 0
+        && cJSON_CursorGetNumberValue(cJSON_CursorGetArrayItem(array, 1)) == 2.5
+        && cJSON_CursorGetType(cJSON_CursorGetArrayItem(array, 3)) == cJSON_True
+        && cJSON_CursorGetType(cJSON_CursorGetArrayItem(array, 5)) == cJSON_NULL
+        && cJSON_CursorGetType(cJSON_CursorGetArrayItem(array, 7)) == cJSON_Invalid
+        && cJSON_CursorGetType(cJSON_CursorGetArrayItem(array, -1)) == cJSON_Invalid
+        // キーはエスケープを解いてから比べる
+        && cJSON_CursorGetNumberValue(cJSON_CursorGetObjectItem(root, "k\"q")) == 7
+        // 数値でない値は NAN
+        && isnan(cJSON_CursorGetNumberValue(cJSON_CursorGetObjectItem(root, "b")))
+        && isnan(cJSON_CursorGetNumberValue(cJSON_CursorGetArrayItem(array, 6)));
+    cJSON* string = cJSON_CursorDecode(cJSON_CursorGetArrayItem(array, 6));
+    ok = ok && string != NULL && strcmp(string->valuestring, "x\xc3\xa9\xf0\x9f\x98\x80y\n") == 0;
+    cJSON_Delete(string);
+    cJSON_LazyDelete(lazy);
+    return ok;
+}
+
+static int test_case_sensitivity(void) {
+    cJSON_Lazy* lazy = cJSON_ParseLazy(sample, strlen(sample));
+    cJSON_Cursor root = cJSON_LazyGetRoot(lazy);
+    int ok = cJSON_CursorGetArraySize(cJSON_CursorGetObjectItem(root, "A")) == 7
+        && cJSON_CursorGetType(cJSON_CursorGetObjectItemCaseSensitive(root, "A")) == cJSON_Invalid
+        && cJSON_CursorGetType(cJSON_CursorGetObjectItem(root, "missing")) == cJSON_Invalid
+        // 無効なカーソルからの検索も無効なカーソルを返す
+        && cJSON_CursorGetType(cJSON_CursorGetObjectItem(cJSON_CursorGetObjectItem(root, "missing"), "a")) == cJSON_Invalid;
+    cJSON_LazyDelete(lazy);
+    return ok;
+}
+
+static int test_pointers(void) {
+    cJSON_Lazy* lazy = cJSON_ParseLazy(sample, strlen(sample));
+    cJSON_Cursor root = cJSON_LazyGetRoot(lazy);
+    int ok = cJSON_CursorGetNumberValue(cJSON_CursorGetPointer(root, "/a/2")) == -300
+        // ~1 は '/'、~0 は '~'
+        && cJSON_CursorGetNumberValue(cJSON_CursorGetPointer(root, "/a~1b")) == 1
+        && cJSON_CursorGetNumberValue(cJSON_CursorGetPointer(root, "/m~0n")) == 2
+        && cJSON_CursorGetType(cJSON_CursorGetPointer(root, "/d/e/f/0/0")) == cJSON_Array
+        && cJSON_CursorGetType(cJSON_CursorGetPointer(root, "")) == cJSON_Object
+        && cJSON_CursorGetType(cJSON_CursorGetPointer(root, "/a/07")) == cJSON_Invalid
+        && cJSON_CursorGetType(cJSON_CursorGetPointer(root, "/a/7")) == cJSON_Invalid
+        && cJSON_CursorGetType(cJSON_CursorGetPointer(root, "a")) == cJSON_Invalid
+        // カーソルからの相対パス
+        && cJSON_CursorGetType(cJSON_CursorGetPointer(cJSON_CursorGetObjectItem(root, "d"), "/e/f")) == cJSON_Array;
+    cJSON_LazyDelete(lazy);
+    return ok;
+}
+
+static const TestCase lazy_tests[] = {
+    { "LZ 1: Decoding matches cJSON_ParseWithOpts", test_decode_matches_parse },
+    { "LZ 2: Invalid documents are rejected", test_invalid_documents },
+    { "LZ 3: Cursor accessors", test_cursor_accessors },
+    { "LZ 4: Case sensitive and missing keys", test_case_sensitivity },
+    { "LZ 5: JSON Pointers with ~0 and ~1", test_pointers },
+};
+
+void run_all_lazy_tests(int* total, int* passed) {
+    printf("--- Running cJSON_ParseLazy Tests ---\n");
+    run_test_cases(lazy_tests, (int)(sizeof(lazy_tests) / sizeof(lazy_tests[0])), total, passed);
+    printf("--- Finished cJSON_ParseLazy Tests ---\n\n");
+}
@@ -0,0 +1,7 @@
+#ifndef TEST_LAZY_H_
+#define TEST_LAZY_H_
+
+// 遅延解析 (cJSON_ParseLazy / cJSON_Cursor) のテストスイート宣言
+void run_all_lazy_tests(int* total, int* passed);
+
+#endif // TEST_LAZY_H_
@@ -0,0 +1,198 @@
+#include "test_lines.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+#include "../cJSON/cJSON_Lines.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_ParseLines / cJSON_ParseLinesFile のテスト ---
+// 1 行に 1 文書。空行は飛ばし、不正な行は item == NULL で渡される。
+
+// テスト中に作るファイル
+static const char* lines_path = "test_lines.tmp";
+
+// コールバックが受け取った内容を記録する
+typedef struct {
+    int calls;
+    int stop_after; // 0 なら止めない
+    int in_order; // offset と "n" が入力の順に増えている
+    size_t last_offset;
+    int last_n;
+    int invalid;
+    size_t offsets[8];
+    char printed[8][32];
+} lines_record;
+
+static void record_init(lines_record* record) {
+    memset(record, 0, sizeof(*record));
+    record->in_order = 1;
+    record->last_n = -1;
+}
+
+static cJSON_bool record_line(void* context, size_t offset, cJSON* item) {
+    lines_record* record = (lines_record*)context;
+    const cJSON* n = cJSON_GetObjectItem(item, "n");
+    if (record->calls > 0 && offset <= record->last_offset) {
+        record->in_order = 0;
+    }
+    record->last_offset = offset;
+    if (item == NULL) {
+        record->invalid++;
+    } else if (n != NULL) {
+        if (n->valueint != record->last_n + 1) {
+            record->in_order = 0;
+        }
+        record->last_n = n->valueint;
+    }
+    if (record->calls < 8) {
+        char* printed = (item == NULL) ? NULL : cJSON_PrintUnformatted(item);
+        record->offsets[record->calls] = offset;
+        strncpy(record->printed[record->calls], (printed == NULL) ? "NULL" : printed, 31);
+        cJSON_free(printed);
+    }
+    record->calls++;
+    return record->stop_after == 0 || record->calls < record->stop_after;
+}
+
+// {"n":0}\n{"n":1}\n ... を count 行
+static char* numbered_lines(int count, size_t* length) {
+    char* text = (char*)malloc((size_t)count * 24 + 1);
+    size_t used = 0;
+    if (text == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < count; ++i) {
+        used += (size_t)sprintf(text + used, "{\"n\":%d,\"pad\":\"xx\"}\n", i);
+    }
+    *length = used;
+    return text;
+}
+
+static int test_ordered_delivery(void) {
+    // 複数のブロックにまたがる入力を 4 スレッドで解析しても、入力の順に 1 回ずつ届く
+    const int count = 40000;
+    size_t length = 0;
+    char* text = numbered_lines(count, &length);
+    cJSON_LinesOptions options;
+    lines_record record;
+    int ok = text != NULL;
+    memset(&options, 0, sizeof(options));
+    options.threads = 4;
+    record_init(&record);
+    ok = ok && cJSON_ParseLines(text, length, &options, record_line, &record)
+        && record.calls == count && record.in_order && record.invalid == 0 && record.last_n == count - 1;
+    // アリーナを使っても同じ
+    options.arenas = 1;
+    record_init(&record);
+    ok = ok && cJSON_ParseLines(text, length, &options, record_line, &record)
+        && record.calls == count && record.in_order && record.last_n == count - 1;
+    free(text);
+    return ok;
+}
+
+static int test_line_handling(void) {
+    const char* text = "{\"a\":1}\r\n\n   \r\n[1,\n\"x\"\r\n  {\"b\":2}  \n\n\"last\"";
+    lines_record record;
+    record_init(&record);
+    // 空行と空白だけの行は飛ばし、CRLF の \r は取り除く。不正な行は NULL で渡す
+    int ok = cJSON_ParseLines(text, strlen(text), NULL, record_line, &record)
+        && record.calls == 5 && record.invalid == 1 && record.in_order
+        && strcmp(record.printed[0], "{\"a\":1}") == 0 && record.offsets[0] == 0
+        && strcmp(record.printed[1], "NULL") == 0 && record.offsets[1] == 15
+        && strcmp(record.printed[2], "\"x\"") == 0 && record.offsets[2] == 19
+        && strcmp(record.printed[3], "{\"b\":2}") == 0 && record.offsets[3] == 26
+        // 改行で終わらない最後の行も届く
+        && strcmp(record.printed[4], "\"last\"") == 0 && record.offsets[4] == 37;
+    // 空の入力ではコールバックは呼ばれない
+    record_init(&record);
+    ok = ok && cJSON_ParseLines("", 0, NULL, record_line, &record) && record.calls == 0
+        && cJSON_ParseLines("\n\r\n \n", 5, NULL, record_line, &record) && record.calls == 0
+        && !cJSON_ParseLines(NULL, 1, NULL, record_line, &record)
+        && !cJSON_ParseLines(text, strlen(text), NULL, NULL, &record);
+    return ok;
+}
+
+static int test_early_stop(void) {
+    const int count = 40000;
+    size_t length = 0;
+    char* text = numbered_lines(count, &length);
+    cJSON_LinesOptions options;
+    lines_record record;
+    int ok = text != NULL;
+    memset(&options, 0, sizeof(options));
+    options.threads = 4;
+    // false を返すと、それ以降の行は渡されず結果は false
+    record_init(&record);
+    record.stop_after = 3;
+    ok = ok && !cJSON_ParseLines(text, length, &options, record_line, &record)
+        && record.calls == 3 && record.in_order && record.last_n == 2;
+    // 1 スレッドでも同じ
+    options.threads = 1;
+    record_init(&record);
+    record.stop_after = 1;
+    ok = ok && !cJSON_ParseLines(text, length, &options, record_line, &record) && record.calls == 1;
+    free(text);
+    return ok;
+}
+
+static int test_unordered(void) {
+    // 順不同でも全行が届く (1 スレッドなのでコールバックは同時には呼ばれない)
+    const int count = 20000;
+    size_t length = 0;
+    char* text = numbered_lines(count, &length);
+    cJSON_LinesOptions options;
+    lines_record record;
+    int ok = text != NULL;
+    memset(&options, 0, sizeof(options));
+    options.threads = 1;
+    options.unordered = 1;
+    record_init(&record);
+    ok = ok && cJSON_ParseLines(text, length, &options, record_line, &record)
+        && record.calls == count && record.invalid == 0;
+    free(text);
+    return ok;
+}
+
+static int test_file(void) {
+    const int count = 30000;
+    size_t length = 0;
+    char* text = numbered_lines(count, &length);
+    FILE* file = fopen(lines_path, "wb");
+    cJSON_LinesOptions options;
+    lines_record record;
+    int ok = text != NULL && file != NULL && fwrite(text, 1, length, file) == length;
+    if (file != NULL) {
+        ok = (fclose(file) == 0) && ok;
+    }
+    memset(&options, 0, sizeof(options));
+    options.threads = 3;
+    // ファイルからもメモリ上と同じ順に届く
+    record_init(&record);
+    ok = ok && cJSON_ParseLinesFile(lines_path, &options, record_line, &record)
+        && record.calls == count && record.in_order && record.last_n == count - 1;
+    record_init(&record);
+    record.stop_after = 10;
+    ok = ok && !cJSON_ParseLinesFile(lines_path, &options, record_line, &record) && record.calls == 10;
+    remove(lines_path);
+    // 存在しないファイルは失敗する
+    record_init(&record);
+    ok = ok && !cJSON_ParseLinesFile(lines_path, NULL, record_line, &record) && record.calls == 0;
+    free(text);
+    return ok;
+}
+
+static const TestCase lines_tests[] = {
+    { "LN 1: Lines are delivered once each, in input order", test_ordered_delivery },
+    { "LN 2: Empty lines, CRLF, invalid lines and a last line without newline", test_line_handling },
+    { "LN 3: The callback stops the parsing", test_early_stop },
+    { "LN 4: Unordered delivery", test_unordered },
+    { "LN 5: cJSON_ParseLinesFile", test_file },
+};
+
+void run_all_lines_tests(int* total, int* passed) {
+    printf("--- Running cJSON_ParseLines Tests ---\n");
+    run_test_cases(lines_tests, (int)(sizeof(lines_tests) / sizeof(lines_tests[0])), total, passed);
+    printf("--- Finished cJSON_ParseLines Tests ---\n\n");
+}
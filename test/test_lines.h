@@ -0,0 +1,7 @@
+#ifndef TEST_LINES_H_
+#define TEST_LINES_H_
+
+// cJSON_ParseLines / cJSON_ParseLinesFile のテストスイート宣言
+void run_all_lines_tests(int* total, int* passed);
+
+#endif // TEST_LINES_H_
@@ -0,0 +1,177 @@
+#include "test_minify.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_Minify のテスト ---
+// 64 バイトのブロック単位で処理する実装を、1 バイトずつ処理する参照実装と比べる。
+
+// 参照実装: 文字列の外の空白とコメントを取り除く。文字列はエスケープを考慮してそのまま残す。
+static void reference_minify(const char* input, char* output) {
+    int in_string = 0;
+    int escaped = 0;
+    while (*input != '\0') {
+        const char character = *input;
+        const int was_escaped = escaped;
+        escaped = 0;
+        if (in_string) {
+            if (!was_escaped && character == '\\') {
+                escaped = 1;
+            } else if (!was_escaped && character == '"') {
+                in_string = 0;
+            }
+            *output++ = *input++;
+            continue;
+        }
+        if (character == ' ' || character == '\t' || character == '\r' || character == '\n') {
+            input++;
+        } else if (character == '/' && input[1] == '/') {
+            // 行末の改行まで
+            input += 2;
+            while (*input != '\0' && *input++ != '\n') {
+            }
+        } else if (character == '/' && input[1] == '*') {
+            input += 2;
+            while (*input != '\0' && !(input[0] == '*' && input[1] == '/')) {
+                input++;
+            }
+            input += (*input != '\0') ? 2 : 0;
+        } else if (character == '/') {
+            input++;
+        } else {
+            if (character == '"') {
+                in_string = !was_escaped;
+            } else if (character == '\\') {
+                escaped = !was_escaped;
+            }
+            *output++ = *input++;
+        }
+    }
+    *output = '\0';
+}
+
+// cJSON_Minify と参照実装の結果が一致するか
+static int same_as_reference(const char* json) {
+    size_t length = strlen(json);
+    char* minified = (char*)malloc(length + 1);
+    char* expected = (char*)malloc(length + 1);
+    int ok = 0;
+    memcpy(minified, json, length + 1);
+    cJSON_Minify(minified);
+    reference_minify(json, expected);
+    ok = strcmp(minified, expected) == 0;
+    if (!ok) {
+        printf("    input    %s\n    expected %s\n    got      %s\n", json, expected, minified);
+    }
+    free(minified);
+    free(expected);
+    return ok;
+}
+
+static int minifies_to(const char* json, const char* expected) {
+    char buffer[256];
+    strcpy(buffer, json);
+    cJSON_Minify(buffer);
+    if (strcmp(buffer, expected) != 0) {
+        printf("    %s -> %s, expected %s\n", json, buffer, expected);
+        return 0;
+    }
+    return 1;
+}
+
+static int test_examples(void) {
+    return minifies_to("{ \"a\" : [ 1 ,\t2 ]\r\n}", "{\"a\":[1,2]}")
+        && minifies_to("\" keep  spaces \"", "\" keep  spaces \"")
+        && minifies_to("[\"a\\\" b\" , \"c\\\\\" , 1]", "[\"a\\\" b\",\"c\\\\\",1]")
+        && minifies_to("[1, // comment\n 2 /* block\n comment */ , 3]", "[1,2,3]")
+        && minifies_to("\"// not /* a comment\"", "\"// not /* a comment\"")
+        // 閉じていないコメントと文字列
+        && minifies_to("[1 /* open", "[1") && minifies_to("[1 // open", "[1")
+        && minifies_to("[\"open  ", "[\"open  ") && minifies_to("", "")
+        && minifies_to("a / b", "ab");
+}
+
+static int test_block_boundaries(void) {
+    char json[512];
+    // 64 バイト境界をまたぐバックスラッシュの連続、引用符、コメント
+    for (int start = 40; start < 140; start++) {
+        for (int backslashes = 1; backslashes <= 5; backslashes++) {
+            memset(json, ' ', (size_t)start);
+            json[0] = '"';
+            int length = start;
+            for (int i = 0; i < backslashes; i++) {
+                json[length++] = '\\';
+            }
+            length += sprintf(json + length, "\" , [ 1 ,  2 ] \"x  y\"  ");
+            json[length] = '\0';
+            if (!same_as_reference(json)) {
+                return 0;
+            }
+        }
+        memset(json, ' ', (size_t)start);
+        sprintf(json + start, "/* c\"omment */ \"a  b\" // x\"\n  \"c  d\" /");
+        if (!same_as_reference(json)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int test_random_input(void) {
+    static const char alphabet[] = "   \n\t\"\"\\\\//*ab{},:\xC3\xA9";
+    unsigned long seed = 7;
+    char json[600];
+    for (int round = 0; round < 20000; round++) {
+        seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+        size_t length = (size_t)(seed >> 33) % (sizeof(json) - 1);
+        for (size_t i = 0; i < length; i++) {
+            seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+            json[i] = alphabet[(seed >> 33) % (sizeof(alphabet) - 1)];
+        }
+        json[length] = '\0';
+        if (!same_as_reference(json)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int test_formatted_documents(void) {
+    cJSON* root = cJSON_CreateObject();
+    cJSON* array = cJSON_AddArrayToObject(root, "items");
+    for (int i = 0; i < 200; i++) {
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddNumberToObject(item, "id", i);
+        cJSON_AddStringToObject(item, "name", (i % 3 == 0) ? "with \"quotes\" and \\ " : "  spaced  ");
+        cJSON_AddItemToArray(array, item);
+    }
+    // 整形した出力を縮めると、整形しない出力と同じになる
+    char* formatted = cJSON_Print(root);
+    char* unformatted = cJSON_PrintUnformatted(root);
+    int ok = formatted != NULL && unformatted != NULL;
+    if (ok) {
+        cJSON_Minify(formatted);
+        ok = strcmp(formatted, unformatted) == 0;
+    }
+    cJSON_free(formatted);
+    cJSON_free(unformatted);
+    cJSON_Delete(root);
+    cJSON_Minify(NULL);
+    return ok;
+}
+
+static const TestCase minify_tests[] = {
+    { "MIN 1: Whitespace, strings and comments", test_examples },
+    { "MIN 2: Escapes and comments across block boundaries", test_block_boundaries },
+    { "MIN 3: Random input matches the reference", test_random_input },
+    { "MIN 4: Minified cJSON_Print matches cJSON_PrintUnformatted", test_formatted_documents },
+};
+
+void run_all_minify_tests(int* total, int* passed) {
+    printf("--- Running cJSON_Minify Tests ---\n");
+    run_test_cases(minify_tests, (int)(sizeof(minify_tests) / sizeof(minify_tests[0])), total, passed);
+    printf("--- Finished cJSON_Minify Tests ---\n\n");
+}
@@ -0,0 +1,7 @@
+#ifndef TEST_MINIFY_H_
+#define TEST_MINIFY_H_
+
+// cJSON_Minify のテストスイート宣言
+void run_all_minify_tests(int* total, int* passed);
+
+#endif // TEST_MINIFY_H_
@@ -0,0 +1,179 @@
+#include "test_packed.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+#include "../cJSON/cJSON_Binary.h"
+#include "../cJSON/cJSON_Document.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_PackedNumberArray のテスト ---
+// 数値だけの配列は要素を作らずに C の配列として保存され、要素が必要になったときに展開される。
+
+static cJSON* parse_packed(const char* json) {
+    cJSON_Context context;
+    cJSON_InitContext(&context);
+    context.pack_number_arrays = 1;
+    return cJSON_ParseCtx(json, strlen(json) + 1, &context);
+}
+
+static int is_packed(const cJSON* item) {
+    return item != NULL && (item->type & cJSON_PackedNumberArray) != 0;
+}
+
+// パックした木は通常の木と同じに印刷・比較・複製される
+static int same_as_plain(const char* json) {
+    cJSON* plain = cJSON_Parse(json);
+    cJSON* packed = parse_packed(json);
+    cJSON* copy = cJSON_Duplicate(packed, 1);
+    char* expected = cJSON_Print(plain);
+    char* actual = cJSON_Print(packed);
+    int ok = expected != NULL && actual != NULL && strcmp(expected, actual) == 0
+        && cJSON_Compare(plain, packed, 1) && cJSON_Compare(packed, plain, 1) && cJSON_Compare(copy, plain, 1);
+    cJSON_free(expected);
+    cJSON_free(actual);
+    cJSON_Delete(plain);
+    cJSON_Delete(packed);
+    cJSON_Delete(copy);
+    return ok;
+}
+
+static int test_same_as_plain(void) {
+    cJSON* root = parse_packed("{\"v\":[1,2.5,-3],\"s\":[1,\"x\"],\"e\":[]}");
+    int ok = root != NULL && is_packed(cJSON_GetObjectItem(root, "v")) && !is_packed(cJSON_GetObjectItem(root, "s"))
+        && !is_packed(cJSON_GetObjectItem(root, "e"))
+        && same_as_plain("{\"v\":[1,2.5,-3],\"s\":[1,\"x\"],\"e\":[]}")
+        && same_as_plain("[9223372036854775807,-9223372036854775807,1e300]")
+        && same_as_plain("[[1,2],[3,4]]");
+    cJSON_Delete(root);
+    return ok;
+}
+
+static int test_read_without_expanding(void) {
+    cJSON* array = parse_packed("[1,2.5,-3]");
+    cJSON number;
+    double numbers[4];
+    // 大きさと数値の読み取りでは要素を作らない
+    int ok = is_packed(array) && cJSON_GetArraySize(array) == 3
+        && cJSON_GetDoubleArray(array, numbers, 4) == 3 && numbers[1] == 2.5
+        && cJSON_GetPackedNumber(array, 2, &number) && cJSON_IsNumber(&number) && number.valuedouble == -3
+        && !cJSON_GetPackedNumber(array, 3, &number) && !cJSON_GetPackedNumber(array, -1, &number)
+        && is_packed(array) && array->child == NULL;
+    cJSON_Delete(array);
+    return ok;
+}
+
+static int test_read_items(void) {
+    cJSON* root = parse_packed("{\"v\":[1,2.5,-3],\"w\":[4,5],\"x\":[6],\"y\":[7,8]}");
+    cJSON* array = cJSON_GetObjectItem(root, "v");
+    cJSON* element = NULL;
+    double sum = 0;
+    int count = 0;
+    // cJSON_GetArrayItem は最初の呼び出しで展開し、大きさと同じ数の要素を返す
+    int ok = is_packed(array) && cJSON_GetArraySize(array) == 3
+        && cJSON_GetNumberValue(cJSON_GetArrayItem(array, 1)) == 2.5 && !is_packed(array)
+        && cJSON_GetArraySize(array) == 3
+        && cJSON_GetNumberValue(cJSON_GetArrayItem(array, 0)) == 1
+        && cJSON_GetNumberValue(cJSON_GetArrayItem(array, 2)) == -3
+        && cJSON_GetArrayItem(array, 3) == NULL && cJSON_GetArrayItem(array, -1) == NULL;
+    // cJSON_ArrayForEach も全要素を回る
+    array = cJSON_GetObjectItem(root, "w");
+    cJSON_ArrayForEach(element, array) {
+        sum += element->valuedouble;
+        count++;
+    }
+    ok = ok && count == cJSON_GetArraySize(array) && count == 2 && sum == 9;
+    // cJSON_GetChild も同じ
+    array = cJSON_GetObjectItem(root, "x");
+    element = cJSON_GetChild(array);
+    ok = ok && element != NULL && cJSON_IsNumber(element) && element->valueint == 6 && element->next == NULL
+        && !is_packed(array)
+        // 読まれなかった配列はパックされたまま
+        && is_packed(cJSON_GetObjectItem(root, "y"));
+    cJSON_Delete(root);
+    return ok;
+}
+
+static int test_exact_integers(void) {
+    cJSON_int64 numbers[] = { 9007199254740993LL, -4 };
+    cJSON_int64 read[2];
+    cJSON* array = cJSON_CreatePackedInt64Array(numbers, 2);
+    cJSON number;
+    int ok = is_packed(array) && cJSON_GetInt64Array(array, read, 2) == 2 && read[0] == numbers[0]
+        && cJSON_GetPackedNumber(array, 0, &number) && cJSON_GetInt64Value(&number) == numbers[0];
+    // 展開しても正確な値は残る
+    ok = ok && cJSON_Unshare(array) && !is_packed(array) && cJSON_GetInt64Value(cJSON_GetArrayItem(array, 0)) == numbers[0];
+    cJSON_Delete(array);
+    return ok;
+}
+
+static int test_changes_expand(void) {
+    cJSON* array = parse_packed("[1,2,3]");
+    char* printed = NULL;
+    int ok = cJSON_InsertItemInArray(array, 0, cJSON_CreateNumber(0)) && !is_packed(array)
+        && cJSON_ReplaceItemInArray(array, 3, cJSON_CreateNull());
+    cJSON_DeleteItemFromArray(array, 1);
+    ok = ok && cJSON_AddItemToArray(array, cJSON_CreateString("x"));
+    printed = cJSON_PrintUnformatted(array);
+    ok = ok && printed != NULL && strcmp(printed, "[0,2,null,\"x\"]") == 0;
+    cJSON_free(printed);
+    cJSON_Delete(array);
+
+    // cJSON_Unshare で明示的に展開することもできる
+    array = parse_packed("[1,2,3]");
+    {
+        cJSON* element = NULL;
+        int sum = 0;
+        ok = ok && cJSON_Unshare(array) && !is_packed(array) && array->child != NULL;
+        cJSON_ArrayForEach(element, array) {
+            sum += element->valueint;
+        }
+        ok = ok && sum == 6 && cJSON_GetArrayItem(array, 2)->valueint == 3;
+    }
+    cJSON_Delete(array);
+    return ok;
+}
+
+static int test_encoders(void) {
+    const char* json = "{\"v\":[1,2.5,-3],\"i\":[1,9007199254740993]}";
+    cJSON* plain = cJSON_Parse(json);
+    cJSON* packed = parse_packed(json);
+    size_t plain_length = 0;
+    size_t packed_length = 0;
+    unsigned char* plain_cbor = cJSON_EncodeCBOR(plain, &plain_length);
+    unsigned char* packed_cbor = cJSON_EncodeCBOR(packed, &packed_length);
+    unsigned char* packed_msgpack = cJSON_EncodeMessagePack(packed, &packed_length);
+    cJSON* decoded = (packed_msgpack == NULL) ? NULL : cJSON_DecodeMessagePack(packed_msgpack, packed_length, NULL);
+    cJSON_Document* document = cJSON_DocumentFromTree(packed);
+    cJSON* tree = (document == NULL) ? NULL : cJSON_DocumentToTree(document, 0);
+    // バイナリ形式と文書でも同じ結果になり、配列は展開されない
+    int ok = plain_cbor != NULL && packed_cbor != NULL && memcmp(plain_cbor, packed_cbor, plain_length) == 0
+        && cJSON_Compare(decoded, plain, 1) && cJSON_Compare(tree, plain, 1)
+        && cJSON_GetInt64Value(cJSON_GetArrayItem(cJSON_GetObjectItem(tree, "i"), 1)) == 9007199254740993LL
+        && is_packed(cJSON_GetObjectItem(packed, "v")) && is_packed(cJSON_GetObjectItem(packed, "i"));
+    cJSON_free(plain_cbor);
+    cJSON_free(packed_cbor);
+    cJSON_free(packed_msgpack);
+    cJSON_Delete(decoded);
+    cJSON_Delete(tree);
+    cJSON_DocumentDelete(document);
+    cJSON_Delete(plain);
+    cJSON_Delete(packed);
+    return ok;
+}
+
+static const TestCase packed_tests[] = {
+    { "PK 1: Printed, compared and duplicated like plain arrays", test_same_as_plain },
+    { "PK 2: Size and numbers are read without expanding", test_read_without_expanding },
+    { "PK 3: Item access expands the array", test_read_items },
+    { "PK 4: Exact 64-bit integers", test_exact_integers },
+    { "PK 5: Modifying functions and cJSON_Unshare expand the array", test_changes_expand },
+    { "PK 6: CBOR, MessagePack and documents read packed arrays as they are", test_encoders },
+};
+
+void run_all_packed_tests(int* total, int* passed) {
+    printf("--- Running cJSON_PackedNumberArray Tests ---\n");
+    run_test_cases(packed_tests, (int)(sizeof(packed_tests) / sizeof(packed_tests[0])), total, passed);
+    printf("--- Finished cJSON_PackedNumberArray Tests ---\n\n");
+}
@@ -0,0 +1,7 @@
+#ifndef TEST_PACKED_H_
+#define TEST_PACKED_H_
+
+// 数値の配列のパック (cJSON_PackedNumberArray) のテストスイート宣言
+void run_all_packed_tests(int* total, int* passed);
+
+#endif // TEST_PACKED_H_
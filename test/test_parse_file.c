@@ -0,0 +1,153 @@
+#include "test_parse_file.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_ParseFile のテスト ---
+// ファイルを mmap して (できない環境では読み込んで) 解析する。
+
+// テスト中に作るファイル
+static const char* json_path = "test_parse_file.tmp";
+
+static const char* sample = "{\"a\":\"x\\u00e9\\n\",\"b\":[1,2,3],\"c\":{\"d\":null}}";
+
+static int write_file(const char* content, size_t length) {
+    FILE* file = fopen(json_path, "wb");
+    int ok = 0;
+    if (file == NULL) {
+        return 0;
+    }
+    ok = fwrite(content, 1, length, file) == length;
+    return (fclose(file) == 0) && ok;
+}
+
+static int test_same_as_parse(void) {
+    cJSON* expected = cJSON_Parse(sample);
+    cJSON_Context context;
+    int ok = write_file(sample, strlen(sample));
+    cJSON* root = cJSON_ParseFile(json_path, NULL);
+    ok = ok && root != NULL && cJSON_Compare(expected, root, 1);
+    cJSON_Delete(root);
+    // 文書はファイルより長く生きるので、end と error は NULL
+    cJSON_InitContext(&context);
+    root = cJSON_ParseFile(json_path, &context);
+    ok = ok && root != NULL && cJSON_Compare(expected, root, 1) && context.end == NULL && context.error == NULL;
+    cJSON_Delete(root);
+    // 配列の圧縮も文脈のとおり
+    context.pack_number_arrays = 1;
+    root = cJSON_ParseFile(json_path, &context);
+    ok = ok && root != NULL && (cJSON_GetObjectItem(root, "b")->type & cJSON_PackedNumberArray);
+    cJSON_Delete(root);
+    cJSON_Delete(expected);
+    remove(json_path);
+    return ok;
+}
+
+static int test_in_situ_with_arena(void) {
+    cJSON* expected = cJSON_Parse(sample);
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    cJSON_Context context;
+    int ok = write_file(sample, strlen(sample));
+    cJSON_InitContext(&context);
+    context.arena = arena;
+    // アリーナがファイルの内容を持つので end を返せる
+    cJSON* root = cJSON_ParseFile(json_path, &context);
+    ok = ok && root != NULL && cJSON_Compare(expected, root, 1) && context.end != NULL;
+    cJSON_ArenaFree(arena);
+    // その場で復号しても、ファイル自体は変わらない
+    root = cJSON_ParseFile(json_path, NULL);
+    ok = ok && root != NULL && cJSON_Compare(expected, root, 1);
+    cJSON_Delete(root);
+    cJSON_Delete(expected);
+    remove(json_path);
+    return ok;
+}
+
+static int test_trailing_content(void) {
+    cJSON_Context context;
+    cJSON_Arena* arena = NULL;
+    cJSON* root = NULL;
+    int ok = write_file("[1] \n", 5);
+    cJSON_InitContext(&context);
+    context.require_null_terminated = 1;
+    root = cJSON_ParseFile(json_path, &context);
+    ok = ok && root != NULL;
+    cJSON_Delete(root);
+    // 値の後ろの文字は require_null_terminated のときだけ拒否する
+    ok = ok && write_file("[1] x", 5) && cJSON_ParseFile(json_path, &context) == NULL
+        && context.error_offset == 4 && context.error == NULL;
+    context.require_null_terminated = 0;
+    root = cJSON_ParseFile(json_path, &context);
+    ok = ok && root != NULL;
+    cJSON_Delete(root);
+    // アリーナがあれば error はファイルの内容を指す
+    arena = cJSON_ArenaNew(0);
+    context.arena = arena;
+    context.require_null_terminated = 1;
+    ok = ok && cJSON_ParseFile(json_path, &context) == NULL && context.error_offset == 4
+        && context.error != NULL && *context.error == 'x';
+    cJSON_ArenaFree(arena);
+    remove(json_path);
+    return ok;
+}
+
+static int test_errors(void) {
+    cJSON_Context context;
+    cJSON_Arena* arena = cJSON_ArenaNew(0);
+    int ok = write_file("{\"a\":", 5);
+    cJSON_InitContext(&context);
+    ok = ok && cJSON_ParseFile(json_path, &context) == NULL && context.error_offset == 4;
+    // 文脈がなければ cJSON_GetErrorPtr は設定されない
+    ok = ok && cJSON_ParseFile(json_path, NULL) == NULL && cJSON_GetErrorPtr() == NULL;
+    context.arena = arena;
+    ok = ok && write_file("\"abc", 4) && cJSON_ParseFile(json_path, &context) == NULL;
+    cJSON_ArenaFree(arena);
+    ok = ok && write_file("", 0) && cJSON_ParseFile(json_path, NULL) == NULL;
+    // 長さの上限
+    cJSON_InitContext(&context);
+    context.length_limit = 6;
+    ok = ok && write_file("[1,2,3]", 7) && cJSON_ParseFile(json_path, &context) == NULL;
+    remove(json_path);
+    return ok && cJSON_ParseFile(json_path, NULL) == NULL && cJSON_ParseFile(NULL, NULL) == NULL
+        && cJSON_ParseFile(".", NULL) == NULL; // ディレクトリ
+}
+
+static int test_value_at_end_of_file(void) {
+    size_t length = 4096 * 2;
+    char* content = (char*)malloc(length);
+    cJSON* root = NULL;
+    int ok = content != NULL;
+    // ページ境界で終わるファイルでは、値の直後に終端がない
+    content[0] = '"';
+    memset(content + 1, 'a', length - 2);
+    content[length - 1] = '"';
+    root = (ok && write_file(content, length)) ? cJSON_ParseFile(json_path, NULL) : NULL;
+    ok = ok && root != NULL && strlen(root->valuestring) == length - 2;
+    cJSON_Delete(root);
+    content[length - 1] = 'a';
+    ok = ok && write_file(content, length) && cJSON_ParseFile(json_path, NULL) == NULL;
+    memset(content, '1', length);
+    root = (ok && write_file(content, length)) ? cJSON_ParseFile(json_path, NULL) : NULL;
+    ok = ok && cJSON_IsNumber(root);
+    cJSON_Delete(root);
+    free(content);
+    remove(json_path);
+    return ok;
+}
+
+static const TestCase parse_file_tests[] = {
+    { "PF 1: The same tree as cJSON_Parse", test_same_as_parse },
+    { "PF 2: In-situ parsing with an arena", test_in_situ_with_arena },
+    { "PF 3: Content after the value", test_trailing_content },
+    { "PF 4: Errors, empty and missing files", test_errors },
+    { "PF 5: Values that end with the file", test_value_at_end_of_file },
+};
+
+void run_all_parse_file_tests(int* total, int* passed) {
+    printf("--- Running cJSON_ParseFile Tests ---\n");
+    run_test_cases(parse_file_tests, (int)(sizeof(parse_file_tests) / sizeof(parse_file_tests[0])), total, passed);
+    printf("--- Finished cJSON_ParseFile Tests ---\n\n");
+}
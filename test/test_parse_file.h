@@ -0,0 +1,7 @@
+#ifndef TEST_PARSE_FILE_H_
+#define TEST_PARSE_FILE_H_
+
+// cJSON_ParseFile のテストスイート宣言
+void run_all_parse_file_tests(int* total, int* passed);
+
+#endif // TEST_PARSE_FILE_H_
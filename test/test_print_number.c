@@ -0,0 +1,125 @@
+#include "test_print_number.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- 数値の印刷のテスト ---
+// 浮動小数点数は、同じ double に読み戻せる最短の桁で印刷される。
+
+// number を印刷して expected と比べる
+static int prints_as(double number, const char* expected) {
+    cJSON* item = cJSON_CreateNumber(number);
+    char* printed = cJSON_PrintUnformatted(item);
+    int ok = printed != NULL && strcmp(printed, expected) == 0;
+    if (!ok) {
+        printf("    %s (expected %s)\n", printed != NULL ? printed : "NULL", expected);
+    }
+    cJSON_free(printed);
+    cJSON_Delete(item);
+    return ok;
+}
+
+// printf と strtod で求めた、読み戻せる最短の桁数
+static int shortest_digits(double number) {
+    char buffer[32];
+    int low = 1;
+    int high = 17;
+    while (low < high) {
+        int precision = (low + high) / 2;
+        snprintf(buffer, sizeof(buffer), "%.*e", precision - 1, number);
+        if (strtod(buffer, NULL) == number) {
+            high = precision;
+        } else {
+            low = precision + 1;
+        }
+    }
+    return low;
+}
+
+// 印刷された数値の有効桁数 (先頭と末尾の 0 を除く)
+static int significant_digits(const char* printed) {
+    int count = 0;
+    int first = -1;
+    int last = -1;
+    for (; *printed != '\0' && *printed != 'e'; printed++) {
+        if (*printed < '0' || *printed > '9') {
+            continue;
+        }
+        if (*printed != '0') {
+            if (first < 0) {
+                first = count;
+            }
+            last = count;
+        }
+        count++;
+    }
+    return (first < 0) ? 1 : last - first + 1;
+}
+
+static int test_simple_numbers(void) {
+    return prints_as(0.1, "0.1") && prints_as(0.3, "0.3") && prints_as(-123.456, "-123.456")
+        && prints_as(2.0 / 3.0, "0.6666666666666666") && prints_as(1e-7, "1e-07")
+        && prints_as(4.35e-6, "4.35e-06") && prints_as(0.0001, "0.0001") && prints_as(1.5, "1.5");
+}
+
+static int test_hard_cases(void) {
+    // Grisu2 は 1e23 を 9.999999999999999e+22 と印刷していた
+    return prints_as(1e23, "1e+23") && prints_as(1e22, "1e+22") && prints_as(1e21, "1e+21")
+        && prints_as(5e-324, "5e-324") && prints_as(1.5e-323, "1.5e-323")
+        && prints_as(1.7976931348623157e308, "1.7976931348623157e+308")
+        && prints_as(2.2250738585072014e-308, "2.2250738585072014e-308")
+        && prints_as(9007199254740993.0, "9007199254740992")
+        && prints_as(5.551115123125783e-17, "5.551115123125783e-17");
+}
+
+static int test_exact_integers(void) {
+    // 2^53 を超える整数は解析した値のまま印刷される
+    cJSON* number = cJSON_Parse("9007199254740993");
+    char* printed = cJSON_PrintUnformatted(number);
+    int ok = printed != NULL && strcmp(printed, "9007199254740993") == 0;
+    cJSON_free(printed);
+    cJSON_Delete(number);
+    return ok;
+}
+
+static int test_random_doubles_are_shortest(void) {
+    unsigned long long state = 88172645463325252ULL;
+    int ok = 1;
+    for (int i = 0; ok && i < 50000; i++) {
+        double number = 0;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        memcpy(&number, &state, sizeof(number));
+        // 整数は正確な値で印刷されるので除く
+        if (isnan(number) || isinf(number) || number == 0 || (fabs(number) < 9.2e18 && number == floor(number))) {
+            continue;
+        }
+        cJSON* item = cJSON_CreateNumber(number);
+        char* printed = cJSON_PrintUnformatted(item);
+        ok = printed != NULL && strtod(printed, NULL) == number && significant_digits(printed) == shortest_digits(number);
+        if (!ok) {
+            printf("    %s is not the shortest form of %.17g\n", printed != NULL ? printed : "NULL", number);
+        }
+        cJSON_free(printed);
+        cJSON_Delete(item);
+    }
+    return ok;
+}
+
+static const TestCase print_number_tests[] = {
+    { "PN 1: Simple numbers", test_simple_numbers },
+    { "PN 2: Hard cases for Grisu (1e23, subnormals, extremes)", test_hard_cases },
+    { "PN 3: Integers beyond 2^53 keep their parsed value", test_exact_integers },
+    { "PN 4: Random doubles read back with the fewest digits", test_random_doubles_are_shortest },
+};
+
+void run_all_print_number_tests(int* total, int* passed) {
+    printf("--- Running Number Printing Tests ---\n");
+    run_test_cases(print_number_tests, (int)(sizeof(print_number_tests) / sizeof(print_number_tests[0])), total, passed);
+    printf("--- Finished Number Printing Tests ---\n\n");
+}
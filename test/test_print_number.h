@@ -0,0 +1,7 @@
+#ifndef TEST_PRINT_NUMBER_H_
+#define TEST_PRINT_NUMBER_H_
+
+// 数値の最短表現での印刷 (Grisu3) のテストスイート宣言
+void run_all_print_number_tests(int* total, int* passed);
+
+#endif // TEST_PRINT_NUMBER_H_
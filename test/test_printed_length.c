@@ -0,0 +1,123 @@
+#include "test_printed_length.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_PrintedLength / cJSON_PrintExact のテスト ---
+// 長さは cJSON_Print の出力とちょうど同じで、cJSON_PrintExact はその長さで 1 回だけ確保する。
+
+static const char* documents[] = {
+    "{\"a\":[1,2.5,-3e-7,1e300,true,false,null],\"s\":\"x\\u00e9\\n\\\"\\u0001\\/\",\"o\":{\"e\":{},\"f\":[]},\"i\":9223372036854775807}",
+    "[[[[]]],{\"\":\"\"},[0,-0,0.1,123456789012345]]",
+    "1",
+    "\"text\"",
+    "[]",
+    "{}",
+    "null",
+};
+
+static int test_length_of_print(void) {
+    int ok = 1;
+    // 整形あり・なしの両方で strlen(cJSON_Print...) と同じ
+    for (size_t i = 0; ok && i < sizeof(documents) / sizeof(documents[0]); ++i) {
+        cJSON* root = cJSON_Parse(documents[i]);
+        char* formatted = cJSON_Print(root);
+        char* unformatted = cJSON_PrintUnformatted(root);
+        ok = root != NULL && formatted != NULL && unformatted != NULL
+            && cJSON_PrintedLength(root, 1) == strlen(formatted)
+            && cJSON_PrintedLength(root, 0) == strlen(unformatted);
+        cJSON_free(formatted);
+        cJSON_free(unformatted);
+        cJSON_Delete(root);
+    }
+    // 印刷できないものは 0
+    ok = ok && cJSON_PrintedLength(NULL, 0) == 0;
+    return ok;
+}
+
+static int test_exact_output(void) {
+    int ok = 1;
+    for (size_t i = 0; ok && i < sizeof(documents) / sizeof(documents[0]); ++i) {
+        cJSON* root = cJSON_Parse(documents[i]);
+        for (int format = 0; ok && format < 2; ++format) {
+            char* expected = format ? cJSON_Print(root) : cJSON_PrintUnformatted(root);
+            char* exact = cJSON_PrintExact(root, format);
+            ok = expected != NULL && exact != NULL && strcmp(expected, exact) == 0;
+            cJSON_free(expected);
+            cJSON_free(exact);
+        }
+        cJSON_Delete(root);
+    }
+    ok = ok && cJSON_PrintExact(NULL, 0) == NULL;
+    return ok;
+}
+
+static size_t allocations = 0;
+static size_t last_size = 0;
+
+static void* counting_malloc(size_t size) {
+    allocations++;
+    last_size = size;
+    return malloc(size);
+}
+
+static int test_one_allocation(void) {
+    cJSON* root = cJSON_Parse(documents[0]);
+    cJSON_Hooks hooks = { counting_malloc, free };
+    size_t length = cJSON_PrintedLength(root, 1);
+    char* exact = NULL;
+    int ok = root != NULL && length > 0;
+    // 長さの計算は何も確保せず、印刷は 1 回の確保で済む
+    cJSON_InitHooks(&hooks);
+    allocations = 0;
+    ok = ok && cJSON_PrintedLength(root, 1) == length && allocations == 0;
+    exact = cJSON_PrintExact(root, 1);
+    ok = ok && exact != NULL && allocations == 1 && strlen(exact) == length;
+    cJSON_free(exact);
+    cJSON_InitHooks(NULL);
+    cJSON_Delete(root);
+    return ok;
+}
+
+static int test_buffer_one_byte_short(void) {
+    int ok = 1;
+    // cJSON_PrintExact が確保するのと同じ大きさなら印刷でき、1 バイト短いと失敗する
+    // (長さが多めに見積もられていれば短いバッファでも成功してしまう)
+    for (size_t i = 0; ok && i < sizeof(documents) / sizeof(documents[0]); ++i) {
+        cJSON* root = cJSON_Parse(documents[i]);
+        for (int format = 0; ok && format < 2; ++format) {
+            cJSON_Hooks hooks = { counting_malloc, free };
+            size_t length = cJSON_PrintedLength(root, format);
+            char* exact = NULL;
+            char* buffer = NULL;
+            cJSON_InitHooks(&hooks);
+            exact = cJSON_PrintExact(root, format);
+            cJSON_InitHooks(NULL);
+            buffer = (char*)malloc(last_size);
+            ok = exact != NULL && buffer != NULL
+                && cJSON_PrintPreallocated(root, buffer, (int)last_size, format) && strcmp(buffer, exact) == 0
+                && !cJSON_PrintPreallocated(root, buffer, (int)last_size - 1, format)
+                && strlen(exact) == length;
+            free(buffer);
+            cJSON_free(exact);
+        }
+        cJSON_Delete(root);
+    }
+    return ok;
+}
+
+static const TestCase printed_length_tests[] = {
+    { "PL 1: Length equals strlen of cJSON_Print and cJSON_PrintUnformatted", test_length_of_print },
+    { "PL 2: cJSON_PrintExact prints the same text", test_exact_output },
+    { "PL 3: cJSON_PrintExact allocates once", test_one_allocation },
+    { "PL 4: A buffer one byte short fails", test_buffer_one_byte_short },
+};
+
+void run_all_printed_length_tests(int* total, int* passed) {
+    printf("--- Running cJSON_PrintedLength Tests ---\n");
+    run_test_cases(printed_length_tests, (int)(sizeof(printed_length_tests) / sizeof(printed_length_tests[0])), total, passed);
+    printf("--- Finished cJSON_PrintedLength Tests ---\n\n");
+}
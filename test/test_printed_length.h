@@ -0,0 +1,7 @@
+#ifndef TEST_PRINTED_LENGTH_H_
+#define TEST_PRINTED_LENGTH_H_
+
+// cJSON_PrintedLength / cJSON_PrintExact のテストスイート宣言
+void run_all_printed_length_tests(int* total, int* passed);
+
+#endif // TEST_PRINTED_LENGTH_H_
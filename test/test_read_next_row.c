@@ -49,6 +49,16 @@ typedef struct CsvHandle_
     char delim;
     char quote;
     char escape;
+
+    // UTF-8 検証の状態 (CsvValidateUtf8)
+    int validateUtf8;
+    unsigned utf8Need;
+    unsigned char utf8Lo;
+    unsigned char utf8Hi;
+    int utf8Error;
+    file_off_t utf8ErrorOffset;
+    size_t utf8ErrorRow;
+    size_t rows;
 } CsvHandle_;
 
 // CsvHandle は CsvHandle_ 構造体へのポインタとして定義
@@ -49,6 +49,16 @@ typedef struct CsvHandle_
     char delim;
     char quote;
     char escape;
+
+    // UTF-8 検証の状態 (CsvValidateUtf8)
+    int validateUtf8;
+    unsigned utf8Need;
+    unsigned char utf8Lo;
+    unsigned char utf8Hi;
+    int utf8Error;
+    file_off_t utf8ErrorOffset;
+    size_t utf8ErrorRow;
+    size_t rows;
 } CsvHandle_;
 
 // CsvHandle は CsvHandle_ 構造体へのポインタとして定義
@@ -204,6 +214,60 @@ CsvSearchLfTest csv_search_lf_tests[] = {
 };
 
 
+// --- CsvSearchLf UTF-8 検証モードのテスト ---
+
+typedef struct {
+    const char* input_buffer;   // テスト入力
+    size_t input_size;          // バッファサイズ
+    ptrdiff_t expected_offset;  // 期待される改行のオフセット (見つからない/エラーなら -1)
+    long long expected_error;   // 期待されるエラーのバイトオフセット (エラーなしなら -1)
+    const char* description;
+} CsvSearchLfUtf8Test;
+
+CsvSearchLfUtf8Test csv_search_lf_utf8_tests[] = {
+    { "abc\xC3\xA9\n", 6, 5, -1, "SLF 8.1: Valid 2-byte sequence before newline" },
+    { "\xE3\x81\x82\xE3\x81\x84\xE3\x81\x86\n", 10, 9, -1, "SLF 8.2: Valid 3-byte sequences across 64-bit word" },
+    { "\xF0\x9F\x98\x80,x\n", 7, 6, -1, "SLF 8.3: Valid 4-byte sequence" },
+    { "abc\xFF" "def\n", 8, -1, 3, "SLF 8.4: Invalid byte 0xFF" },
+    { "abcdefgh\xC3\n", 10, -1, 9, "SLF 8.5: Truncated sequence before newline (after 64-bit word)" },
+    { "\xC0\xAF\n", 3, -1, 0, "SLF 8.6: Overlong encoding rejected" },
+    { "ab\xED\xA0\x80\n", 6, -1, 3, "SLF 8.7: UTF-16 surrogate rejected" },
+    { "........\"\xE2\x82\xAC\n\"\n", 15, 14, -1, "SLF 8.8: Newline inside quotes after multibyte sequence" },
+};
+
+bool run_csv_search_lf_utf8_test_counted(const CsvSearchLfUtf8Test* test_case) {
+    printf("Running test: %s\n", test_case->description);
+
+    char* buffer = malloc(test_case->input_size + 1);
+    if (!buffer) {
+        printf(" [ERROR] Memory allocation failed\n");
+        printf("---\n");
+        return false;
+    }
+    memcpy(buffer, test_case->input_buffer, test_case->input_size + 1);
+
+    // mapSize == blockSize == 0 なので、エラーオフセットはバッファ先頭からの距離になる
+    struct CsvHandle_ handle_struct;
+    memset(&handle_struct, 0, sizeof(struct CsvHandle_));
+    handle_struct.quote = '"';
+    handle_struct.mem = buffer;
+    handle_struct.validateUtf8 = 1;
+
+    char* actual_result = CsvSearchLf(buffer, test_case->input_size, &handle_struct);
+    ptrdiff_t actual_offset = actual_result ? actual_result - buffer : -1;
+    long long actual_error = handle_struct.utf8Error ? (long long)handle_struct.utf8ErrorOffset : -1;
+
+    bool passed = actual_offset == test_case->expected_offset && actual_error == test_case->expected_error;
+    printf("  Result: %s (Expected offset: %td, error: %lld, Got: %td, error: %lld)\n",
+           passed ? "PASS" : "FAIL",
+           test_case->expected_offset, test_case->expected_error, actual_offset, actual_error);
+
+    free(buffer);
+    printf("---\n");
+    return passed;
+}
+
+
 // --- Test Suite Runner Functions ---
 
 // CsvSearchLf のテストスイート実行関数
@@ -215,6 +279,12 @@ void run_all_csv_search_lf_tests(int* total, int* passed) {
             (*passed)++;
         }
     }
+    for (int i = 0; i < sizeof(csv_search_lf_utf8_tests) / sizeof(csv_search_lf_utf8_tests[0]); ++i) {
+        (*total)++;
+        if (run_csv_search_lf_utf8_test_counted(&csv_search_lf_utf8_tests[i])) {
+            (*passed)++;
+        }
+    }
     printf("--- Finished CsvSearchLf Tests ---\n\n");
 }
 
@@ -0,0 +1,136 @@
+#include "test_stream.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_StreamParser のテスト ---
+// 入力は任意の大きさに分割して渡され、文字列や数値の途中で切れてもよい。
+
+static const char* document = "{\"a\":[1,2.5,-3e2,true,false,null,\"x\\u00e9\\ud83d\\ude00y\\n\"],\"b\":{},\"c\":[],\"d\":{\"e\":[[[]]]}}";
+
+// json を chunk バイトずつ渡して木を作る。失敗したらエラー位置を error_offset に返す
+static cJSON* parse_in_chunks(const char* json, size_t chunk, size_t* error_offset) {
+    cJSON_StreamParser* parser = cJSON_StreamParserNew(NULL, NULL);
+    cJSON* root = NULL;
+    size_t length = strlen(json);
+    size_t i = 0;
+    int ok = parser != NULL;
+    for (; ok && i < length; i += chunk) {
+        ok = cJSON_StreamParserFeed(parser, json + i, (length - i < chunk) ? length - i : chunk);
+    }
+    ok = ok && cJSON_StreamParserFinish(parser, &root);
+    if (!ok && error_offset != NULL) {
+        *error_offset = cJSON_StreamParserGetErrorOffset(parser);
+    }
+    cJSON_StreamParserDelete(parser);
+    return root;
+}
+
+static int test_same_as_cJSON_Parse(void) {
+    cJSON* expected = cJSON_Parse(document);
+    int ok = expected != NULL;
+    // 1 バイトずつでも、まとめてでも同じ木になる
+    for (size_t chunk = 1; ok && chunk <= strlen(document); chunk *= 3) {
+        cJSON* actual = parse_in_chunks(document, chunk, NULL);
+        ok = actual != NULL && cJSON_Compare(expected, actual, 1);
+        cJSON_Delete(actual);
+    }
+    cJSON_Delete(expected);
+    return ok;
+}
+
+static int test_scalars_and_bom(void) {
+    cJSON* number = parse_in_chunks("  -0.000001234  ", 2, NULL);
+    cJSON* string = parse_in_chunks("\xEF\xBB\xBF\"str\\\"ing\"", 1, NULL);
+    int ok = cJSON_IsNumber(number) && number->valuedouble == -0.000001234
+        && cJSON_IsString(string) && strcmp(string->valuestring, "str\"ing") == 0;
+    cJSON_Delete(number);
+    cJSON_Delete(string);
+    return ok;
+}
+
+static int test_invalid_documents(void) {
+    const char* invalid[] = { "[1,]", "{\"a\" 1}", "[1 2]", "tru", "\"abc", "[", "{\"a\":1}}", "1 2", "[}", "{,}", "\"\\u12\"", "\xEF\xBB{}", "[1]x", "", "{\"a\":}" };
+    int ok = 1;
+    for (size_t i = 0; ok && i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        for (size_t chunk = 1; ok && chunk <= 4; chunk += 3) {
+            cJSON* root = parse_in_chunks(invalid[i], chunk, NULL);
+            ok = root == NULL;
+            cJSON_Delete(root);
+        }
+    }
+    return ok;
+}
+
+// エラー位置は分割の仕方によらず、cJSON_ParseCtx の error_offset と同じ
+static int has_error_at(const char* json, size_t expected) {
+    int ok = 1;
+    for (size_t chunk = 1; ok && chunk <= strlen(json) + 1; chunk++) {
+        size_t offset = (size_t)-1;
+        cJSON* root = parse_in_chunks(json, chunk, &offset);
+        ok = root == NULL && offset == expected;
+        if (!ok) {
+            printf("    \"%s\" in chunks of %u: error at %u (expected %u)\n", json, (unsigned)chunk, (unsigned)offset, (unsigned)expected);
+        }
+        cJSON_Delete(root);
+    }
+    return ok;
+}
+
+static int test_error_offsets(void) {
+    return has_error_at(" /* c */ 1", 1) && has_error_at("[ // c\n1]", 2) && has_error_at("  x", 2)
+        && has_error_at("[1,2,]", 5) && has_error_at("[1 2]", 3) && has_error_at("[1,2", 4)
+        && has_error_at("{\"a\":tru}", 5) && has_error_at("[1]x", 3) && has_error_at("[\"\\u12\"]", 2)
+        && has_error_at("/", 0) && has_error_at("{1:2}", 1) && has_error_at("{\"a\":1,}", 7)
+        && has_error_at("{ x}", 2);
+}
+
+static int test_failed_parser_stays_failed(void) {
+    cJSON_StreamParser* parser = cJSON_StreamParserNew(NULL, NULL);
+    cJSON* root = NULL;
+    int ok = parser != NULL && cJSON_StreamParserFeed(parser, "[1,2", 4) && !cJSON_StreamParserFeed(parser, ",]", 2)
+        && cJSON_StreamParserGetErrorOffset(parser) == 5
+        && !cJSON_StreamParserFeed(parser, "3]", 2) && !cJSON_StreamParserFinish(parser, &root) && root == NULL
+        && cJSON_StreamParserGetErrorOffset(parser) == 5;
+    cJSON_StreamParserDelete(parser);
+    return ok;
+}
+
+// イベントを数えるハンドラ
+static int events;
+static cJSON_bool count_event(void* context) { (void)context; events++; return 1; }
+static cJSON_bool count_key(void* context, const char* key) { (void)context; (void)key; events++; return 1; }
+static cJSON_bool count_value(void* context, const cJSON* value) { (void)context; (void)value; events++; return 1; }
+
+static int test_events(void) {
+    cJSON_EventHandler handler = { count_event, count_event, count_event, count_event, count_key, count_value };
+    cJSON_StreamParser* parser = cJSON_StreamParserNew(&handler, NULL);
+    cJSON* root = NULL;
+    int ok = parser != NULL;
+    events = 0;
+    for (size_t i = 0; ok && document[i] != '\0'; i++) {
+        ok = cJSON_StreamParserFeed(parser, document + i, 1);
+    }
+    // 3 つのオブジェクトと 5 つの配列の開始と終了、5 つのキーと 7 つの値
+    ok = ok && cJSON_StreamParserFinish(parser, &root) && root == NULL && events == 2 * 3 + 2 * 5 + 5 + 7;
+    cJSON_StreamParserDelete(parser);
+    return ok;
+}
+
+static const TestCase stream_tests[] = {
+    { "SP 1: Same tree as cJSON_Parse for any chunk size", test_same_as_cJSON_Parse },
+    { "SP 2: Scalars and a split UTF-8 BOM", test_scalars_and_bom },
+    { "SP 3: Invalid documents are rejected", test_invalid_documents },
+    { "SP 4: Error offsets match cJSON_ParseCtx", test_error_offsets },
+    { "SP 5: A failed parser stays failed", test_failed_parser_stays_failed },
+    { "SP 6: Events instead of a tree", test_events },
+};
+
+void run_all_stream_tests(int* total, int* passed) {
+    printf("--- Running cJSON_StreamParser Tests ---\n");
+    run_test_cases(stream_tests, (int)(sizeof(stream_tests) / sizeof(stream_tests[0])), total, passed);
+    printf("--- Finished cJSON_StreamParser Tests ---\n\n");
+}
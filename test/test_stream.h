@@ -0,0 +1,7 @@
+#ifndef TEST_STREAM_H_
+#define TEST_STREAM_H_
+
+// 分割された入力の解析 (cJSON_StreamParser) のテストスイート宣言
+void run_all_stream_tests(int* total, int* passed);
+
+#endif // TEST_STREAM_H_
@@ -0,0 +1,179 @@
+#include "test_validate.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// --- cJSON_Validate のテスト ---
+// 木を作らずに、cJSON_ParseWithLength と同じ判定と同じエラー位置を返す。
+
+// 判定とエラー位置が cJSON_ParseWithLengthOpts と一致するか
+static int same_as_parse(const char* json) {
+    size_t length = strlen(json);
+    const char* end = NULL;
+    size_t offset = 12345;
+    cJSON* tree = cJSON_ParseWithLengthOpts(json, length, &end, 0);
+    cJSON_bool valid = cJSON_Validate(json, length, &offset);
+    size_t expected = (size_t)(end - json);
+    int ok = 0;
+    if (tree != NULL) {
+        // 値の後ろには空白しか置けない
+        while (expected < length && (unsigned char)json[expected] <= 32) {
+            expected++;
+        }
+        ok = (expected == length) ? (valid && offset == 0) : (!valid && offset == expected);
+    } else {
+        ok = !valid && offset == expected;
+    }
+    if (!ok) {
+        printf("    %s: expected %d, validate %s at %d\n", json, (int)expected, valid ? "ok" : "failed", (int)offset);
+    }
+    cJSON_Delete(tree);
+    return ok;
+}
+
+static int test_valid_documents(void) {
+    return same_as_parse("{\"a\":[1,2.5,-3e2,true,false,null,\"x\\u00e9\\ud83d\\ude00y\\n\"],\"b\":{},\"c\":[]}")
+        && same_as_parse("  123  ") && same_as_parse("\"str\\\"ing\"") && same_as_parse("[1, 2 , 3 ]\n")
+        && same_as_parse("\xEF\xBB\xBF{\"k\" : \"v\"}") && same_as_parse("[[[[]]]]");
+}
+
+static int test_invalid_documents(void) {
+    static const char* invalid[] = {
+        "[1,]", "{\"a\" 1}", "[1 2]", "tru", "\"abc", "[", "{\"a\":1}}", "1 2", "[}", "{,}", "\"\\u12\"",
+        "[1-2]", "[1]x", "{\"a\":}", "[truex]", "[1e]", "[-]", "{\"\\q\":1}", "   ", "{1:2}"
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        if (!same_as_parse(invalid[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int test_nesting_limit(void) {
+    char deep[2 * CJSON_NESTING_LIMIT + 3];
+    size_t offset = 0;
+    memset(deep, '[', CJSON_NESTING_LIMIT);
+    memset(deep + CJSON_NESTING_LIMIT, ']', CJSON_NESTING_LIMIT);
+    deep[2 * CJSON_NESTING_LIMIT] = '\0';
+    if (!cJSON_Validate(deep, 2 * CJSON_NESTING_LIMIT, NULL)) {
+        return 0;
+    }
+    // 上限より一段深い
+    memmove(deep + 1, deep, 2 * CJSON_NESTING_LIMIT);
+    deep[0] = '[';
+    deep[2 * CJSON_NESTING_LIMIT + 1] = ']';
+    deep[2 * CJSON_NESTING_LIMIT + 2] = '\0';
+    return !cJSON_Validate(deep, 2 * CJSON_NESTING_LIMIT + 2, &offset) && offset == CJSON_NESTING_LIMIT;
+}
+
+// 1 文字の文字列 "..." として検査する
+static int validates_string(const unsigned char* bytes, size_t length, size_t* offset) {
+    char json[16];
+    json[0] = '"';
+    memcpy(json + 1, bytes, length);
+    json[length + 1] = '"';
+    return cJSON_Validate(json, length + 2, offset);
+}
+
+// 独立した参照実装: 符号位置を順に復号して、最短の符号化かどうかと範囲を確かめる
+static int reference_utf8(const unsigned char* bytes, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+        unsigned long codepoint = 0;
+        size_t needed = 0;
+        if (bytes[i] < 0x80) {
+            if (bytes[i] < 0x20 || bytes[i] == '"' || bytes[i] == '\\') {
+                return 0;
+            }
+            i++;
+            continue;
+        } else if ((bytes[i] & 0xE0) == 0xC0) {
+            needed = 2;
+            codepoint = bytes[i] & 0x1F;
+        } else if ((bytes[i] & 0xF0) == 0xE0) {
+            needed = 3;
+            codepoint = bytes[i] & 0x0F;
+        } else if ((bytes[i] & 0xF8) == 0xF0) {
+            needed = 4;
+            codepoint = bytes[i] & 0x07;
+        } else {
+            return 0;
+        }
+        if (length - i < needed) {
+            return 0;
+        }
+        for (size_t j = 1; j < needed; j++) {
+            if ((bytes[i + j] & 0xC0) != 0x80) {
+                return 0;
+            }
+            codepoint = (codepoint << 6) | (bytes[i + j] & 0x3F);
+        }
+        if ((needed == 2 && codepoint < 0x80) || (needed == 3 && codepoint < 0x800) || (needed == 4 && codepoint < 0x10000)) {
+            return 0; // 冗長な符号化
+        }
+        if ((codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF) {
+            return 0;
+        }
+        i += needed;
+    }
+    return 1;
+}
+
+static int test_utf8_sequences(void) {
+    unsigned char bytes[4];
+    // 2 バイトと 3 バイトの並びはすべて、4 バイトは先頭と 2 バイト目の組み合わせを試す
+    for (unsigned int a = 0x80; a <= 0xFF; a++) {
+        for (unsigned int b = 0; b <= 0xFF; b++) {
+            bytes[0] = (unsigned char)a;
+            bytes[1] = (unsigned char)b;
+            if ((b >= 0x20) && (b != '"') && (b != '\\') && (validates_string(bytes, 2, NULL) != reference_utf8(bytes, 2))) {
+                printf("    %02X %02X\n", a, b);
+                return 0;
+            }
+            for (unsigned int c = 0x7F; c <= 0xC0; c++) {
+                bytes[2] = (unsigned char)c;
+                if (validates_string(bytes, 3, NULL) != reference_utf8(bytes, 3)) {
+                    printf("    %02X %02X %02X\n", a, b, c);
+                    return 0;
+                }
+                bytes[3] = 0xBF;
+                if (validates_string(bytes, 4, NULL) != reference_utf8(bytes, 4)) {
+                    printf("    %02X %02X %02X BF\n", a, b, c);
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+static int test_utf8_error_offsets(void) {
+    size_t offset = 0;
+    // 長い ASCII の後の不正なバイトも見つける
+    const char* late = "{\"key\":\"abcdefghijklmnopqrstuvwxyz\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 \xC0\xAF\"}";
+    const char* in_key = "{\"k\xFF\":1}";
+    const char* truncated = "[\"ab\xE2\x82\"]";
+    return cJSON_Validate("[\"\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\"]", 13, NULL)
+        && !cJSON_Validate(late, strlen(late), &offset) && offset == 44
+        && !cJSON_Validate(in_key, strlen(in_key), &offset) && offset == 3
+        && !cJSON_Validate(truncated, strlen(truncated), &offset) && offset == 4
+        // 文字列の外の非 ASCII は構文エラー
+        && !cJSON_Validate("[\xC3\xA9]", 4, &offset) && offset == 1;
+}
+
+static const TestCase validate_tests[] = {
+    { "VA 1: Valid documents", test_valid_documents },
+    { "VA 2: Invalid documents fail where parsing fails", test_invalid_documents },
+    { "VA 3: Nesting limit", test_nesting_limit },
+    { "VA 4: UTF-8 sequences match a reference decoder", test_utf8_sequences },
+    { "VA 5: Offsets of invalid UTF-8", test_utf8_error_offsets },
+};
+
+void run_all_validate_tests(int* total, int* passed) {
+    printf("--- Running cJSON_Validate Tests ---\n");
+    run_test_cases(validate_tests, (int)(sizeof(validate_tests) / sizeof(validate_tests[0])), total, passed);
+    printf("--- Finished cJSON_Validate Tests ---\n\n");
+}
@@ -0,0 +1,7 @@
+#ifndef TEST_VALIDATE_H_
+#define TEST_VALIDATE_H_
+
+// cJSON_Validate のテストスイート宣言
+void run_all_validate_tests(int* total, int* passed);
+
+#endif // TEST_VALIDATE_H_
@@ -0,0 +1,188 @@
+#include "test_writer.h"
+#include "test_helper.h"
+#include "../cJSON/cJSON.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- cJSON_PrintToWriter / cJSON_PrintToFile / cJSON_PrintToFd のテスト ---
+// 固定長のバッファがいっぱいになるたびに writer に渡される。出力は cJSON_Print と同じでなければならない。
+
+// writer が受け取った出力を集める
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    int calls;
+    int fail_at; // この回数目の呼び出しで失敗する、0 なら失敗しない
+} collected_output;
+
+static cJSON_bool collect(void* context, const char* data, size_t length) {
+    collected_output* output = (collected_output*)context;
+    output->calls++;
+    if (output->calls == output->fail_at) {
+        return 0;
+    }
+    if (output->length + length + 1 > output->capacity) {
+        size_t capacity = (output->length + length + 1) * 2;
+        char* grown = (char*)realloc(output->data, capacity);
+        if (grown == NULL) {
+            return 0;
+        }
+        output->data = grown;
+        output->capacity = capacity;
+    }
+    memcpy(output->data + output->length, data, length);
+    output->length += length;
+    output->data[output->length] = '\0';
+    return 1;
+}
+
+// writer の出力が cJSON_Print / cJSON_PrintUnformatted と同じか
+static int writes_as_print(const cJSON* item, int* calls) {
+    int ok = 1;
+    for (int format = 0; ok && format < 2; ++format) {
+        char* expected = format ? cJSON_Print(item) : cJSON_PrintUnformatted(item);
+        collected_output output;
+        memset(&output, 0, sizeof(output));
+        ok = expected != NULL && cJSON_PrintToWriter(item, format, collect, &output)
+            && output.length == strlen(expected) && memcmp(output.data, expected, output.length) == 0;
+        if (calls != NULL && format == 0) {
+            *calls = output.calls;
+        }
+        free(output.data);
+        cJSON_free(expected);
+    }
+    return ok;
+}
+
+static int test_same_as_print(void) {
+    const char* json = "{\"a\":[1,2.5,-3e-7,true,false,null],\"s\":\"x\\u00e9\\n\\\"\",\"o\":{\"e\":{},\"f\":[]},\"i\":9223372036854775807}";
+    cJSON* root = cJSON_Parse(json);
+    cJSON* scalar = cJSON_CreateString("only");
+    int calls = 0;
+    int ok = root != NULL && writes_as_print(root, &calls) && calls == 1 && writes_as_print(scalar, NULL);
+    cJSON_Delete(root);
+    cJSON_Delete(scalar);
+    return ok;
+}
+
+// 長さ padding の文字列の後に要素を並べ、バッファの境界がいろいろな位置に来るようにする
+static cJSON* padded_array(size_t padding, int strings) {
+    cJSON* array = cJSON_CreateArray();
+    char* pad = (char*)malloc(padding + 1);
+    char text[64];
+    if (array == NULL || pad == NULL) {
+        free(pad);
+        return array;
+    }
+    memset(pad, 'p', padding);
+    pad[padding] = '\0';
+    cJSON_AddItemToArray(array, cJSON_CreateString(pad));
+    for (int i = 0; i < 12000; ++i) {
+        if (strings) {
+            sprintf(text, "str\\ing\"%d\n\tescaped", i);
+            cJSON_AddItemToArray(array, cJSON_CreateString(text));
+        } else {
+            cJSON_AddItemToArray(array, cJSON_CreateNumber(i * 1234.5678 + 0.001));
+        }
+    }
+    free(pad);
+    return array;
+}
+
+static int test_chunk_boundaries(void) {
+    int ok = 1;
+    // 数値の中と文字列 (エスケープを含む) の中でバッファが区切られても同じ出力になる
+    for (size_t padding = 0; ok && padding < 24; padding += 5) {
+        cJSON* numbers = padded_array(padding, 0);
+        cJSON* strings = padded_array(padding, 1);
+        int calls = 0;
+        ok = writes_as_print(numbers, &calls) && calls > 1 && writes_as_print(strings, &calls) && calls > 1;
+        cJSON_Delete(numbers);
+        cJSON_Delete(strings);
+    }
+    // バッファより長い 1 つの文字列
+    {
+        cJSON* array = padded_array(300000, 0);
+        ok = ok && writes_as_print(array, NULL);
+        cJSON_Delete(array);
+    }
+    return ok;
+}
+
+static int test_writer_fails(void) {
+    cJSON* array = padded_array(0, 1);
+    collected_output output;
+    int ok = array != NULL;
+    // 途中で失敗すると false が返り、それ以降 writer は呼ばれない
+    for (int fail_at = 1; ok && fail_at <= 3; ++fail_at) {
+        memset(&output, 0, sizeof(output));
+        output.fail_at = fail_at;
+        ok = !cJSON_PrintToWriter(array, 1, collect, &output) && output.calls == fail_at;
+        free(output.data);
+    }
+    ok = ok && !cJSON_PrintToWriter(NULL, 0, collect, &output) && !cJSON_PrintToWriter(array, 0, NULL, &output);
+    cJSON_Delete(array);
+    return ok;
+}
+
+// ファイルの内容をすべて読む
+static char* read_back(FILE* file, size_t* length) {
+    long size = 0;
+    char* data = NULL;
+    if (fflush(file) != 0 || fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0) {
+        return NULL;
+    }
+    data = (char*)malloc((size_t)size + 1);
+    if (data == NULL) {
+        return NULL;
+    }
+    *length = fread(data, 1, (size_t)size, file);
+    data[*length] = '\0';
+    return data;
+}
+
+static int test_file_and_fd(void) {
+    cJSON* array = padded_array(7, 1);
+    char* expected = cJSON_Print(array);
+    FILE* file = tmpfile();
+    FILE* fd_file = tmpfile();
+    char* written = NULL;
+    size_t length = 0;
+    int ok = expected != NULL && file != NULL && fd_file != NULL
+        && cJSON_PrintToFile(array, 1, file)
+        && (written = read_back(file, &length)) != NULL
+        && length == strlen(expected) && strcmp(written, expected) == 0;
+    free(written);
+    written = NULL;
+    ok = ok && cJSON_PrintToFd(array, 1, fileno(fd_file))
+        && (written = read_back(fd_file, &length)) != NULL
+        && length == strlen(expected) && strcmp(written, expected) == 0;
+    free(written);
+    // 不正な引数は失敗する
+    ok = ok && !cJSON_PrintToFile(array, 1, NULL) && !cJSON_PrintToFd(array, 1, -1);
+    if (file != NULL) {
+        fclose(file);
+    }
+    if (fd_file != NULL) {
+        fclose(fd_file);
+    }
+    cJSON_free(expected);
+    cJSON_Delete(array);
+    return ok;
+}
+
+static const TestCase writer_tests[] = {
+    { "WR 1: Output equals cJSON_Print and cJSON_PrintUnformatted", test_same_as_print },
+    { "WR 2: Buffer boundaries inside numbers and strings", test_chunk_boundaries },
+    { "WR 3: Writer failing part-way", test_writer_fails },
+    { "WR 4: cJSON_PrintToFile and cJSON_PrintToFd", test_file_and_fd },
+};
+
+void run_all_writer_tests(int* total, int* passed) {
+    printf("--- Running cJSON_PrintToWriter Tests ---\n");
+    run_test_cases(writer_tests, (int)(sizeof(writer_tests) / sizeof(writer_tests[0])), total, passed);
+    printf("--- Finished cJSON_PrintToWriter Tests ---\n\n");
+}
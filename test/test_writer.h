@@ -0,0 +1,7 @@
+#ifndef TEST_WRITER_H_
+#define TEST_WRITER_H_
+
+// cJSON_PrintToWriter / cJSON_PrintToFile / cJSON_PrintToFd のテストスイート宣言
+void run_all_writer_tests(int* total, int* passed);
+
+#endif // TEST_WRITER_H_